@@ -3,4 +3,9 @@ TEMPLATE = subdirs
 SUBDIRS += \
     SpineItemTest \
     spine-cpp \
+    spine-cpp-benchmark \
+    spine-cpp-test \
     spineplugin
+
+spine-cpp-benchmark.depends = spine-cpp
+spine-cpp-test.depends = spine-cpp
@@ -0,0 +1,129 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+volatile float g_floatSink = 0;
+const void* volatile g_pointerSink = nullptr;
+}
+
+Benchmark &Benchmark::instance()
+{
+    static Benchmark _instance;
+    return _instance;
+}
+
+void Benchmark::add(const std::string &name, const std::string &unit, const std::string &sizeLabel,
+                    const std::vector<int> &sizes, const Benchmark::Setup &setup)
+{
+    Case benchCase;
+    benchCase.name = name;
+    benchCase.unit = unit;
+    benchCase.sizeLabel = sizeLabel;
+    benchCase.sizes = sizes;
+    benchCase.setup = setup;
+    m_cases.push_back(benchCase);
+}
+
+void Benchmark::sink(float value)
+{
+    g_floatSink = g_floatSink + value;
+}
+
+void Benchmark::sink(const void *value)
+{
+    g_pointerSink = value;
+}
+
+int Benchmark::run(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--list") == 0) {
+            list();
+            return 0;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            m_csv = true;
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            m_minSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            printf("usage: %s [--list] [--csv] [--min-time seconds] [filter]\n", argv[0]);
+            return 0;
+        } else {
+            m_filter = argv[i];
+        }
+    }
+
+    if (m_csv)
+        printf("benchmark,size_label,size,ns_per_item,unit,items_per_second\n");
+
+    for (const auto& benchCase: m_cases) {
+        if (!m_filter.empty() && benchCase.name.find(m_filter) == std::string::npos)
+            continue;
+        runCase(benchCase);
+    }
+    return 0;
+}
+
+void Benchmark::list() const
+{
+    for (const auto& benchCase: m_cases) {
+        printf("%s (%s:", benchCase.name.c_str(), benchCase.sizeLabel.c_str());
+        for (int size: benchCase.sizes)
+            printf(" %d", size);
+        printf(")\n");
+    }
+}
+
+void Benchmark::runCase(const Benchmark::Case &benchCase) const
+{
+    typedef std::chrono::steady_clock Clock;
+
+    if (!m_csv)
+        printf("\n%s\n", benchCase.name.c_str());
+
+    double lastNsPerItem = 0;
+    int lastSize = 0;
+    for (int size: benchCase.sizes) {
+        Body body = benchCase.setup(size);
+        if (!body) {
+            printf("  %s=%d: setup failed\n", benchCase.sizeLabel.c_str(), size);
+            continue;
+        }
+
+        body(); // warm up caches and lazily built state.
+
+        size_t iterations = 1;
+        size_t items = 0;
+        double seconds = 0;
+        while (true) {
+            items = 0;
+            auto start = Clock::now();
+            for (size_t i = 0; i < iterations; i++)
+                items += body();
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (seconds >= m_minSeconds || iterations >= (size_t(1) << 40))
+                break;
+            iterations *= seconds > 0 && seconds * 8 < m_minSeconds ? 8 : 2;
+        }
+
+        if (items == 0)
+            items = iterations;
+        double nsPerItem = seconds * 1e9 / items;
+        if (m_csv) {
+            printf("%s,%s,%d,%.3f,%s,%.0f\n", benchCase.name.c_str(), benchCase.sizeLabel.c_str(),
+                   size, nsPerItem, benchCase.unit.c_str(), items / seconds);
+        } else {
+            printf("  %s=%-7d %12.3f ns/%s", benchCase.sizeLabel.c_str(), size, nsPerItem, benchCase.unit.c_str());
+            // per-item cost growth relative to the previous size: ~1.0 means linear total cost.
+            if (lastSize > 0 && lastNsPerItem > 0)
+                printf("   x%.2f per item for x%.1f %s", nsPerItem / lastNsPerItem,
+                       double(size) / lastSize, benchCase.sizeLabel.c_str());
+            printf("\n");
+        }
+        fflush(stdout);
+        lastNsPerItem = nsPerItem;
+        lastSize = size;
+    }
+}
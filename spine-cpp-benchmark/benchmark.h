@@ -0,0 +1,57 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal fixed-time benchmark runner.
+ *
+ * Every benchmark is registered with a list of problem sizes. For each size the
+ * setup functor builds the synthetic data once, then the returned body functor
+ * is invoked in doubling batches until the minimum measuring time is reached.
+ * The body returns how many "items" (keys, bones, vertices, bytes...) it
+ * processed, so results are reported per item and the growth between two sizes
+ * exposes the asymptotic behaviour of the kernel.
+ */
+class Benchmark
+{
+public:
+    typedef std::function<size_t()> Body;
+    typedef std::function<Body(int size)> Setup;
+
+    struct Case {
+        std::string name;
+        std::string unit;
+        std::string sizeLabel;
+        std::vector<int> sizes;
+        Setup setup;
+    };
+
+    static Benchmark& instance();
+
+    void add(const std::string& name, const std::string& unit, const std::string& sizeLabel,
+             const std::vector<int>& sizes, const Setup& setup);
+
+    int run(int argc, char** argv);
+
+    /**
+     * @brief sink Keeps results observable so the optimizer can not drop the measured work.
+     */
+    static void sink(float value);
+    static void sink(const void* value);
+
+private:
+    void list() const;
+    void runCase(const Case& benchCase) const;
+
+private:
+    std::vector<Case> m_cases;
+    std::string m_filter;
+    double m_minSeconds = 0.2;
+    bool m_csv = false;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,520 @@
+#include <memory>
+#include <vector>
+
+#include <spine/spine.h>
+
+#include "benchmark.h"
+#include "syntheticdata.h"
+
+using namespace spine;
+
+namespace spine {
+SpineExtension* getDefaultExtension() {
+    return new DefaultSpineExtension();
+}
+}
+
+namespace {
+
+typedef std::shared_ptr<SyntheticSkeleton> SkeletonPtr;
+
+const std::vector<int> kKeyframeSizes = {4, 32, 256, 2048, 16384};
+const std::vector<int> kBoneSizes = {16, 64, 256, 1024, 4096};
+const std::vector<int> kVertexSizes = {16, 128, 1024, 8192, 32768};
+const std::vector<int> kPolygonSizes = {8, 32, 128, 512, 2048};
+
+/**
+ * @brief Deterministic xorshift so every run benchmarks the same access pattern.
+ */
+class Random
+{
+public:
+    explicit Random(unsigned int seed = 0x9e3779b9u): m_state(seed) {}
+
+    unsigned int next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    float nextFloat() {
+        return (next() & 0xffffff) / float(0x1000000);
+    }
+
+private:
+    unsigned int m_state;
+};
+
+SkeletonPtr makeSkeleton(const SyntheticConfig& config)
+{
+    SkeletonPtr skeleton(new SyntheticSkeleton(config));
+    if (!skeleton->isValid()) {
+        printf("  synthetic skeleton error: %s\n", skeleton->error().c_str());
+        return SkeletonPtr();
+    }
+    return skeleton;
+}
+
+void registerCurveTimeline()
+{
+    Benchmark::instance().add("CurveTimeline::getCurvePercent", "call", "keyframes", kKeyframeSizes, [](int keyframes) -> Benchmark::Body {
+        std::shared_ptr<RotateTimeline> timeline(new RotateTimeline(keyframes));
+        for (int i = 0; i < keyframes - 1; i++) {
+            if (i % 8 == 7)
+                timeline->setLinear(i);
+            else if (i % 16 == 15)
+                timeline->setStepped(i);
+            else
+                timeline->setCurve(i, 0.25f, 0.1f, 0.75f, 0.9f);
+        }
+        std::vector<size_t> frames(4096);
+        std::vector<float> percents(frames.size());
+        Random random;
+        for (size_t i = 0; i < frames.size(); i++) {
+            frames[i] = keyframes > 1 ? random.next() % (keyframes - 1) : 0;
+            percents[i] = random.nextFloat();
+        }
+        return [timeline, frames, percents]() -> size_t {
+            float sum = 0;
+            for (size_t i = 0, n = frames.size(); i < n; i++)
+                sum += timeline->getCurvePercent(frames[i], percents[i]);
+            Benchmark::sink(sum);
+            return frames.size();
+        };
+    });
+}
+
+void registerBinarySearch()
+{
+    // Animation::binarySearch is private, it is measured through a single rotate timeline with
+    // linear keys, so the frame lookup is the only part of the apply that depends on the key count.
+    auto setup = [](int keyframes, bool monotonic, bool hinted) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = 1;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        std::shared_ptr<RotateTimeline> timeline(new RotateTimeline(keyframes));
+        for (int i = 0; i < keyframes; i++)
+            timeline->setFrame(i, i / 30.0f, float(i % 360));
+        float duration = (keyframes - 1) / 30.0f;
+        std::vector<float> times(4096);
+        Random random;
+        for (size_t i = 0; i < times.size(); i++)
+            times[i] = monotonic ? duration * i / times.size() : duration * random.nextFloat();
+        return [synthetic, timeline, times, hinted]() -> size_t {
+            Skeleton& skeleton = *synthetic->skeleton();
+            int cursor = 0;
+            for (size_t i = 0, n = times.size(); i < n; i++)
+                timeline->apply(skeleton, i ? times[i - 1] : 0, times[i], nullptr, 1, MixBlend_Replace, MixDirection_In,
+                                hinted ? &cursor : nullptr);
+            Benchmark::sink(skeleton.getBones()[0]->getRotation());
+            return times.size();
+        };
+    };
+    Benchmark::instance().add("Animation::binarySearch (random seek)", "apply", "keyframes", kKeyframeSizes,
+                              [setup](int keyframes) { return setup(keyframes, false, false); });
+    Benchmark::instance().add("Animation::binarySearch (monotonic playback)", "apply", "keyframes", kKeyframeSizes,
+                              [setup](int keyframes) { return setup(keyframes, true, false); });
+    Benchmark::instance().add("Animation::search (random seek, cursor)", "apply", "keyframes", kKeyframeSizes,
+                              [setup](int keyframes) { return setup(keyframes, false, true); });
+    Benchmark::instance().add("Animation::search (monotonic playback, cursor)", "apply", "keyframes", kKeyframeSizes,
+                              [setup](int keyframes) { return setup(keyframes, true, true); });
+}
+
+void registerTimelineApply()
+{
+    static const char* animations[] = {
+        "rotate", "translate", "scale", "shear", "color", "twoColor", "attachment", "deform",
+        "drawOrder", "events", "ik", "transform", "pathPosition", "pathSpacing", "pathMix"
+    };
+    for (const char* animationName: animations) {
+        std::string name = std::string("Timeline::apply/") + animationName;
+        std::string animation(animationName);
+        Benchmark::instance().add(name, "timeline apply", "keyframes", {4, 32, 256, 2048}, [animation](int keyframes) -> Benchmark::Body {
+            SyntheticConfig config;
+            config.bones = 16;
+            config.slots = 8;
+            config.keyframes = keyframes;
+            config.meshVertices = 32;
+            config.attachmentsPerSlot = 4;
+            SkeletonPtr synthetic = makeSkeleton(config);
+            if (!synthetic)
+                return Benchmark::Body();
+            Animation* anim = synthetic->skeletonData()->findAnimation(animation.c_str());
+            if (!anim || anim->getTimelines().size() == 0)
+                return Benchmark::Body();
+            std::shared_ptr<Vector<Event*> > events(new Vector<Event*>());
+            return [synthetic, anim, events]() -> size_t {
+                const int steps = 64;
+                Skeleton& skeleton = *synthetic->skeleton();
+                Vector<Timeline*>& timelines = anim->getTimelines();
+                float duration = anim->getDuration(), lastTime = 0;
+                for (int step = 0; step < steps; step++) {
+                    float time = duration * step / steps;
+                    events->clear();
+                    for (size_t i = 0, n = timelines.size(); i < n; i++)
+                        timelines[i]->apply(skeleton, lastTime, time, events.get(), 1, MixBlend_Replace, MixDirection_In);
+                    lastTime = time;
+                }
+                Benchmark::sink(skeleton.getBones()[skeleton.getBones().size() - 1]);
+                return steps * timelines.size();
+            };
+        });
+    }
+}
+
+void registerBoneUpdate()
+{
+    Benchmark::instance().add("Bone::updateWorldTransform", "bone", "bones", kBoneSizes, [](int bones) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        return [synthetic]() -> size_t {
+            // bones are generated parents first, so plain index order is a valid update order.
+            Vector<Bone*>& bones = synthetic->skeleton()->getBones();
+            for (size_t i = 0, n = bones.size(); i < n; i++)
+                bones[i]->updateWorldTransform();
+            Benchmark::sink(bones[bones.size() - 1]->getWorldX());
+            return bones.size();
+        };
+    });
+
+    // the same bones through the update cache, without constraints they form a single BoneBatch run.
+    auto batched = [](int bones, Trigonometry trigonometry) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        return [synthetic, trigonometry]() -> size_t {
+            MathUtil::setTrigonometry(trigonometry);
+            synthetic->skeleton()->updateWorldTransform();
+            MathUtil::setTrigonometry(Trigonometry_Precise);
+            Vector<Bone*>& bones = synthetic->skeleton()->getBones();
+            Benchmark::sink(bones[bones.size() - 1]->getWorldX());
+            return bones.size();
+        };
+    };
+    Benchmark::instance().add("Skeleton::updateWorldTransform", "bone", "bones", kBoneSizes,
+                              [batched](int n) { return batched(n, Trigonometry_Precise); });
+    Benchmark::instance().add("Skeleton::updateWorldTransform (table trigonometry)", "bone", "bones", kBoneSizes,
+                              [batched](int n) { return batched(n, Trigonometry_Table); });
+    Benchmark::instance().add("Skeleton::updateWorldTransform (polynomial trigonometry)", "bone", "bones", kBoneSizes,
+                              [batched](int n) { return batched(n, Trigonometry_Polynomial); });
+
+    Benchmark::instance().add("Skeleton::updateWorldTransform (with constraints)", "bone", "bones", kBoneSizes, [](int bones) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 2;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        return [synthetic]() -> size_t {
+            synthetic->skeleton()->updateWorldTransform();
+            Vector<Bone*>& bones = synthetic->skeleton()->getBones();
+            Benchmark::sink(bones[bones.size() - 1]->getWorldX());
+            return bones.size();
+        };
+    });
+}
+
+void registerPathConstraint()
+{
+    // a rope of bones spread evenly over the path, which stays put so its arc length tables are reused.
+    auto setup = [](int bones, float tolerance) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.pathBones = bones - 7;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        Skeleton* skeleton = synthetic->skeleton();
+        skeleton->updateWorldTransform();
+        PathConstraint* constraint = skeleton->getPathConstraints()[0];
+        constraint->getData().setSpacingMode(SpacingMode_Percent);
+        constraint->setSpacing(1.0f / constraint->getBones().size());
+        constraint->setArcLengthTolerance(tolerance);
+        return [synthetic, constraint]() -> size_t {
+            constraint->update();
+            Vector<Bone*>& bones = constraint->getBones();
+            Benchmark::sink(bones[bones.size() - 1]->getWorldX());
+            return bones.size();
+        };
+    };
+    Benchmark::instance().add("PathConstraint::update", "bone", "bones", kBoneSizes,
+                              [setup](int n) { return setup(n, 0); });
+    Benchmark::instance().add("PathConstraint::update (arc length tolerance 0.01)", "bone", "bones", kBoneSizes,
+                              [setup](int n) { return setup(n, 0.01f); });
+}
+
+void registerPoseCache()
+{
+    // a looping single track animation, posed live or interpolated from the baked table.
+    auto setup = [](int bones, bool cached) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 8;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        struct Playback {
+            explicit Playback(SkeletonData* data): stateData(data), state(&stateData) {}
+            AnimationStateData stateData;
+            AnimationState state;
+            PoseCache cache;
+        };
+        std::shared_ptr<Playback> playback(new Playback(synthetic->skeletonData()));
+        playback->state.setAnimation(0, "rotate", true);
+        return [synthetic, playback, cached]() -> size_t {
+            Skeleton* skeleton = synthetic->skeleton();
+            playback->state.update(1 / 60.0f);
+            if (!cached || !playback->cache.apply(playback->state, *skeleton)) {
+                playback->state.apply(*skeleton);
+                skeleton->updateWorldTransform();
+            }
+            Vector<Bone*>& bones = skeleton->getBones();
+            Benchmark::sink(bones[bones.size() - 1]->getWorldX());
+            return bones.size();
+        };
+    };
+    Benchmark::instance().add("AnimationState::apply + Skeleton::updateWorldTransform", "bone", "bones", kBoneSizes,
+                              [setup](int n) { return setup(n, false); });
+    Benchmark::instance().add("PoseCache::apply", "bone", "bones", kBoneSizes,
+                              [setup](int n) { return setup(n, true); });
+}
+
+void registerAnimationSwitch()
+{
+    // Every call switches the animation with a mix, so the apply rebuilds the timeline modes of the whole mix chain.
+    Benchmark::instance().add("AnimationState::setAnimation (mixing) + apply", "timeline", "bones", kBoneSizes, [](int bones) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = bones;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        struct Playback {
+            explicit Playback(SkeletonData* data): stateData(data), state(&stateData) {}
+            AnimationStateData stateData;
+            AnimationState state;
+            bool flip = false;
+        };
+        std::shared_ptr<Playback> playback(new Playback(synthetic->skeletonData()));
+        playback->stateData.setDefaultMix(0.2f);
+        return [synthetic, playback]() -> size_t {
+            Skeleton* skeleton = synthetic->skeleton();
+            playback->flip = !playback->flip;
+            TrackEntry* entry = playback->state.setAnimation(0, playback->flip ? "rotate" : "translate", true);
+            playback->state.update(1 / 60.0f);
+            playback->state.apply(*skeleton);
+            Benchmark::sink(skeleton->getBones()[0]->getRotation());
+            return entry->getAnimation()->getTimelines().size();
+        };
+    });
+}
+
+void registerComputeWorldVertices()
+{
+    auto setup = [](int vertices, bool weighted, bool deform) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = 8;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.meshVertices = vertices;
+        config.influences = weighted ? 3 : 0;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        Slot* slot = synthetic->skeleton()->getSlots()[0];
+        MeshAttachment* mesh = static_cast<MeshAttachment*>(slot->getAttachment());
+        if (deform) {
+            // weighted deform holds an offset per influence, unweighted deform holds the final local positions.
+            Vector<float>& deformArray = slot->getDeform();
+            size_t length = weighted ? mesh->getVertices().size() / 3 * 2 : mesh->getWorldVerticesLength();
+            deformArray.setSize(length, 0);
+            for (size_t i = 0; i < length; i++)
+                deformArray[i] = weighted ? (i % 3) * 0.5f : mesh->getVertices()[i] * 1.05f;
+        }
+        std::shared_ptr<std::vector<float> > output(new std::vector<float>(mesh->getWorldVerticesLength()));
+        return [synthetic, slot, mesh, output]() -> size_t {
+            mesh->computeWorldVertices(*slot, 0, mesh->getWorldVerticesLength(), output->data(), 0, 2);
+            Benchmark::sink((*output)[output->size() - 1]);
+            return mesh->getWorldVerticesLength() / 2;
+        };
+    };
+    Benchmark::instance().add("VertexAttachment::computeWorldVertices (unweighted)", "vertex", "vertices", kVertexSizes,
+                              [setup](int n) { return setup(n, false, false); });
+    Benchmark::instance().add("VertexAttachment::computeWorldVertices (unweighted, deform)", "vertex", "vertices", kVertexSizes,
+                              [setup](int n) { return setup(n, false, true); });
+    Benchmark::instance().add("VertexAttachment::computeWorldVertices (weighted x3)", "vertex", "vertices", kVertexSizes,
+                              [setup](int n) { return setup(n, true, false); });
+    Benchmark::instance().add("VertexAttachment::computeWorldVertices (weighted x3, deform)", "vertex", "vertices", kVertexSizes,
+                              [setup](int n) { return setup(n, true, true); });
+}
+
+void registerClipping()
+{
+    Benchmark::instance().add("SkeletonClipping::clipTriangles", "triangle", "vertices", {16, 128, 1024, 8192}, [](int vertices) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = 1;
+        config.slots = 1;
+        config.keyframes = 2;
+        config.meshVertices = vertices;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        Slot* slot = synthetic->skeleton()->getSlots()[0];
+        MeshAttachment* mesh = static_cast<MeshAttachment*>(slot->getAttachment());
+
+        // concave 8 point clip polygon crossing the mesh, triangulated once by clipStart.
+        std::shared_ptr<ClippingAttachment> clip(new ClippingAttachment("clip"));
+        syntheticPolygon(8, 26, clip->getVertices());
+        clip->setWorldVerticesLength(clip->getVertices().size());
+        std::shared_ptr<SkeletonClipping> clipper(new SkeletonClipping());
+        clipper->clipStart(*slot, clip.get());
+
+        std::shared_ptr<Vector<float> > worldVertices(new Vector<float>());
+        worldVertices->setSize(mesh->getWorldVerticesLength(), 0);
+        mesh->computeWorldVertices(*slot, 0, mesh->getWorldVerticesLength(), worldVertices->buffer(), 0, 2);
+        return [synthetic, mesh, clip, clipper, worldVertices]() -> size_t {
+            Vector<unsigned short>& triangles = mesh->getTriangles();
+            clipper->clipTriangles(worldVertices->buffer(), triangles.buffer(), triangles.size(), mesh->getUVs().buffer(), 2);
+            Benchmark::sink(clipper->getClippedVertices().buffer());
+            return triangles.size() / 3;
+        };
+    });
+}
+
+void registerTriangulator()
+{
+    Benchmark::instance().add("Triangulator::triangulate", "vertex", "vertices", kPolygonSizes, [](int vertices) -> Benchmark::Body {
+        std::shared_ptr<Triangulator> triangulator(new Triangulator());
+        std::shared_ptr<Vector<float> > polygon(new Vector<float>());
+        syntheticPolygon(vertices, 100, *polygon);
+        return [triangulator, polygon]() -> size_t {
+            Vector<int>& triangles = triangulator->triangulate(*polygon);
+            Benchmark::sink(triangles.buffer());
+            return polygon->size() / 2;
+        };
+    });
+
+    Benchmark::instance().add("Triangulator::decompose", "vertex", "vertices", kPolygonSizes, [](int vertices) -> Benchmark::Body {
+        std::shared_ptr<Triangulator> triangulator(new Triangulator());
+        std::shared_ptr<Vector<float> > polygon(new Vector<float>());
+        syntheticPolygon(vertices, 100, *polygon);
+        std::shared_ptr<Vector<int> > triangles(new Vector<int>());
+        triangles->clearAndAddAll(triangulator->triangulate(*polygon));
+        return [triangulator, polygon, triangles]() -> size_t {
+            Vector<Vector<float>*>& polygons = triangulator->decompose(*polygon, *triangles);
+            Benchmark::sink(polygons.buffer());
+            return polygon->size() / 2;
+        };
+    });
+}
+
+void registerJson()
+{
+    auto makeConfig = [](int keyframes) {
+        SyntheticConfig config;
+        config.bones = 32;
+        config.slots = 16;
+        config.keyframes = keyframes;
+        config.meshVertices = 32;
+        return config;
+    };
+
+    Benchmark::instance().add("Json parse", "byte", "keyframes", {4, 32, 256}, [makeConfig](int keyframes) -> Benchmark::Body {
+        std::shared_ptr<std::string> text(new std::string(syntheticSkeletonJson(makeConfig(keyframes))));
+        return [text]() -> size_t {
+            Json* root = new Json(text->c_str());
+            Benchmark::sink(root);
+            delete root;
+            return text->size();
+        };
+    });
+
+    Benchmark::instance().add("SkeletonJson::readSkeletonData", "byte", "keyframes", {4, 32, 256}, [makeConfig](int keyframes) -> Benchmark::Body {
+        SkeletonPtr synthetic = makeSkeleton(makeConfig(keyframes));
+        if (!synthetic)
+            return Benchmark::Body();
+        return [synthetic]() -> size_t {
+            SkeletonJson json(synthetic->atlas());
+            SkeletonData* data = json.readSkeletonData(synthetic->json().c_str());
+            Benchmark::sink(data);
+            delete data;
+            return synthetic->json().size();
+        };
+    });
+}
+
+void registerSkin()
+{
+    Benchmark::instance().add("Skin::getAttachment", "lookup", "attachments/slot", {1, 4, 16, 64, 256}, [](int attachmentsPerSlot) -> Benchmark::Body {
+        SyntheticConfig config;
+        config.bones = 4;
+        config.slots = 32;
+        config.keyframes = 2;
+        config.meshVertices = 0;
+        config.attachmentsPerSlot = attachmentsPerSlot;
+        config.constraints = false;
+        SkeletonPtr synthetic = makeSkeleton(config);
+        if (!synthetic)
+            return Benchmark::Body();
+        struct Key {
+            size_t slot;
+            String name;
+        };
+        std::shared_ptr<std::vector<Key> > keys(new std::vector<Key>(1024));
+        Random random;
+        for (auto& key: *keys) {
+            key.slot = random.next() % config.slots;
+            key.name = SyntheticNames::attachment(int(key.slot), int(random.next() % attachmentsPerSlot)).c_str();
+        }
+        return [synthetic, keys]() -> size_t {
+            Skin* skin = synthetic->skeletonData()->getDefaultSkin();
+            for (const auto& key: *keys)
+                Benchmark::sink(skin->getAttachment(key.slot, key.name));
+            return keys->size();
+        };
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    registerCurveTimeline();
+    registerBinarySearch();
+    registerTimelineApply();
+    registerBoneUpdate();
+    registerPathConstraint();
+    registerPoseCache();
+    registerAnimationSwitch();
+    registerComputeWorldVertices();
+    registerClipping();
+    registerTriangulator();
+    registerJson();
+    registerSkin();
+    return Benchmark::instance().run(argc, argv);
+}
@@ -0,0 +1,22 @@
+TEMPLATE = app
+
+TARGET = spine-cpp-benchmark
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += \
+        benchmark.cpp \
+        main.cpp \
+        syntheticdata.cpp
+
+HEADERS += \
+        benchmark.h \
+        syntheticdata.h
+
+INCLUDEPATH += $$PWD/../spine-cpp/include
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../spine-cpp/release/ -lspine-cpp
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../spine-cpp/debug/ -lspine-cpp
+else:unix: LIBS += -L$$OUT_PWD/../spine-cpp/ -lspine-cpp
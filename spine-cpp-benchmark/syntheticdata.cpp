@@ -0,0 +1,498 @@
+#include "syntheticdata.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const float kFrameTime = 1.0f / 30;
+const float kPi = 3.14159265358979323846f;
+
+class JsonWriter
+{
+public:
+    std::string& str() { return m_str; }
+
+    JsonWriter& key(const std::string& name) {
+        comma();
+        m_str += '"';
+        m_str += name;
+        m_str += "\":";
+        m_needComma = false;
+        return *this;
+    }
+
+    JsonWriter& value(const std::string& text) {
+        comma();
+        m_str += '"';
+        m_str += text;
+        m_str += '"';
+        m_needComma = true;
+        return *this;
+    }
+
+    JsonWriter& value(float number) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.4g", number);
+        comma();
+        m_str += buffer;
+        m_needComma = true;
+        return *this;
+    }
+
+    JsonWriter& value(int number) {
+        comma();
+        m_str += std::to_string(number);
+        m_needComma = true;
+        return *this;
+    }
+
+    JsonWriter& beginObject() { comma(); m_str += '{'; m_needComma = false; return *this; }
+    JsonWriter& endObject() { m_str += '}'; m_needComma = true; return *this; }
+    JsonWriter& beginArray() { comma(); m_str += '['; m_needComma = false; return *this; }
+    JsonWriter& endArray() { m_str += ']'; m_needComma = true; return *this; }
+
+private:
+    void comma() {
+        if (m_needComma)
+            m_str += ',';
+    }
+
+    std::string m_str;
+    bool m_needComma = false;
+};
+
+int meshVertexCount(const SyntheticConfig& config)
+{
+    // triangles are unsigned short indices.
+    return std::min(std::max(config.meshVertices, 3), 65535);
+}
+
+bool hasConstraints(const SyntheticConfig& config)
+{
+    return config.constraints && config.bones >= 8;
+}
+
+void writeCurve(JsonWriter& w, int frame, int frameCount)
+{
+    if (frame == frameCount - 1 || frame % 8 == 7)
+        return; // linear
+    w.key("curve").value(0.25f).key("c2").value(0.1f).key("c3").value(0.75f).key("c4").value(0.9f);
+}
+
+std::string hexColor(int seed, bool alpha)
+{
+    char buffer[16];
+    if (alpha)
+        snprintf(buffer, sizeof(buffer), "%02x%02x%02x%02x", (seed * 37) & 0xff, (seed * 91) & 0xff, (seed * 53) & 0xff, 0x80 + (seed * 17 & 0x7f));
+    else
+        snprintf(buffer, sizeof(buffer), "%02x%02x%02x", (seed * 29) & 0xff, (seed * 71) & 0xff, (seed * 13) & 0xff);
+    return buffer;
+}
+
+void writeMeshVertices(JsonWriter& w, const SyntheticConfig& config, int slotIndex)
+{
+    int count = meshVertexCount(config);
+    int boneIndex = slotIndex % config.bones;
+    w.key("vertices").beginArray();
+    for (int v = 0; v < count; v++) {
+        float angle = 2 * kPi * v / count;
+        // every other vertex pulled inwards so the hull is concave.
+        float radius = v % 2 ? 20.0f : 30.0f;
+        float x = std::cos(angle) * radius, y = -std::sin(angle) * radius;
+        if (config.influences <= 0) {
+            w.value(x).value(y);
+            continue;
+        }
+        w.value(config.influences);
+        for (int i = 0; i < config.influences; i++)
+            w.value((boneIndex + i) % config.bones).value(x).value(y).value(1.0f / config.influences);
+    }
+    w.endArray();
+}
+
+void writeMesh(JsonWriter& w, const SyntheticConfig& config, int slotIndex)
+{
+    int count = meshVertexCount(config);
+    w.key("type").value(std::string("mesh"));
+    w.key("uvs").beginArray();
+    for (int v = 0; v < count; v++) {
+        float angle = 2 * kPi * v / count;
+        w.value(0.5f + std::cos(angle) * 0.5f).value(0.5f + std::sin(angle) * 0.5f);
+    }
+    w.endArray();
+    w.key("triangles").beginArray();
+    for (int v = 1; v + 1 < count; v++)
+        w.value(0).value(v).value(v + 1);
+    w.endArray();
+    writeMeshVertices(w, config, slotIndex);
+    w.key("hull").value(count);
+    w.key("width").value(60).key("height").value(60);
+}
+
+void writeBoneTimelines(JsonWriter& w, const SyntheticConfig& config, const char* timelineName)
+{
+    bool isRotate = std::string(timelineName) == "rotate";
+    bool isScale = std::string(timelineName) == "scale";
+    w.key("bones").beginObject();
+    for (int b = 0; b < config.bones; b++) {
+        w.key(SyntheticNames::bone(b)).beginObject().key(timelineName).beginArray();
+        for (int f = 0; f < config.keyframes; f++) {
+            w.beginObject().key("time").value(f * kFrameTime);
+            if (isRotate) {
+                w.key("angle").value(float((f * 37 + b * 11) % 360) - 180);
+            } else {
+                float base = isScale ? 1.0f : 0.0f;
+                w.key("x").value(base + float((f + b) % 7) * 0.1f).key("y").value(base - float((f * 3 + b) % 5) * 0.1f);
+            }
+            writeCurve(w, f, config.keyframes);
+            w.endObject();
+        }
+        w.endArray().endObject();
+    }
+    w.endObject();
+}
+
+void writeSlotTimelines(JsonWriter& w, const SyntheticConfig& config, const char* timelineName)
+{
+    std::string name(timelineName);
+    w.key("slots").beginObject();
+    for (int s = 0; s < config.slots; s++) {
+        w.key(SyntheticNames::slot(s)).beginObject().key(name).beginArray();
+        for (int f = 0; f < config.keyframes; f++) {
+            w.beginObject().key("time").value(f * kFrameTime);
+            if (name == "color") {
+                w.key("color").value(hexColor(f + s, true));
+                writeCurve(w, f, config.keyframes);
+            } else if (name == "twoColor") {
+                w.key("light").value(hexColor(f + s, true)).key("dark").value(hexColor(f * 3 + s, false));
+                writeCurve(w, f, config.keyframes);
+            } else {
+                w.key("name").value(SyntheticNames::attachment(s, (f + s) % std::max(config.attachmentsPerSlot, 1)));
+            }
+            w.endObject();
+        }
+        w.endArray().endObject();
+    }
+    w.endObject();
+}
+
+void writeDeformTimelines(JsonWriter& w, const SyntheticConfig& config)
+{
+    int count = meshVertexCount(config);
+    w.key("deform").beginObject().key("default").beginObject();
+    for (int s = 0; s < config.slots; s++) {
+        w.key(SyntheticNames::slot(s)).beginObject().key(SyntheticNames::attachment(s, 0)).beginArray();
+        for (int f = 0; f < config.keyframes; f++) {
+            w.beginObject().key("time").value(f * kFrameTime);
+            w.key("vertices").beginArray();
+            for (int v = 0; v < count * 2; v++)
+                w.value(float((v + f + s) % 11) * 0.5f - 2.5f);
+            w.endArray();
+            writeCurve(w, f, config.keyframes);
+            w.endObject();
+        }
+        w.endArray().endObject();
+    }
+    w.endObject().endObject();
+}
+
+void writeConstraintTimeline(JsonWriter& w, const SyntheticConfig& config, const char* section, const char* timelineName)
+{
+    std::string name(timelineName);
+    bool isPath = std::string(section) == "path";
+    w.key(section).beginObject().key(section);
+    if (isPath)
+        w.beginObject().key(name);
+    w.beginArray();
+    for (int f = 0; f < config.keyframes; f++) {
+        float mix = float(f % 5) * 0.2f + 0.1f;
+        w.beginObject().key("time").value(f * kFrameTime);
+        if (name == "ik")
+            w.key("mix").value(mix).key("softness").value(float(f % 3));
+        else if (name == "transform")
+            w.key("rotateMix").value(mix).key("translateMix").value(mix).key("scaleMix").value(mix).key("shearMix").value(mix);
+        else if (name == "position")
+            w.key("position").value(mix);
+        else if (name == "spacing")
+            w.key("spacing").value(float(f % 4) * 5.0f);
+        else
+            w.key("rotateMix").value(mix).key("translateMix").value(mix);
+        writeCurve(w, f, config.keyframes);
+        w.endObject();
+    }
+    w.endArray();
+    if (isPath)
+        w.endObject();
+    w.endObject();
+}
+
+void writeAnimations(JsonWriter& w, const SyntheticConfig& config)
+{
+    w.key("animations").beginObject();
+
+    static const char* boneTimelines[] = {"rotate", "translate", "scale", "shear"};
+    for (const char* timelineName: boneTimelines) {
+        w.key(timelineName).beginObject();
+        writeBoneTimelines(w, config, timelineName);
+        w.endObject();
+    }
+
+    static const char* slotTimelines[] = {"color", "twoColor", "attachment"};
+    for (const char* timelineName: slotTimelines) {
+        w.key(timelineName).beginObject();
+        writeSlotTimelines(w, config, timelineName);
+        w.endObject();
+    }
+
+    if (config.meshVertices > 0) {
+        w.key("deform").beginObject();
+        writeDeformTimelines(w, config);
+        w.endObject();
+    }
+
+    w.key("drawOrder").beginObject().key("drawOrder").beginArray();
+    for (int f = 0; f < config.keyframes; f++) {
+        w.beginObject().key("time").value(f * kFrameTime);
+        if (f % 2 == 0 && config.slots > 1) {
+            w.key("offsets").beginArray().beginObject()
+                    .key("slot").value(SyntheticNames::slot(0)).key("offset").value(1)
+                    .endObject().endArray();
+        }
+        w.endObject();
+    }
+    w.endArray().endObject();
+
+    w.key("events").beginObject().key("events").beginArray();
+    for (int f = 0; f < config.keyframes; f++)
+        w.beginObject().key("time").value(f * kFrameTime).key("name").value(std::string("event")).key("int").value(f).endObject();
+    w.endArray().endObject();
+
+    if (hasConstraints(config)) {
+        w.key("ik").beginObject();
+        writeConstraintTimeline(w, config, "ik", "ik");
+        w.endObject();
+        w.key("transform").beginObject();
+        writeConstraintTimeline(w, config, "transform", "transform");
+        w.endObject();
+        w.key("pathPosition").beginObject();
+        writeConstraintTimeline(w, config, "path", "position");
+        w.endObject();
+        w.key("pathSpacing").beginObject();
+        writeConstraintTimeline(w, config, "path", "spacing");
+        w.endObject();
+        w.key("pathMix").beginObject();
+        writeConstraintTimeline(w, config, "path", "mix");
+        w.endObject();
+    }
+
+    w.endObject();
+}
+
+} // namespace
+
+std::string SyntheticNames::bone(int index)
+{
+    return "bone" + std::to_string(index);
+}
+
+std::string SyntheticNames::slot(int index)
+{
+    return "slot" + std::to_string(index);
+}
+
+std::string SyntheticNames::attachment(int slotIndex, int attachmentIndex)
+{
+    return "att_" + std::to_string(slotIndex) + "_" + std::to_string(attachmentIndex);
+}
+
+std::string syntheticAtlas(const SyntheticConfig &config)
+{
+    std::string atlas = "\nsynthetic.png\nsize: 4096,4096\nformat: RGBA8888\nfilter: Linear,Linear\nrepeat: none\n";
+    char buffer[256];
+    int index = 0;
+    for (int s = 0; s < config.slots; s++) {
+        for (int a = 0; a < std::max(config.attachmentsPerSlot, 1); a++, index++) {
+            snprintf(buffer, sizeof(buffer),
+                     "%s\n  rotate: false\n  xy: %d, %d\n  size: 60, 60\n  orig: 60, 60\n  offset: 0, 0\n  index: -1\n",
+                     SyntheticNames::attachment(s, a).c_str(), (index % 64) * 64, (index / 64 % 64) * 64);
+            atlas += buffer;
+        }
+    }
+    return atlas;
+}
+
+std::string syntheticSkeletonJson(const SyntheticConfig &config)
+{
+    JsonWriter w;
+    w.beginObject();
+    w.key("skeleton").beginObject()
+            .key("hash").value(std::string("synthetic"))
+            .key("spine").value(std::string("3.8.99"))
+            .key("width").value(100).key("height").value(100)
+            .endObject();
+
+    w.key("bones").beginArray();
+    for (int b = 0; b < config.bones; b++) {
+        w.beginObject().key("name").value(SyntheticNames::bone(b));
+        if (b > 0) {
+            w.key("parent").value(SyntheticNames::bone((b - 1) / 2));
+            w.key("length").value(20).key("x").value(float(b % 5) * 4.0f).key("y").value(float(b % 3) * 2.0f);
+            w.key("rotation").value(float(b * 13 % 90) - 45);
+        }
+        w.endObject();
+    }
+    w.endArray();
+
+    bool constraints = hasConstraints(config);
+    w.key("slots").beginArray();
+    for (int s = 0; s < config.slots; s++) {
+        w.beginObject().key("name").value(SyntheticNames::slot(s)).key("bone").value(SyntheticNames::bone(s % config.bones))
+                .key("attachment").value(SyntheticNames::attachment(s, 0)).endObject();
+    }
+    if (constraints) {
+        w.beginObject().key("name").value(std::string("pathSlot")).key("bone").value(SyntheticNames::bone(0))
+                .key("attachment").value(std::string("path")).endObject();
+    }
+    w.endArray();
+
+    if (constraints) {
+        w.key("ik").beginArray().beginObject()
+                .key("name").value(std::string("ik"))
+                .key("bones").beginArray().value(SyntheticNames::bone(1)).value(SyntheticNames::bone(3)).endArray()
+                .key("target").value(SyntheticNames::bone(2))
+                .endObject().endArray();
+        w.key("transform").beginArray().beginObject()
+                .key("name").value(std::string("transform"))
+                .key("bones").beginArray().value(SyntheticNames::bone(5)).endArray()
+                .key("target").value(SyntheticNames::bone(6))
+                .key("rotation").value(15)
+                .endObject().endArray();
+        w.key("path").beginArray().beginObject()
+                .key("name").value(std::string("path"))
+                .key("bones").beginArray();
+        for (int b = 7; b < std::min(config.bones, 7 + config.pathBones); b++)
+            w.value(SyntheticNames::bone(b));
+        w.endArray()
+                .key("target").value(std::string("pathSlot"))
+                .key("rotateMode").value(std::string("chainScale"))
+                .key("spacing").value(5)
+                .endObject().endArray();
+    }
+
+    w.key("skins").beginArray().beginObject().key("name").value(std::string("default")).key("attachments").beginObject();
+    for (int s = 0; s < config.slots; s++) {
+        w.key(SyntheticNames::slot(s)).beginObject();
+        for (int a = 0; a < std::max(config.attachmentsPerSlot, 1); a++) {
+            w.key(SyntheticNames::attachment(s, a)).beginObject();
+            if (config.meshVertices > 0)
+                writeMesh(w, config, s);
+            else
+                w.key("width").value(60).key("height").value(60).key("rotation").value(float(a * 10));
+            w.endObject();
+        }
+        w.endObject();
+    }
+    if (constraints) {
+        w.key("pathSlot").beginObject().key("path").beginObject()
+                .key("type").value(std::string("path"))
+                .key("lengths").beginArray().value(180.0f).value(400.0f).endArray()
+                .key("vertexCount").value(6)
+                .key("vertices").beginArray()
+                .value(-40.0f).value(-20.0f).value(0.0f).value(0.0f).value(60.0f).value(40.0f)
+                .value(120.0f).value(90.0f).value(180.0f).value(60.0f).value(260.0f).value(20.0f)
+                .endArray()
+                .endObject().endObject();
+    }
+    w.endObject().endObject().endArray();
+
+    w.key("events").beginObject().key("event").beginObject().key("int").value(1).endObject().endObject();
+
+    writeAnimations(w, config);
+    w.endObject();
+    return w.str();
+}
+
+void syntheticPolygon(int vertexCount, float radius, spine::Vector<float> &polygon)
+{
+    polygon.setSize(vertexCount * 2, 0);
+    for (int i = 0; i < vertexCount; i++) {
+        // clockwise (negative angle) with alternating inner/outer radius.
+        float angle = -2 * kPi * i / vertexCount;
+        float r = i % 2 ? radius * 0.6f : radius;
+        polygon[i * 2] = std::cos(angle) * r;
+        polygon[i * 2 + 1] = std::sin(angle) * r;
+    }
+}
+
+void NullTextureLoader::load(spine::AtlasPage &page, const spine::String &path)
+{
+    SP_UNUSED(page);
+    SP_UNUSED(path);
+}
+
+void NullTextureLoader::unload(void *texture)
+{
+    SP_UNUSED(texture);
+}
+
+SyntheticSkeleton::SyntheticSkeleton(const SyntheticConfig &config):
+    m_config(config)
+{
+    std::string atlas = syntheticAtlas(config);
+    m_atlas = new spine::Atlas(atlas.data(), int(atlas.size()), "", &m_textureLoader);
+    m_json = syntheticSkeletonJson(config);
+
+    spine::SkeletonJson json(m_atlas);
+    m_skeletonData = json.readSkeletonData(m_json.c_str());
+    if (!m_skeletonData) {
+        m_error = json.getError().buffer();
+        return;
+    }
+    m_skeleton = new spine::Skeleton(m_skeletonData);
+    m_skeleton->setToSetupPose();
+    m_skeleton->updateWorldTransform();
+}
+
+SyntheticSkeleton::~SyntheticSkeleton()
+{
+    delete m_skeleton;
+    delete m_skeletonData;
+    delete m_atlas;
+}
+
+bool SyntheticSkeleton::isValid() const
+{
+    return m_skeleton != nullptr;
+}
+
+const std::string &SyntheticSkeleton::error() const
+{
+    return m_error;
+}
+
+const SyntheticConfig &SyntheticSkeleton::config() const
+{
+    return m_config;
+}
+
+const std::string &SyntheticSkeleton::json() const
+{
+    return m_json;
+}
+
+spine::Atlas *SyntheticSkeleton::atlas() const
+{
+    return m_atlas;
+}
+
+spine::SkeletonData *SyntheticSkeleton::skeletonData() const
+{
+    return m_skeletonData;
+}
+
+spine::Skeleton *SyntheticSkeleton::skeleton() const
+{
+    return m_skeleton;
+}
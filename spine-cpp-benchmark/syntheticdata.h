@@ -0,0 +1,84 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <string>
+#include <spine/spine.h>
+
+/**
+ * @brief Parameters of a generated skeleton, every count can be scaled independently.
+ */
+struct SyntheticConfig {
+    int bones = 16;                 // bone count, bones form a binary tree under "root".
+    int slots = 8;                  // slot count, slots are distributed round robin over bones.
+    int keyframes = 8;              // keyframes of every timeline of every animation.
+    int meshVertices = 16;          // vertices per mesh attachment, 0 generates region attachments.
+    int influences = 0;             // bone influences per mesh vertex, 0 generates unweighted meshes.
+    int attachmentsPerSlot = 1;     // attachments registered for each slot in the default skin.
+    bool constraints = true;        // adds one ik, transform and path constraint (needs >= 8 bones).
+    int pathBones = 8;              // bones constrained to the path, the ones after the ik and transform bones.
+};
+
+/**
+ * @brief Names used by the generator, so benchmarks can look things up without guessing.
+ */
+namespace SyntheticNames {
+std::string bone(int index);
+std::string slot(int index);
+std::string attachment(int slotIndex, int attachmentIndex);
+}
+
+/**
+ * @brief syntheticAtlas Generates an atlas text with one region per attachment of the config.
+ */
+std::string syntheticAtlas(const SyntheticConfig& config);
+
+/**
+ * @brief syntheticSkeletonJson Generates a spine 3.8 skeleton json.
+ *
+ * Animations generated (one timeline per bone, slot or constraint each):
+ * rotate, translate, scale, shear, color, twoColor, attachment, deform, drawOrder,
+ * events, ik, transform, pathPosition, pathSpacing, pathMix.
+ */
+std::string syntheticSkeletonJson(const SyntheticConfig& config);
+
+/**
+ * @brief syntheticPolygon Generates a concave, star shaped, clockwise polygon with vertexCount vertices.
+ */
+void syntheticPolygon(int vertexCount, float radius, spine::Vector<float>& polygon);
+
+class NullTextureLoader: public spine::TextureLoader
+{
+public:
+    virtual void load(spine::AtlasPage &page, const spine::String &path) override;
+    virtual void unload(void *texture) override;
+};
+
+/**
+ * @brief Owns an atlas, skeleton data and posed skeleton built from a SyntheticConfig.
+ */
+class SyntheticSkeleton
+{
+public:
+    explicit SyntheticSkeleton(const SyntheticConfig& config);
+    ~SyntheticSkeleton();
+
+    bool isValid() const;
+    const std::string& error() const;
+
+    const SyntheticConfig& config() const;
+    const std::string& json() const;
+    spine::Atlas* atlas() const;
+    spine::SkeletonData* skeletonData() const;
+    spine::Skeleton* skeleton() const;
+
+private:
+    SyntheticConfig m_config;
+    std::string m_json;
+    std::string m_error;
+    NullTextureLoader m_textureLoader;
+    spine::Atlas* m_atlas = nullptr;
+    spine::SkeletonData* m_skeletonData = nullptr;
+    spine::Skeleton* m_skeleton = nullptr;
+};
+
+#endif // SYNTHETICDATA_H
@@ -0,0 +1,119 @@
+#include <memory>
+
+#include <spine/spine.h>
+
+#include "test.h"
+
+using namespace spine;
+
+namespace {
+
+class EventCounter: public AnimationStateListenerObject
+{
+public:
+    virtual void callback(AnimationState* state, EventType type, TrackEntry* entry, Event* event) override {
+        SP_UNUSED(state);
+        SP_UNUSED(entry);
+        SP_UNUSED(event);
+        if (type == EventType_Event)
+            events++;
+    }
+
+    int events = 0;
+};
+
+/**
+ * @brief One round of typical playback: every animation is set in turn on the base track with a
+ * queued follow up, while an overlay track is switched every other round, so entries are mixed,
+ * completed, interrupted and returned to the pool.
+ */
+void playRound(AnimationState& state, Skeleton& skeleton, Vector<Animation*>& animations)
+{
+    for (size_t i = 0, n = animations.size(); i < n; i++) {
+        state.setAnimation(0, animations[i], true);
+        state.addAnimation(0, animations[(i + 1) % n], false, 0.25f);
+        if (i % 2 == 0)
+            state.setAnimation(1, animations[(i + 3) % n], false);
+        else
+            state.addEmptyAnimation(1, 0.1f, 0);
+        for (int frame = 0; frame < 40; frame++) {
+            state.update(1 / 60.0f);
+            state.apply(skeleton);
+            skeleton.updateWorldTransform();
+        }
+    }
+}
+
+void testSteadyStateAllocations()
+{
+    NullTextureLoader textureLoader;
+    Atlas atlas(Test::examplePath("spineboy", "spineboy.atlas").c_str(), &textureLoader);
+    SkeletonJson json(&atlas);
+    std::unique_ptr<SkeletonData> skeletonData(json.readSkeletonDataFile(Test::examplePath("spineboy", "spineboy-pro.json").c_str()));
+    TEST_CHECK(skeletonData);
+    if (!skeletonData)
+        return;
+
+    Skeleton skeleton(skeletonData.get());
+    AnimationStateData stateData(skeletonData.get());
+    stateData.setDefaultMix(0.2f);
+    AnimationState state(&stateData);
+    EventCounter counter;
+    state.setListener(&counter);
+    Vector<Animation*>& animations = skeletonData->getAnimations();
+
+    // the first rounds grow the pools and the per entry storage to the largest mix chain.
+    playRound(state, skeleton, animations);
+    playRound(state, skeleton, animations);
+
+    size_t allocations = CountingExtension::allocations();
+    int events = counter.events;
+    for (int round = 0; round < 3; round++)
+        playRound(state, skeleton, animations);
+    TEST_CHECK(CountingExtension::allocations() == allocations);
+    TEST_CHECK(counter.events > events);
+}
+
+void testApplyEventsMatchesApply()
+{
+    NullTextureLoader textureLoader;
+    Atlas atlas(Test::examplePath("spineboy", "spineboy.atlas").c_str(), &textureLoader);
+    SkeletonJson json(&atlas);
+    std::unique_ptr<SkeletonData> skeletonData(json.readSkeletonDataFile(Test::examplePath("spineboy", "spineboy-pro.json").c_str()));
+    TEST_CHECK(skeletonData);
+    if (!skeletonData)
+        return;
+
+    // walk fires footstep events, both states see the same times and must fire them on the same frames.
+    Skeleton skeleton(skeletonData.get());
+    AnimationStateData stateData(skeletonData.get());
+    AnimationState applied(&stateData), eventsOnly(&stateData);
+    EventCounter appliedCounter, eventsOnlyCounter;
+    applied.setListener(&appliedCounter);
+    eventsOnly.setListener(&eventsOnlyCounter);
+    applied.setAnimation(0, "walk", true);
+    eventsOnly.setAnimation(0, "walk", true);
+    bool matches = true;
+    for (int frame = 0; frame < 300; frame++) {
+        applied.update(1 / 60.0f);
+        eventsOnly.update(1 / 60.0f);
+        applied.apply(skeleton);
+        if (!eventsOnly.applyEvents(skeleton) || appliedCounter.events != eventsOnlyCounter.events)
+            matches = false;
+    }
+    TEST_CHECK(matches);
+    TEST_CHECK(appliedCounter.events > 0);
+
+    // anything but a single unmixed entry on track 0 is left to apply.
+    eventsOnly.setAnimation(1, "aim", true);
+    eventsOnly.update(1 / 60.0f);
+    TEST_CHECK(!eventsOnly.applyEvents(skeleton));
+}
+
+} // namespace
+
+void registerAnimationStateTests()
+{
+    Test::instance().add("AnimationState steady state does not allocate", testSteadyStateAllocations);
+    Test::instance().add("AnimationState::applyEvents fires the events of apply", testApplyEventsMatchesApply);
+}
@@ -0,0 +1,61 @@
+#include <spine/spine.h>
+
+#include "test.h"
+
+using namespace spine;
+
+namespace {
+
+const float g_percents[] = {0, 0.1f, 0.25f, 0.5f, 0.7f, 0.9f, 1};
+
+/**
+ * @brief Checks the curve of a frame matches the same curve set on a timeline of its own.
+ */
+bool sameCurve(CurveTimeline& timeline, size_t frameIndex, float cx1, float cy1, float cx2, float cy2)
+{
+    RotateTimeline expected(2);
+    expected.setBezierTolerance(timeline.getBezierTolerance());
+    expected.setCurve(0, cx1, cy1, cx2, cy2);
+    for (size_t i = 0; i < sizeof(g_percents) / sizeof(g_percents[0]); i++) {
+        if (timeline.getCurvePercent(frameIndex, g_percents[i]) != expected.getCurvePercent(0, g_percents[i]))
+            return false;
+    }
+    return true;
+}
+
+void testSetCurveAgain()
+{
+    RotateTimeline timeline(4);
+    timeline.setCurve(0, 0.25f, 0, 0.75f, 1);
+    timeline.setCurve(1, 0.1f, 0.9f, 0.9f, 0.1f);
+    timeline.setCurve(2, 0.5f, 0, 0.5f, 1);
+
+    // a smaller tolerance takes more samples, the frames after the replaced one move.
+    timeline.setBezierTolerance(0.00001f);
+    timeline.setCurve(1, 0.1f, 0.9f, 0.9f, 0.1f);
+    TEST_CHECK(sameCurve(timeline, 1, 0.1f, 0.9f, 0.9f, 0.1f));
+    timeline.setBezierTolerance(CurveTimeline::DEFAULT_BEZIER_TOLERANCE);
+    TEST_CHECK(sameCurve(timeline, 0, 0.25f, 0, 0.75f, 1));
+    TEST_CHECK(sameCurve(timeline, 2, 0.5f, 0, 0.5f, 1));
+
+    // a frame set linear and back to a bezier reuses its samples.
+    timeline.setLinear(0);
+    timeline.setCurve(0, 0.3f, 0.1f, 0.6f, 0.8f);
+    TEST_CHECK(sameCurve(timeline, 0, 0.3f, 0.1f, 0.6f, 0.8f));
+    TEST_CHECK(sameCurve(timeline, 2, 0.5f, 0, 0.5f, 1));
+
+    // setting the curves again keeps the storage of the ones they replace.
+    size_t allocations = CountingExtension::allocations();
+    for (int i = 0; i < 1000; i++) {
+        timeline.setCurve(i % 3, 0.25f, 0, 0.75f, 1);
+        timeline.setStepped(i % 3);
+    }
+    TEST_CHECK(CountingExtension::allocations() == allocations);
+}
+
+} // namespace
+
+void registerCurveTimelineTests()
+{
+    Test::instance().add("CurveTimeline::setCurve replaces the samples of a frame", testSetCurveAgain);
+}
@@ -0,0 +1,23 @@
+#include <spine/spine.h>
+
+#include "test.h"
+
+void registerAnimationStateTests();
+void registerCurveTimelineTests();
+void registerPropertyIdSetTests();
+void registerSkeletonBinaryTests();
+
+namespace spine {
+SpineExtension* getDefaultExtension() {
+    return new CountingExtension();
+}
+}
+
+int main(int argc, char *argv[])
+{
+    registerAnimationStateTests();
+    registerCurveTimelineTests();
+    registerPropertyIdSetTests();
+    registerSkeletonBinaryTests();
+    return Test::instance().run(argc, argv);
+}
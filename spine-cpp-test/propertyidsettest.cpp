@@ -0,0 +1,60 @@
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <spine/spine.h>
+
+#include "test.h"
+
+using namespace spine;
+
+namespace {
+
+void testManyDeformAttachments()
+{
+    // vertex attachment IDs step by 2048 from a shared counter, past 8192 attachments the deform ID
+    // (type << 24) + attachment ID + slot index carries into the type byte.
+    const int attachmentCount = 9000;
+    std::vector<std::unique_ptr<MeshAttachment> > attachments;
+    std::vector<int> ids;
+    for (int i = 0; i < attachmentCount; i++) {
+        attachments.emplace_back(new MeshAttachment("mesh"));
+        DeformTimeline timeline(1);
+        timeline.setSlotIndex(i % 7);
+        timeline.setAttachment(attachments.back().get());
+        ids.push_back(timeline.getPropertyId());
+    }
+    for (int bone = 0; bone < 64; bone++) {
+        RotateTimeline timeline(1);
+        timeline.setBoneIndex(bone);
+        ids.push_back(timeline.getPropertyId());
+    }
+    ids.push_back(EventTimeline(1).getPropertyId());
+    ids.push_back(DrawOrderTimeline(1).getPropertyId());
+
+    size_t bytes = CountingExtension::allocatedBytes();
+    PropertyIdSet set;
+    std::set<int> expected;
+    bool matches = true;
+    for (size_t i = 0; i < ids.size(); i++) {
+        bool added = expected.insert(ids[i]).second;
+        if (set.contains(ids[i]) == added || set.add(ids[i]) != added)
+            matches = false;
+    }
+    TEST_CHECK(matches);
+    for (size_t i = 0; i < ids.size(); i++)
+        TEST_CHECK(set.contains(ids[i]));
+    // a carried deform ID must not be taken for a dense index and size the bitset by the attachment ID.
+    TEST_CHECK(CountingExtension::allocatedBytes() - bytes < 4 * 1024 * 1024);
+
+    set.clear();
+    for (size_t i = 0; i < ids.size(); i++)
+        TEST_CHECK(!set.contains(ids[i]));
+}
+
+} // namespace
+
+void registerPropertyIdSetTests()
+{
+    Test::instance().add("PropertyIdSet with more than 8192 vertex attachments", testManyDeformAttachments);
+}
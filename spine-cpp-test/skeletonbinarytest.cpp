@@ -0,0 +1,254 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spine/spine.h>
+
+#include "test.h"
+
+using namespace spine;
+
+namespace {
+
+/**
+ * @brief Writes skeleton data in the binary format, the sections a test does not set are empty.
+ */
+class BinaryWriter
+{
+public:
+    void writeByte(unsigned char value) {
+        bytes.push_back(value);
+    }
+
+    void writeBoolean(bool value) {
+        writeByte(value ? 1 : 0);
+    }
+
+    void writeVarint(int value) {
+        unsigned int bits = (unsigned int) value;
+        while (bits > 0x7f) {
+            writeByte((unsigned char) ((bits & 0x7f) | 0x80));
+            bits >>= 7;
+        }
+        writeByte((unsigned char) bits);
+    }
+
+    void writeFloat(float value) {
+        union {
+            float floatValue;
+            unsigned int intValue;
+        } floatToInt;
+        floatToInt.floatValue = value;
+        for (int shift = 24; shift >= 0; shift -= 8)
+            writeByte((unsigned char) (floatToInt.intValue >> shift));
+    }
+
+    void writeString(const std::string& value) {
+        writeVarint((int) value.size() + 1);
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    void writeFloats(int count) {
+        for (int i = 0; i < count; i++)
+            writeFloat(0);
+    }
+
+    /**
+     * @brief writeHeader Writes the hash, version, bounds and an empty string table.
+     */
+    void writeHeader() {
+        writeString("hash");
+        writeString("3.8.99");
+        writeFloats(4);
+        writeBoolean(false);
+        writeVarint(0);
+    }
+
+    /**
+     * @brief writeBone Writes a bone with the given parent index, which the root bone has none of.
+     */
+    void writeBone(const std::string& name, int parent) {
+        writeString(name);
+        if (parent >= 0)
+            writeVarint(parent);
+        writeFloats(8);
+        writeVarint(0);
+        writeBoolean(false);
+    }
+
+    void writeSlot(const std::string& name, int bone) {
+        writeString(name);
+        writeVarint(bone);
+        for (int i = 0; i < 8; i++)
+            writeByte(0xff);
+        writeVarint(0);
+        writeVarint(0);
+    }
+
+    /**
+     * @brief writeSetup Writes a root bone, the given number of slots on it, no constraints, skins or
+     * events, then the count of animations that follow.
+     */
+    void writeSetup(int slotCount, int animationCount) {
+        writeHeader();
+        writeVarint(1);
+        writeBone("root", -1);
+        writeVarint(slotCount);
+        for (int i = 0; i < slotCount; i++)
+            writeSlot("slot" + std::to_string(i), 0);
+        writeVarint(0); // IK constraints.
+        writeVarint(0); // Transform constraints.
+        writeVarint(0); // Path constraints.
+        writeVarint(0); // Default skin.
+        writeVarint(0); // Skins.
+        writeVarint(0); // Events.
+        writeVarint(animationCount);
+    }
+
+    std::vector<unsigned char> bytes;
+};
+
+/**
+ * @brief Checks an eager read fails with the error. A lazy read either fails the same way or, for
+ * errors only found in the timelines, leaves the animations without any.
+ */
+void checkInvalid(const BinaryWriter& writer, const char* error)
+{
+    for (int lazy = 0; lazy < 2; lazy++) {
+        NullTextureLoader textureLoader;
+        Atlas atlas(Test::examplePath("spineboy", "spineboy.atlas").c_str(), &textureLoader);
+        SkeletonBinary binary(&atlas);
+        binary.setLazyAnimations(lazy == 1);
+        std::unique_ptr<SkeletonData> skeletonData(binary.readSkeletonData(writer.bytes.data(), (int) writer.bytes.size()));
+        if (lazy == 1 && skeletonData) {
+            Vector<Animation*>& animations = skeletonData->getAnimations();
+            for (size_t i = 0; i < animations.size(); i++)
+                TEST_CHECK(animations[i]->getTimelines().size() == 0);
+            continue;
+        }
+        TEST_CHECK(!skeletonData);
+        TEST_CHECK(binary.getError() == error);
+    }
+}
+
+void testBoneParent()
+{
+    BinaryWriter writer;
+    writer.writeHeader();
+    writer.writeVarint(3);
+    writer.writeBone("root", -1);
+    writer.writeBone("child", 0);
+    // a parent is read before its children, so the index of the bone itself is out of range.
+    writer.writeBone("loop", 2);
+    writer.writeVarint(0);
+    checkInvalid(writer, "Invalid index in skeleton data.");
+}
+
+void testSlotBone()
+{
+    BinaryWriter writer;
+    writer.writeHeader();
+    writer.writeVarint(1);
+    writer.writeBone("root", -1);
+    writer.writeVarint(1);
+    writer.writeSlot("slot", 1);
+    checkInvalid(writer, "Invalid index in skeleton data.");
+}
+
+void testStringRef()
+{
+    BinaryWriter writer;
+    writer.writeHeader();
+    writer.writeVarint(1);
+    writer.writeBone("root", -1);
+    writer.writeVarint(1);
+    writer.writeString("slot");
+    writer.writeVarint(0);
+    for (int i = 0; i < 8; i++)
+        writer.writeByte(0xff);
+    // the string table is empty, 0 is the only valid reference.
+    writer.writeVarint(1);
+    writer.writeVarint(0);
+    checkInvalid(writer, "Invalid index in skeleton data.");
+}
+
+/**
+ * @brief writeAnimation Starts an animation without slot, bone, constraint or deform timelines.
+ */
+void writeAnimation(BinaryWriter& writer)
+{
+    writer.writeString("animation");
+    for (int i = 0; i < 6; i++)
+        writer.writeVarint(0);
+}
+
+void testEventIndex()
+{
+    BinaryWriter writer;
+    writer.writeSetup(1, 1);
+    writeAnimation(writer);
+    writer.writeVarint(0); // Draw order.
+    writer.writeVarint(1);
+    writer.writeFloat(0);
+    writer.writeVarint(0); // No event data is in the skeleton data.
+    checkInvalid(writer, "Invalid index in animation data.");
+}
+
+void testDrawOrder()
+{
+    const int slotCount = 3;
+    // pairs of slot index and offset, each written as one draw order key.
+    const std::vector<std::vector<int> > keys = {
+        {3, 0},         // slot out of range
+        {0, 3},         // moved past the last slot
+        {0, -1},        // moved before the first slot
+        {1, 0, 0, 1},   // slots out of order
+        {0, 1, 1, 0},   // two slots moved to the same index
+        {0, 0, 1, 0, 2, 0, 0, 0} // more keys than slots
+    };
+    for (size_t i = 0; i < keys.size(); i++) {
+        BinaryWriter writer;
+        writer.writeSetup(slotCount, 1);
+        writeAnimation(writer);
+        writer.writeVarint(1);
+        writer.writeFloat(0);
+        writer.writeVarint((int) keys[i].size() / 2);
+        for (size_t ii = 0; ii < keys[i].size(); ii++)
+            writer.writeVarint(keys[i][ii]);
+        writer.writeVarint(0); // Events.
+        checkInvalid(writer, "Invalid index in animation data.");
+    }
+
+    // a slot moved back by a negative offset is valid.
+    BinaryWriter writer;
+    writer.writeSetup(slotCount, 1);
+    writeAnimation(writer);
+    writer.writeVarint(1);
+    writer.writeFloat(0);
+    writer.writeVarint(1);
+    writer.writeVarint(2);
+    writer.writeVarint(-2);
+    writer.writeVarint(0);
+    NullTextureLoader textureLoader;
+    Atlas atlas(Test::examplePath("spineboy", "spineboy.atlas").c_str(), &textureLoader);
+    SkeletonBinary binary(&atlas);
+    std::unique_ptr<SkeletonData> skeletonData(binary.readSkeletonData(writer.bytes.data(), (int) writer.bytes.size()));
+    TEST_CHECK(skeletonData);
+    if (!skeletonData)
+        return;
+    DrawOrderTimeline* timeline = static_cast<DrawOrderTimeline*>(skeletonData->getAnimations()[0]->getTimelines()[0]);
+    Vector<int>& drawOrder = timeline->getDrawOrders()[0];
+    TEST_CHECK(drawOrder.size() == slotCount);
+    TEST_CHECK(drawOrder[0] == 2 && drawOrder[1] == 0 && drawOrder[2] == 1);
+}
+
+} // namespace
+
+void registerSkeletonBinaryTests()
+{
+    Test::instance().add("SkeletonBinary rejects a bone parent out of range", testBoneParent);
+    Test::instance().add("SkeletonBinary rejects a slot bone out of range", testSlotBone);
+    Test::instance().add("SkeletonBinary rejects a string reference out of range", testStringRef);
+    Test::instance().add("SkeletonBinary rejects an event index out of range", testEventIndex);
+    Test::instance().add("SkeletonBinary rejects invalid draw order keys", testDrawOrder);
+}
@@ -0,0 +1,26 @@
+TEMPLATE = app
+
+TARGET = spine-cpp-test
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += \
+        animationstatetest.cpp \
+        curvetimelinetest.cpp \
+        main.cpp \
+        propertyidsettest.cpp \
+        skeletonbinarytest.cpp \
+        test.cpp
+
+HEADERS += \
+        test.h
+
+INCLUDEPATH += $$PWD/../spine-cpp/include
+
+DEFINES += SPINE_EXAMPLES_DIR=\\\"$$PWD/../SpineItemTest/examples\\\"
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../spine-cpp/release/ -lspine-cpp
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../spine-cpp/debug/ -lspine-cpp
+else:unix: LIBS += -L$$OUT_PWD/../spine-cpp/ -lspine-cpp
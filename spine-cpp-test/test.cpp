@@ -0,0 +1,105 @@
+#include "test.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifndef SPINE_EXAMPLES_DIR
+#define SPINE_EXAMPLES_DIR "../SpineItemTest/examples"
+#endif
+
+namespace {
+size_t g_allocations = 0;
+size_t g_allocatedBytes = 0;
+}
+
+Test &Test::instance()
+{
+    static Test _instance;
+    return _instance;
+}
+
+void Test::add(const std::string &name, const Test::Body &body)
+{
+    Case testCase;
+    testCase.name = name;
+    testCase.body = body;
+    m_cases.push_back(testCase);
+}
+
+int Test::run(int argc, char **argv)
+{
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            printf("usage: %s [filter]\n", argv[0]);
+            return 0;
+        }
+        filter = argv[i];
+    }
+
+    int failedTests = 0;
+    for (const auto& testCase: m_cases) {
+        if (!filter.empty() && testCase.name.find(filter) == std::string::npos)
+            continue;
+        m_failures = 0;
+        testCase.body();
+        printf("%s %s\n", m_failures ? "FAIL" : "PASS", testCase.name.c_str());
+        if (m_failures)
+            failedTests++;
+    }
+    printf("%d test(s) failed\n", failedTests);
+    return failedTests;
+}
+
+void Test::fail(const char *file, int line, const char *expression)
+{
+    printf("  %s:%d: check failed: %s\n", file, line, expression);
+    instance().m_failures++;
+}
+
+std::string Test::examplePath(const std::string &name, const std::string &file)
+{
+    return std::string(SPINE_EXAMPLES_DIR) + "/" + name + "/export/" + file;
+}
+
+size_t CountingExtension::allocations()
+{
+    return g_allocations;
+}
+
+size_t CountingExtension::allocatedBytes()
+{
+    return g_allocatedBytes;
+}
+
+void *CountingExtension::_alloc(size_t size, const char *file, int line)
+{
+    g_allocations++;
+    g_allocatedBytes += size;
+    return DefaultSpineExtension::_alloc(size, file, line);
+}
+
+void *CountingExtension::_calloc(size_t size, const char *file, int line)
+{
+    g_allocations++;
+    g_allocatedBytes += size;
+    return DefaultSpineExtension::_calloc(size, file, line);
+}
+
+void *CountingExtension::_realloc(void *ptr, size_t size, const char *file, int line)
+{
+    g_allocations++;
+    g_allocatedBytes += size;
+    return DefaultSpineExtension::_realloc(ptr, size, file, line);
+}
+
+void NullTextureLoader::load(spine::AtlasPage &page, const spine::String &path)
+{
+    SP_UNUSED(page);
+    SP_UNUSED(path);
+}
+
+void NullTextureLoader::unload(void *texture)
+{
+    SP_UNUSED(texture);
+}
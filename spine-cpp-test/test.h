@@ -0,0 +1,74 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <spine/spine.h>
+
+/**
+ * @brief Minimal test runner for the spine-cpp runtime.
+ *
+ * Tests register a name and a body, the body reports failed expectations through
+ * TEST_CHECK and keeps running, so a single run lists every broken expectation.
+ * The process exit code is the number of failed tests.
+ */
+class Test
+{
+public:
+    typedef std::function<void()> Body;
+
+    static Test& instance();
+
+    void add(const std::string& name, const Body& body);
+
+    int run(int argc, char** argv);
+
+    static void fail(const char* file, int line, const char* expression);
+
+    /**
+     * @brief examplePath Returns the path of a file exported under SpineItemTest/examples.
+     */
+    static std::string examplePath(const std::string& name, const std::string& file);
+
+private:
+    struct Case {
+        std::string name;
+        Body body;
+    };
+
+    std::vector<Case> m_cases;
+    int m_failures = 0;
+};
+
+#define TEST_CHECK(expression) \
+    do { if (!(expression)) Test::fail(__FILE__, __LINE__, #expression); } while (0)
+
+/**
+ * @brief Default extension counting every allocation of the runtime, tests compare
+ * snapshots of the counters around the code they measure.
+ */
+class CountingExtension: public spine::DefaultSpineExtension
+{
+public:
+    static size_t allocations();
+    static size_t allocatedBytes();
+
+protected:
+    virtual void* _alloc(size_t size, const char* file, int line) override;
+    virtual void* _calloc(size_t size, const char* file, int line) override;
+    virtual void* _realloc(void* ptr, size_t size, const char* file, int line) override;
+};
+
+/**
+ * @brief Atlas pages are never rendered by the tests, the loader only sizes them.
+ */
+class NullTextureLoader: public spine::TextureLoader
+{
+public:
+    virtual void load(spine::AtlasPage& page, const spine::String& path) override;
+    virtual void unload(void* texture) override;
+};
+
+#endif // TEST_H
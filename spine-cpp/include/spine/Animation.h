@@ -31,15 +31,19 @@
 #define Spine_Animation_h
 
 #include <spine/Vector.h>
-#include <spine/HashMap.h>
+#include <spine/PropertyIdSet.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 
+#include <atomic>
+
 namespace spine {
 class Timeline;
 
+class AnimationDecoder;
+
 class Skeleton;
 
 class Event;
@@ -84,6 +88,10 @@ class SP_API Animation : public SpineObject {
 public:
 	Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
+	/// Creates an animation whose timelines are read by the decoder the first time they are needed.
+	/// @param decoderIndex Identifies the animation to the decoder.
+	Animation(const String &name, float duration, AnimationDecoder &decoder, size_t decoderIndex);
+
 	~Animation();
 
 	/// Applies all the animation's timelines to the specified skeleton.
@@ -101,13 +109,22 @@ public:
 
 	void setDuration(float inValue);
 
+	/// False until the timelines of an animation read lazily are decoded.
+	bool isDecoded();
 
+	/// Decodes the timelines of an animation read lazily, see SkeletonJson::setLazyAnimations. Applying the animation,
+	/// getting its timelines and setting it on an AnimationState decode it, this can be called from any thread to prefetch
+	/// upcoming animations instead.
+	void decode();
 
 private:
 	Vector<Timeline *> _timelines;
-	HashMap<int, bool> _timelineIds;
+	PropertyIdSet _timelineIds;
 	float _duration;
 	String _name;
+	AnimationDecoder *_decoder;
+	size_t _decoderIndex;
+	std::atomic<bool> _decoded;
 
 	/// @param target After the first and before the last entry.
 	static int binarySearch(Vector<float> &values, float target, int step);
@@ -115,6 +132,11 @@ private:
 	/// @param target After the first and before the last entry.
 	static int binarySearch(Vector<float> &values, float target);
 
+	/// Like binarySearch, but first scans a few keys forward from the key found by the previous search, which is stored in
+	/// cursor. Playback moves at most a key or two per frame, so the binary search only runs after seeks and loop wraps.
+	/// @param cursor 0 before the first search. May be NULL.
+	static int search(Vector<float> &values, float target, int step, int *cursor);
+
 	static int linearSearch(Vector<float> &values, float target, int step);
 };
 }
@@ -32,6 +32,7 @@
 
 #include <spine/Vector.h>
 #include <spine/Pool.h>
+#include <spine/PropertyIdSet.h>
 #include <spine/MixBlend.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
@@ -82,6 +83,7 @@ namespace spine {
 	class SP_API TrackEntry : public SpineObject, public HasRendererObject {
 		friend class EventQueue;
 		friend class AnimationState;
+		friend class PoseCache;
 
 	public:
 		TrackEntry();
@@ -245,10 +247,12 @@ namespace spine {
 		float _animationStart, _animationEnd, _animationLast, _nextAnimationLast;
 		float _delay, _trackTime, _trackLast, _nextTrackLast, _trackEnd, _timeScale;
 		float _alpha, _mixTime, _mixDuration, _interruptAlpha, _totalAlpha;
+		float _appliedTime, _appliedMixTime, _appliedAlpha;
 		MixBlend _mixBlend;
 		Vector<int> _timelineMode;
 		Vector<TrackEntry*> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		Vector<int> _timelineCursors;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject* _listenerObject;
 
@@ -268,6 +272,7 @@ namespace spine {
 
 	class SP_API EventQueue : public SpineObject {
 		friend class AnimationState;
+		friend class PoseCache;
 
 	private:
 		Vector<EventQueueEntry> _eventQueueEntries;
@@ -302,6 +307,7 @@ namespace spine {
 	class SP_API AnimationState : public SpineObject, public HasRendererObject {
 		friend class TrackEntry;
 		friend class EventQueue;
+		friend class PoseCache;
 
 	public:
 		explicit AnimationState(AnimationStateData* data);
@@ -316,6 +322,17 @@ namespace spine {
 		/// animation state can be applied to multiple skeletons to pose them identically.
 		bool apply(Skeleton& skeleton);
 
+		/// Fires the event timelines of the current entry and updates the entry times like apply, without posing the skeleton.
+		/// For skeletons drawn from pre-rendered frames, listeners receive the same callbacks as with apply.
+		/// @return false if the state plays more than a single unmixed animation on track 0. Nothing is changed then and the
+		/// caller has to use apply.
+		bool applyEvents(Skeleton& skeleton);
+
+		/// Returns true if update and apply may pose skeletons differently than the last apply: an entry started or ended,
+		/// an entry is delayed, queued or has a track end pending, or the animation time, mix time or alpha of an entry
+		/// changed since. While this is false, renderers can keep the last pose and skip applying and drawing.
+		bool needsApply();
+
 		/// Removes all animations from all tracks, leaving skeletons in their previous pose.
 		/// It may be desired to use AnimationState.setEmptyAnimations(float) to mix the skeletons back to the setup pose,
 		/// rather than leaving them in their previous pose.
@@ -395,7 +412,7 @@ namespace spine {
 		Vector<Event*> _events;
 		EventQueue* _queue;
 
-		HashMap<int, bool> _propertyIDs;
+		PropertyIdSet _propertyIDs;
 		bool _animationsChanged;
 
 		AnimationStateListener _listener;
@@ -407,8 +424,8 @@ namespace spine {
 
 		static Animation* getEmptyAnimation();
 
-		static void applyRotateTimeline(RotateTimeline* rotateTimeline, Skeleton& skeleton, float time, float alpha, MixBlend pose, Vector<float>& timelinesRotation, size_t i, bool firstFrame);
-        void applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float animationTime, MixBlend pose, bool firstFrame);
+		static void applyRotateTimeline(RotateTimeline* rotateTimeline, Skeleton& skeleton, float time, float alpha, MixBlend pose, Vector<float>& timelinesRotation, size_t i, bool firstFrame, int* cursor);
+        void applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float animationTime, MixBlend pose, bool firstFrame, int* cursor);
 
 		/// Returns true when all mixing from entries are complete.
 		bool updateMixingFrom(TrackEntry* to, float delta);
@@ -433,7 +450,7 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
-        void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
+        void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, int attachmentNameId, bool attachments);
     };
 }
 
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ArenaExtension_h
+#define Spine_ArenaExtension_h
+
+#include <spine/Extension.h>
+
+namespace spine {
+/// Bump allocator handing out memory from large blocks, which are only released when the arena is deleted. Freeing an
+/// allocation does nothing unless it is the last one made, which makes short lived temporaries cheap.
+class SP_API Arena {
+public:
+	static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	/// @param blockSize Size of the first block. Following blocks double in size up to 64 times the first one.
+	explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+	~Arena();
+
+	void *alloc(size_t size);
+
+	/// Grows or shrinks an allocation of this arena in place when it is the last one made, otherwise copies it.
+	void *realloc(void *ptr, size_t size);
+
+	void free(void *ptr);
+
+	bool owns(const void *ptr) const;
+
+	/// The size an allocation of this arena or of an ArenaExtension was made with.
+	static size_t getSize(const void *ptr);
+
+	/// The arena an allocation of an ArenaExtension was taken from, NULL if it came from the wrapped extension.
+	static Arena *getOwner(const void *ptr);
+
+	/// Bytes handed out, including allocations which have been freed but not given back.
+	size_t getUsedMemory() const;
+
+	/// Bytes of all blocks.
+	size_t getReservedMemory() const;
+
+private:
+	struct Block {
+		Block *previous;
+		char *top;
+		char *end;
+	};
+
+	Arena(const Arena &);
+
+	Arena &operator=(const Arena &);
+
+	Block *addBlock(size_t size, bool large);
+
+	Block *_blocks;
+	size_t _blockSize;
+	size_t _usedMemory;
+	size_t _reservedMemory;
+	char *_last;
+};
+
+/// Extension that takes allocations from an Arena while a Scope is active on the calling thread and passes everything
+/// else to the wrapped extension. Scoping the construction of an Atlas and a SkeletonData puts the thousands of small
+/// objects they are made of into a few contiguous blocks:
+///
+///     Arena *arena = new Arena();
+///     {
+///         ArenaExtension::Scope scope(arena);
+///         atlas = new Atlas(atlasFile, textureLoader);
+///         skeletonData = json.readSkeletonDataFile(skeletonFile);
+///     }
+///     ...
+///     {
+///         ArenaExtension::Scope scope(arena);
+///         delete skeletonData;
+///         delete atlas;
+///     }
+///     delete arena;
+///
+/// Every allocation carries a small header naming its arena, so frees find their owner without a lookup or lock. The
+/// extension has to be installed before the runtime allocates anything, and the wrapped extension has to allocate the
+/// contents returned by _readFile through SpineExtension::alloc, like DefaultSpineExtension does. Memory of a live arena
+/// freed outside of its scope is left alone, so objects of the data may still be changed after loading; their new
+/// allocations come from the wrapped extension.
+class SP_API ArenaExtension : public SpineExtension {
+public:
+	/// Makes an arena the allocator of the calling thread until the scope ends. A NULL arena suspends the active one.
+	class SP_API Scope {
+	public:
+		explicit Scope(Arena *arena);
+
+		~Scope();
+
+	private:
+		Scope(const Scope &);
+
+		Scope &operator=(const Scope &);
+
+		Arena *_previous;
+	};
+
+	explicit ArenaExtension(SpineExtension *extension);
+
+	virtual ~ArenaExtension();
+
+	/// The arena of the calling thread, or NULL.
+	static Arena *getArena();
+
+	virtual void *_alloc(size_t size, const char *file, int line);
+
+	virtual void *_calloc(size_t size, const char *file, int line);
+
+	virtual void *_realloc(void *ptr, size_t size, const char *file, int line);
+
+	virtual void _free(void *mem, const char *file, int line);
+
+	/// Reads through the wrapped extension with the arena suspended, the file contents are freed after parsing.
+	virtual char *_readFile(const String &path, int *length);
+
+	virtual void _beforeFree(void *ptr);
+
+private:
+	SpineExtension *_extension;
+};
+}
+
+#endif /* Spine_ArenaExtension_h */
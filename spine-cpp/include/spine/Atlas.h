@@ -31,6 +31,7 @@
 #define Spine_Atlas_h
 
 #include <spine/Vector.h>
+#include <spine/HashMap.h>
 #include <spine/Extension.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
@@ -108,8 +109,7 @@ public:
 
 	void flipV();
 
-	/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-	/// should be cached rather than calling this method multiple times.
+	/// Returns the first region found with the specified name, looked up in a hash index of the region names.
 	/// @return The region, or NULL.
 	AtlasRegion *findRegion(const String &name);
 
@@ -118,6 +118,7 @@ public:
 private:
 	Vector<AtlasPage *> _pages;
 	Vector<AtlasRegion *> _regions;
+	HashMap<String, int> _regionIndices;
 	TextureLoader *_textureLoader;
 
 	void load(const char *begin, int length, const char *dir, bool createTexture);
@@ -46,13 +46,14 @@ namespace spine {
 	class SP_API AttachmentTimeline : public Timeline {
 		friend class SkeletonBinary;
 		friend class SkeletonJson;
+		friend class SkeletonData;
 
 		RTTI_DECL
 
 	public:
 		explicit AttachmentTimeline(int frameCount);
 
-		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int* cursor = NULL);
 
 		virtual int getPropertyId();
 
@@ -63,13 +64,17 @@ namespace spine {
 		void setSlotIndex(size_t inValue);
 		Vector<float>& getFrames();
 		Vector<String>& getAttachmentNames();
+		/// The ids of the attachment names in the skeleton data's skins, see Skin::getAttachment. -1 for empty names and
+		/// frames set after loading.
+		Vector<int>& getAttachmentNameIds();
 		size_t getFrameCount();
 	private:
 		size_t _slotIndex;
 		Vector<float> _frames;
 		Vector<String> _attachmentNames;
+		Vector<int> _attachmentNameIds;
 
-        void setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName);
+        void setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName, int attachmentNameId);
     };
 }
 
@@ -47,6 +47,8 @@ class Skeleton;
 class SP_API Bone : public Updatable {
 	friend class AnimationState;
 
+	friend class BoneBatch;
+
 	friend class RotateTimeline;
 
 	friend class IkConstraint;
@@ -69,6 +71,8 @@ class SP_API Bone : public Updatable {
 
 	friend class TranslateTimeline;
 
+	friend class WeightedVertices;
+
 RTTI_DECL
 
 public:
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_BoneBatch_h
+#define Spine_BoneBatch_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Bone;
+
+	class Updatable;
+
+	/// Updates the world transforms of a run of bones that follow each other in a skeleton's update cache.
+	///
+	/// No constraint runs between the bones of a run, so they are grouped by their depth within it and no bone of a level
+	/// depends on another bone of the same level. Per level the local transforms and the parent world transforms are
+	/// gathered into structure of arrays buffers and the world transforms are computed four bones at a time with SSE or
+	/// NEON, or with a scalar loop where neither is available. Root bones and bones whose transform mode is not
+	/// TransformMode_Normal are updated by Bone::updateWorldTransform. The results are the same as updating the bones one by
+	/// one in update cache order. Skeleton::updateCache creates the batches.
+	class SP_API BoneBatch : public SpineObject {
+	public:
+		/// Runs shorter than this are left to Bone::update.
+		static const size_t MIN_BONES = 8;
+
+		/// @param updateCache Every entry in [start, start + count) must be a Bone.
+		BoneBatch(Vector<Updatable *> &updateCache, size_t start, size_t count);
+
+		/// Same as calling Bone::update on every bone of the run in update cache order.
+		void update();
+
+		/// The index of the first bone of the run in the update cache.
+		size_t getStart();
+
+		/// The number of bones of the run.
+		size_t getCount();
+
+	private:
+		size_t _start;
+		/// The non root bones ordered by level.
+		Vector<Bone *> _bones;
+		/// Offsets of the levels in _bones, followed by _bones.size().
+		Vector<size_t> _levels;
+		Vector<Bone *> _roots;
+		/// Scratch for the structure of arrays of the largest level.
+		Vector<float> _buffer;
+		size_t _stride;
+	};
+}
+
+#endif /* Spine_BoneBatch_h */
@@ -43,7 +43,7 @@ namespace spine {
 
 		virtual ~CurveTimeline();
 
-		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction) = 0;
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int* cursor = NULL) = 0;
 
 		virtual int getPropertyId() = 0;
 
@@ -62,14 +62,29 @@ namespace spine {
 
 		float getCurveType(size_t frameIndex);
 
+		/// The largest error getCurvePercent may have for bezier curves set afterwards. setCurve samples each curve uniformly,
+		/// doubling the samples until interpolating linearly between them stays within the tolerance or MAX_BEZIER_SAMPLES is
+		/// reached, so a smaller tolerance trades memory for accuracy.
+		float getBezierTolerance();
+
+		void setBezierTolerance(float inValue);
+
+		static const float DEFAULT_BEZIER_TOLERANCE;
+		static const int MAX_BEZIER_SAMPLES;
+
 	protected:
 		static const float LINEAR;
 		static const float STEPPED;
 		static const float BEZIER;
-		static const int BEZIER_SIZE;
 
 	private:
-		Vector<float> _curves; // type, x, y, ...
+		/// Removes the samples of a frame from _curves, moving the samples of the frames after it down.
+		void removeCurve(size_t frameIndex);
+
+		Vector<unsigned char> _types;
+		Vector<int> _offsets; // Start of each frame's samples in _curves or -1, allocated with the first bezier curve.
+		Vector<float> _curves; // sample count n, then n + 1 values per bezier frame.
+		float _bezierTolerance;
 	};
 }
 
@@ -44,7 +44,7 @@ namespace spine {
 	public:
 		explicit DeformTimeline(int frameCount);
 
-		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int* cursor = NULL);
 
 		virtual int getPropertyId();
 
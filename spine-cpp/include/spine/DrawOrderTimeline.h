@@ -42,7 +42,7 @@ namespace spine {
 	public:
 		explicit DrawOrderTimeline(int frameCount);
 
-		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int* cursor = NULL);
 
 		virtual int getPropertyId();
 
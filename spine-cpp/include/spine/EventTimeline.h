@@ -44,7 +44,7 @@ namespace spine {
 
 		~EventTimeline();
 
-		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int* cursor = NULL);
 
 		virtual int getPropertyId();
 
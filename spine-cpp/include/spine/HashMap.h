@@ -40,6 +40,35 @@
 #endif
 
 namespace spine {
+/// Hash of a HashMap key. Integers and pointers hash to their value, other key types provide a hash() method.
+template<typename K>
+struct HashMapHash {
+	static size_t hash(const K &key) { return key.hash(); }
+};
+
+template<typename T>
+struct HashMapHash<T *> {
+	static size_t hash(T *const &key) { return (size_t) key; }
+};
+
+#define SP_HASHMAP_INTEGER_HASH(T) \
+	template<> \
+	struct HashMapHash<T> { \
+		static size_t hash(const T &key) { return (size_t) key; } \
+	};
+
+SP_HASHMAP_INTEGER_HASH(int)
+SP_HASHMAP_INTEGER_HASH(unsigned int)
+SP_HASHMAP_INTEGER_HASH(long)
+SP_HASHMAP_INTEGER_HASH(unsigned long)
+SP_HASHMAP_INTEGER_HASH(long long)
+SP_HASHMAP_INTEGER_HASH(unsigned long long)
+
+#undef SP_HASHMAP_INTEGER_HASH
+
+/// Open addressing hash map. Entries are stored contiguously in insertion order, which is also the iteration order until an
+/// entry is removed: remove moves the last entry into the removed one's place. A power of two table of entry indices is
+/// probed linearly and removal shifts the following indices back, so there are no tombstones.
 template<typename K, typename V>
 class SP_API HashMap : public SpineObject {
 private:
@@ -58,34 +87,31 @@ public:
 	public:
 		friend class HashMap;
 
-		explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-			_start.next = entry;
-			_entry = &_start;
+		explicit Entries(Entry *entries, size_t size) : _hasChecked(false), _entries(entries), _size(size), _index(0) {
 		}
 
 		Pair next() {
-			assert(_entry);
+			assert(_index < _size);
 			assert(_hasChecked);
-			_entry = _entry->next;
-			Pair pair(_entry->_key, _entry->_value);
+			Entry &entry = _entries[_index++];
+			Pair pair(entry._key, entry._value);
 			_hasChecked = false;
 			return pair;
 		}
 
 		bool hasNext() {
 			_hasChecked = true;
-			return _entry->next;
+			return _index < _size;
 		}
 
 	private:
 		bool _hasChecked;
-		Entry _start;
-		Entry *_entry;
+		Entry *_entries;
+		size_t _size;
+		size_t _index;
 	};
 
-	HashMap() :
-			_head(NULL),
-			_size(0) {
+	HashMap() {
 	}
 
 	~HashMap() {
@@ -93,66 +119,60 @@ public:
 	}
 
 	void clear() {
-		for (Entry *entry = _head; entry != NULL;) {
-			Entry* next = entry->next;
-			delete entry;
-			entry = next;
-		}
-		_head = NULL;
-		_size = 0;
+		_entries.clear();
+		for (size_t i = 0, n = _buckets.size(); i < n; i++)
+			_buckets[i] = -1;
 	}
 
 	size_t size() {
-		return _size;
+		return _entries.size();
 	}
 
 	void put(const K &key, const V &value) {
-		Entry *entry = find(key);
-		if (entry) {
-			entry->_key = key;
-			entry->_value = value;
-		} else {
-			entry = new(__FILE__, __LINE__) Entry();
-			entry->_key = key;
-			entry->_value = value;
-
-			Entry *oldHead = _head;
-
-			if (oldHead) {
-				_head = entry;
-				oldHead->prev = entry;
-				entry->next = oldHead;
-			} else {
-				_head = entry;
-			}
-			_size++;
+		size_t hash = hashOf(key);
+		int bucket = find(key, hash);
+		if (bucket != -1) {
+			Entry &entry = _entries[_buckets[bucket]];
+			entry._key = key;
+			entry._value = value;
+			return;
 		}
+
+		if ((_entries.size() + 1) * 4 > _buckets.size() * 3) rehash(_buckets.size() < 8 ? 16 : _buckets.size() << 1);
+		size_t mask = _buckets.size() - 1, i = hash & mask;
+		while (_buckets[i] != -1)
+			i = (i + 1) & mask;
+		_buckets[i] = (int) _entries.size();
+		_entries.add(Entry(key, value, hash));
 	}
 
 	bool containsKey(const K &key) {
-		return find(key) != NULL;
+		return find(key, hashOf(key)) != -1;
 	}
 
 	bool remove(const K &key) {
-		Entry *entry = find(key);
-		if (!entry) return false;
-
-		Entry *prev = entry->prev;
-		Entry *next = entry->next;
-
-		if (prev) prev->next = next;
-		else _head = next;
-		if (next) next->prev = entry->prev;
-
-		delete entry;
-		_size--;
-
+		int bucket = find(key, hashOf(key));
+		if (bucket == -1) return false;
+
+		int index = _buckets[bucket];
+		removeBucket((size_t) bucket);
+
+		// Move the last entry into the hole and point its bucket at the new position.
+		int last = (int) _entries.size() - 1;
+		if (index != last) {
+			size_t mask = _buckets.size() - 1, i = _entries[last]._hash & mask;
+			while (_buckets[i] != last)
+				i = (i + 1) & mask;
+			_buckets[i] = index;
+			_entries[index] = _entries[last];
+		}
+		_entries.removeAt(last);
 		return true;
 	}
 
 	V operator[](const K &key) {
-		Entry *entry = find(key);
-		if (entry) return entry->_value;
+		int bucket = find(key, hashOf(key));
+		if (bucket != -1) return _entries[_buckets[bucket]]._value;
 		else {
 			assert(false);
 			return 0;
@@ -160,30 +180,68 @@ public:
 	}
 
 	Entries getEntries() const {
-		return Entries(_head);
+		return Entries(const_cast<Vector<Entry> &>(_entries).buffer(), _entries.size());
 	}
 
 private:
-	Entry *find(const K &key) {
-		for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-			if (entry->_key == key)
-				return entry;
-		}
-		return NULL;
-	}
-
-	class SP_API Entry : public SpineObject {
+	class SP_API Entry {
 	public:
 		K _key;
 		V _value;
-		Entry *next;
-		Entry *prev;
+		size_t _hash;
 
-		Entry() : next(NULL), prev(NULL) {}
+		Entry(const K &key, const V &value, size_t hash) : _key(key), _value(value), _hash(hash) {}
 	};
 
-	Entry *_head;
-	size_t _size;
+	static size_t hashOf(const K &key) {
+		// Mix the high bits into the low ones, the table is indexed by the low bits and pointers are aligned.
+		size_t hash = HashMapHash<K>::hash(key);
+		hash ^= (hash >> 16) >> 16;
+		hash ^= hash >> 16;
+		hash *= 0x45d9f3b;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+	/// Returns the bucket holding the entry for key, or -1.
+	int find(const K &key, size_t hash) {
+		if (_entries.size() == 0) return -1;
+		size_t mask = _buckets.size() - 1;
+		for (size_t i = hash & mask;; i = (i + 1) & mask) {
+			int index = _buckets[i];
+			if (index == -1) return -1;
+			Entry &entry = _entries[index];
+			if (entry._hash == hash && entry._key == key) return (int) i;
+		}
+	}
+
+	void removeBucket(size_t i) {
+		// Shift back the following entries of the probe run which would no longer be reachable past the hole.
+		size_t mask = _buckets.size() - 1;
+		for (size_t j = (i + 1) & mask; _buckets[j] != -1; j = (j + 1) & mask) {
+			size_t home = _entries[_buckets[j]]._hash & mask;
+			if (((j - home) & mask) >= ((j - i) & mask)) {
+				_buckets[i] = _buckets[j];
+				i = j;
+			}
+		}
+		_buckets[i] = -1;
+	}
+
+	void rehash(size_t bucketCount) {
+		_buckets.clear();
+		_buckets.setSize(bucketCount, -1);
+		size_t mask = bucketCount - 1;
+		for (size_t e = 0, n = _entries.size(); e < n; e++) {
+			size_t i = _entries[e]._hash & mask;
+			while (_buckets[i] != -1)
+				i = (i + 1) & mask;
+			_buckets[i] = (int) e;
+		}
+	}
+
+	Vector<Entry> _entries;
+	Vector<int> _buckets;
 };
 }
 
@@ -51,7 +51,8 @@ public:
 	static const int JSON_ARRAY;
 	static const int JSON_OBJECT;
 
-	/* Get item "string" from object. Case insensitive. */
+	/* Get item "string" from object. Exact matches are searched from the item after the previous match, so keys read in the
+	 * order they were written are found with one comparison. Falls back to a case insensitive search. */
 	static Json *getItem(Json *object, const char *string);
 
 	static const char *getString(Json *object, const char *name, const char *defaultValue);
@@ -65,12 +66,14 @@ public:
 	/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
 	static const char *getError();
 
-	/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
+	/* Supply a block of JSON, and this returns a Json object you can interrogate. The text is copied and parsed in situ. */
 	explicit Json(const char *value);
 
-	~Json();
-
+	/* With inSitu the text is parsed without a copy: strings are unescaped into it and referenced from the items, so it must
+	 * outlive this Json. */
+	Json(char *value, bool inSitu);
 
+	~Json();
 
 private:
 	static const char *_error;
@@ -80,6 +83,7 @@ private:
 	Json* _prev; /* next/prev allow you to walk array/object chains. Alternatively, use getSize/getItem */
 #endif
 	Json *_child; /* An array or object item will have a child pointer pointing to a chain of the items in the array/object. */
+	Json *_cursor; /* The last item found by getItem. */
 
 	int _type; /* The type of the item, as above. */
 	int _size; /* The number of children. */
@@ -90,23 +94,41 @@ private:
 
 	const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
 
+	/* Only set on the root: the copied text, and the blocks all other items are allocated from. */
+	char *_buffer;
+	char *_blocks;
+	int _blockItems;
+
+	Json();
+
+	/* Copies the text into _buffer. */
+	char *copy(const char *value);
+
+	void parse(char *value);
+
+	/* Allocates an item from the blocks of the root. */
+	Json *newItem();
+
 	/* Utility to jump whitespace and cr/lf */
-	static const char *skip(const char *inValue);
+	static char *skip(char *inValue);
+
+	/* Moves past the value starting at the text without parsing it. Returns NULL for unterminated text. */
+	static char *skipValue(char *value);
 
 	/* Parser core - when encountering text, process appropriately. */
-	static const char *parseValue(Json *item, const char *value);
+	char *parseValue(Json *item, char *value);
 
-	/* Parse the input text into an unescaped cstring, and populate item. */
-	static const char *parseString(Json *item, const char *str);
+	/* Unescape the string in place, and populate item. */
+	static char *parseString(Json *item, char *str);
 
 	/* Parse the input text to generate a number, and populate the result into item. */
-	static const char *parseNumber(Json *item, const char *num);
+	static char *parseNumber(Json *item, char *num);
 
 	/* Build an array from input text. */
-	static const char *parseArray(Json *item, const char *value);
+	char *parseArray(Json *item, char *value);
 
 	/* Build an object from the text. */
-	static const char *parseObject(Json *item, const char *value);
+	char *parseObject(Json *item, char *value);
 
 	static int json_strcasecmp(const char *s1, const char *s2);
 };
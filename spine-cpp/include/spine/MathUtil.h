@@ -31,6 +31,7 @@
 #define Spine_MathUtil_h
 
 #include <spine/SpineObject.h>
+#include <spine/Trigonometry.h>
 
 #include <string.h>
 
@@ -58,20 +59,46 @@ public:
 
 	static float abs(float v);
 
-	/// Returns the sine in radians from a lookup table.
+	/// Selects the implementation of sin, cos, sinDeg, cosDeg, sincos, sincosDeg and atan2 for all skeletons. Defaults to
+	/// Trigonometry_Precise. Not thread safe, set it before skeletons are updated.
+	static void setTrigonometry(Trigonometry inValue);
+
+	static Trigonometry getTrigonometry();
+
+	/// Returns the sine in radians.
 	static float sin(float radians);
 
-	/// Returns the cosine in radians from a lookup table.
+	/// Returns the cosine in radians.
 	static float cos(float radians);
 
-	/// Returns the sine in radians from a lookup table.
+	/// Returns the sine in degrees.
 	static float sinDeg(float degrees);
 
-	/// Returns the cosine in radians from a lookup table.
+	/// Returns the cosine in degrees.
 	static float cosDeg(float degrees);
 
-	/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-	/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+	/// Computes the sine and cosine in radians, sharing the range reduction of both. The polynomial is inlined.
+	static inline void sincos(float radians, float &outSin, float &outCos) {
+		if (_trigonometry != Trigonometry_Polynomial) {
+			sincosLibraryOrTable(radians, outSin, outCos);
+			return;
+		}
+		int q = quadrant(radians * 0.63661977236758134f);
+		float r = ((radians - q * 1.5703125f) - q * 4.837512969970703125e-4f) - q * 7.54978995489188216e-8f;
+		polynomialSinCos(r, q, outSin, outCos);
+	}
+
+	/// Computes the sine and cosine in degrees, sharing the range reduction of both. The polynomial is inlined.
+	static inline void sincosDeg(float degrees, float &outSin, float &outCos) {
+		if (_trigonometry != Trigonometry_Polynomial) {
+			sincosDegLibraryOrTable(degrees, outSin, outCos);
+			return;
+		}
+		int q = quadrant(degrees * (1 / 90.0f));
+		polynomialSinCos((degrees - q * 90.0f) * 0.017453292519943295f, q, outSin, outCos);
+	}
+
+	/// Returns atan2 in radians, see Trigonometry for the error of the approximations.
 	static float atan2(float y, float x);
 
 	static float acos(float v);
@@ -89,6 +116,30 @@ public:
 	static float randomTriangular(float min, float max, float mode);
 
 	static float pow(float a, float b);
+
+private:
+	static Trigonometry _trigonometry;
+
+	static void sincosLibraryOrTable(float radians, float &outSin, float &outCos);
+
+	static void sincosDegLibraryOrTable(float degrees, float &outSin, float &outCos);
+
+	/// Rounds half away from zero, the nearest whole number of quarter turns.
+	static inline int quadrant(float quarters) {
+		return (int) (quarters + (quarters < 0 ? -0.5f : 0.5f));
+	}
+
+	/// r is the angle within [-Pi / 4, Pi / 4] left after removing quadrant quarter turns (Cody and Waite, Pi / 2 split in
+	/// parts whose multiples are exact). Minimax polynomials of Cephes sinf and cosf.
+	static inline void polynomialSinCos(float r, int quadrant, float &outSin, float &outCos) {
+		float z = r * r;
+		float s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+		float c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1;
+		bool swap = (quadrant & 1) != 0;
+		float sine = swap ? c : s, cosine = swap ? s : c;
+		outSin = (quadrant & 2) ? -sine : sine;
+		outCos = ((quadrant + 1) & 2) ? -cosine : cosine;
+	}
 };
 
 struct SP_API Interpolation {
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_NameIndex_h
+#define Spine_NameIndex_h
+
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	/// Name to index map over a vector of named items, for find methods which would otherwise compare the name of every
+	/// item. Items are indexed lazily as they are appended, up to the first NULL item, so vectors which are sized first and
+	/// filled in place while loading are indexed as they fill. Lookups give the same result as
+	/// ContainerUtil::findIndexWithName: the first item with the name.
+	template<typename T>
+	class SP_API NameIndex : public SpineObject {
+	public:
+		NameIndex() : _indexed(0) {
+		}
+
+		/// @return -1 if the item was not found.
+		int find(Vector<T *> &items, const String &name) {
+			assert(name.length() > 0);
+
+			update(items);
+			if (_indices.containsKey(name)) {
+				int index = _indices[name];
+				if (items[index] != NULL && items[index]->getName() == name) return index;
+
+				// An item was replaced in place.
+				clear();
+				update(items);
+				if (_indices.containsKey(name)) return _indices[name];
+			}
+
+			for (size_t i = _indexed, n = items.size(); i < n; ++i) {
+				T *item = items[i];
+				if (item != NULL && item->getName() == name) return static_cast<int>(i);
+			}
+			return -1;
+		}
+
+		void clear() {
+			_indices.clear();
+			_indexed = 0;
+		}
+
+		/// Indexes the items appended since the last call.
+		void update(Vector<T *> &items) {
+			if (items.size() < _indexed) clear();
+			for (size_t n = items.size(); _indexed < n && items[_indexed] != NULL; ++_indexed) {
+				const String &name = items[_indexed]->getName();
+				if (!_indices.containsKey(name)) _indices.put(name, static_cast<int>(_indexed));
+			}
+		}
+
+	private:
+		HashMap<String, int> _indices;
+		size_t _indexed;
+	};
+}
+
+#endif /* Spine_NameIndex_h */
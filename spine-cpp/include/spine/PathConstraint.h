@@ -78,6 +78,17 @@ namespace spine {
 
 		PathConstraintData& getData();
 
+		/// The largest error of the curve lengths that place bones along constant speed paths. 0, the default, divides every
+		/// curve into 10 segments like the editor does. A larger tolerance divides each curve adaptively, doubling its
+		/// segments from 4 up to MAX_ARC_LENGTH_SEGMENTS until its length changes by less than the tolerance, so straight
+		/// curves take fewer samples and tight ones more. Either way the tables are kept until the path's world vertices
+		/// change.
+		float getArcLengthTolerance();
+
+		void setArcLengthTolerance(float inValue);
+
+		static const int MAX_ARC_LENGTH_SEGMENTS;
+
 		bool isActive();
 
 		void setActive(bool inValue);
@@ -87,6 +98,8 @@ namespace spine {
 		static const int NONE;
 		static const int BEFORE;
 		static const int AFTER;
+		static const int SEGMENTS;
+		static const int MIN_ARC_LENGTH_SEGMENTS;
 
 		PathConstraintData& _data;
 		Vector<Bone*> _bones;
@@ -98,12 +111,25 @@ namespace spine {
 		Vector<float> _world;
 		Vector<float> _curves;
 		Vector<float> _lengths;
-		Vector<float> _segments;
+		Vector<float> _segments; // _segmentStride samples per curve, cumulative within the curve.
+		Vector<int> _segmentCounts; // Samples of each curve in _segments, 0 until they are computed.
+		int _segmentStride;
+		float _arcLengthTolerance;
+		PathAttachment* _arcLengthPath; // Path and world vertices _curves and _segments belong to.
+		Vector<float> _arcLengthWorld;
 
 		bool _active;
 
 		Vector<float>& computeWorldPositions(PathAttachment& path, int spacesCount, bool tangents, bool percentPosition, bool percentSpacing);
 
+		void computeArcLengths(PathAttachment& path, int curveCount);
+
+		float* getSegments(int curve, int& count);
+
+		static void computeSegments(float x1, float y1, float cx1, float cy1, float cx2, float cy2, float x2, float y2, int count, float* segments);
+
+		static int search(const float* lengths, int from, int to, float p);
+
 		static void addBeforePosition(float p, Vector<float>& temp, int i, Vector<float>& output, int o);
 
 		static void addAfterPosition(float p, Vector<float>& temp, int i, Vector<float>& output, int o);
@@ -60,10 +60,12 @@ public:
 		}
 	}
 
+	/// Returns the object to the free list in constant time. The free list keeps its capacity, so once the pool has grown
+	/// to the number of objects in use, obtaining and freeing does not allocate. An object must not be freed twice, the
+	/// free list is only searched for it in debug builds.
 	void free(T *object) {
-		if (!_objects.contains(object)) {
-			_objects.add(object);
-		}
+		assert(!_objects.contains(object));
+		_objects.add(object);
 	}
 
 private:
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_PoseCache_h
+#define Spine_PoseCache_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class AnimationState;
+	class Skeleton;
+	class Animation;
+
+	/// Shares pre-sampled poses of an animation between skeletons playing it without mixing.
+	///
+	/// For every (SkeletonData, Animation, Skin, fps, skeleton scale) a table of world transforms (a, b, c, d, worldX,
+	/// worldY per bone), slot attachments, slot colors, deform vertices and draw order is sampled once at a fixed rate.
+	/// Skeletons playing that animation alone on track 0 are then posed by interpolating between the two nearest samples,
+	/// which replaces both AnimationState::apply and Skeleton::updateWorldTransform. Tables are evicted least recently used
+	/// first once the cache exceeds its byte budget.
+	///
+	/// Samples are baked from the setup pose, so local bone values (x, y, rotation, ...) are not updated and bones changed
+	/// by the application before applying are overwritten. Event timelines still fire and listeners receive the same start,
+	/// complete and end callbacks as with AnimationState::apply. Like the rest of the runtime the cache is not thread safe.
+	class SP_API PoseCache : public SpineObject {
+	public:
+		explicit PoseCache(size_t maxBytes = 16 * 1024 * 1024, int fps = 30);
+
+		~PoseCache();
+
+		/// Poses the skeleton from the baked table and updates the track entry bookkeeping of the state.
+		/// @return false if the state plays more than a single unmixed animation on track 0. Nothing is changed then and the
+		/// caller has to use AnimationState::apply and Skeleton::updateWorldTransform.
+		bool apply(AnimationState& state, Skeleton& skeleton);
+
+		/// Removes all baked tables.
+		void clear();
+
+		/// The number of bytes held by baked tables, may exceed the budget only while a single table is larger than it.
+		size_t getUsedBytes();
+
+		size_t getMaxBytes();
+		void setMaxBytes(size_t inValue);
+
+		/// The sample rate of newly baked tables, tables baked at other rates are no longer used and get evicted.
+		int getFps();
+		void setFps(int inValue);
+
+	private:
+		class BakedPose;
+
+		Vector<BakedPose*> _poses;
+		size_t _usedBytes;
+		size_t _maxBytes;
+		size_t _useCount;
+		int _fps;
+
+		BakedPose* getPose(Skeleton& skeleton, Animation& animation);
+
+		void evict(BakedPose* keep);
+	};
+}
+
+#endif /* Spine_PoseCache_h */
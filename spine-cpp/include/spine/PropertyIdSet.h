@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_PropertyIdSet_h
+#define Spine_PropertyIdSet_h
+
+#include <spine/Vector.h>
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	/// Set of timeline property IDs (see Timeline::getPropertyId). IDs are a timeline type in the high byte and a bone, slot or
+	/// constraint index in the low bytes, so they are kept in a bitset indexed by index * TYPE_BITS + type and membership is
+	/// a single bit test. Deform IDs add an attachment ID that is not dense, they and any ID with an index past
+	/// DENSE_INDICES go to a hash set instead, so the bitset stays small.
+	class SP_API PropertyIdSet : public SpineObject {
+	public:
+		PropertyIdSet();
+
+		/// Returns false if the ID was already in the set.
+		bool add(int id);
+
+		bool contains(int id);
+
+		/// Removes all IDs but keeps the storage.
+		void clear();
+
+	private:
+		static bool isSparse(int id);
+
+		static const int TYPE_BITS;
+		static const int DENSE_INDICES;
+
+		Vector<unsigned int> _bits;
+		HashMap<int, bool> _sparse;
+	};
+}
+
+#endif /* Spine_PropertyIdSet_h */
@@ -41,6 +41,8 @@ class SkeletonData;
 
 class Bone;
 
+class BoneBatch;
+
 class Updatable;
 
 class Slot;
@@ -142,6 +144,10 @@ public:
 	/// @return May be NULL.
 	Attachment *getAttachment(int slotIndex, const String &attachmentName);
 
+	/// Looks the attachment up by its interned name id first, see Skin::getAttachment(size_t, int, const String&).
+	/// @return May be NULL.
+	Attachment *getAttachment(int slotIndex, int attachmentNameId, const String &attachmentName);
+
 	/// @param attachmentName May be empty.
 	void setAttachment(const String &slotName, const String &attachmentName);
 
@@ -170,6 +176,7 @@ public:
 
 	Vector<Bone *> &getBones();
 
+	/// Bones are updated one by one instead of in batches until the next updateCache, as the list may be changed.
 	Vector<Updatable *> &getUpdateCacheList();
 
 	Vector<Slot *> &getSlots();
@@ -223,6 +230,7 @@ private:
 	float _time;
 	float _scaleX, _scaleY;
 	float _x, _y;
+	Vector<BoneBatch *> _boneBatches;
 
 	void sortIkConstraint(IkConstraint *constraint);
 
@@ -236,6 +244,8 @@ private:
 
 	void sortBone(Bone *bone);
 
+	void batchBones();
+
 	static void sortReset(Vector<Bone *> &bones);
 };
 }
@@ -46,6 +46,8 @@ namespace spine {
 	class VertexAttachment;
 	class Animation;
 	class CurveTimeline;
+	class ThreadPool;
+	class Timeline;
 
 	class SP_API SkeletonBinary : public SpineObject {
 	public:
@@ -78,28 +80,65 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// The largest error of the bezier curves of the read animations, see CurveTimeline::setBezierTolerance.
+		void setBezierTolerance(float bezierTolerance) { _bezierTolerance = bezierTolerance; }
+
+		/// Reads the animations on the threads of the pool once bones, slots, constraints, skins and events are read. NULL,
+		/// the default, reads everything on the calling thread.
+		void setThreadPool(ThreadPool* threadPool) { _threadPool = threadPool; }
+
+		/// Only reads the names and durations of the animations. The bytes of the animations are kept by the skeleton data
+		/// and their timelines are read the first time an animation is needed, see Animation::decode. Errors in the
+		/// animations then leave them without timelines instead of failing the read. False by default.
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
 		String& getError() { return _error; }
 
 	private:
+		/// Reads over the caller's bytes without copying them. Reads past the end return zeros and mark the input truncated.
+		/// An index out of range also marks it truncated, so the reading stops the same way.
 		struct DataInput : public SpineObject {
 			const unsigned char* cursor;
 			const unsigned char* end;
+			bool truncated;
+			bool invalidIndex;
+
+			DataInput() : cursor(NULL), end(NULL), truncated(false), invalidIndex(false) {}
 		};
 
+		class ReadAnimationsTask;
+
+		class LazyAnimations;
+
 		AttachmentLoader* _attachmentLoader;
 		Vector<LinkedMesh*> _linkedMeshes;
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		float _bezierTolerance;
+		ThreadPool* _threadPool;
+		bool _lazyAnimations;
+
+		/// Reads the timelines of lazily read animations, which needs no attachment loader.
+		SkeletonBinary(float scale, float bezierTolerance);
 
 		void setError(const char* value1, const char* value2);
 
+		/// Returns the next count bytes, or NULL if fewer are left.
+		const unsigned char* readBytes(DataInput* input, size_t count);
+
 		char* readString(DataInput* input);
 
+		/// Reads the string table into one allocation the strings of the skeleton data point into.
+		void readStrings(DataInput* input, int count, SkeletonData* skeletonData);
+
 		char* readStringRef(DataInput* input, SkeletonData* skeletonData);
 
 		float readFloat(DataInput* input);
 
+		/// Decodes count big endian floats after checking the bounds once.
+		void readFloats(DataInput* input, float* values, size_t count, float scale);
+
 		unsigned char readByte(DataInput* input);
 
 		signed char readSByte(DataInput* input);
@@ -112,11 +151,21 @@ namespace spine {
 
 		int readVarint(DataInput* input, bool optimizePositive);
 
+		/// Reads an index below count. Returns -1 and marks the input truncated if it is out of range.
+		int readIndex(DataInput* input, size_t count);
+
+		/// Returns the item at the next index, or NULL if the index is out of range.
+		template<typename T>
+		T* readReference(DataInput* input, Vector<T*>& items);
+
+		/// Moves to the end of the input and marks it truncated because of an invalid index.
+		void setInvalidIndex(DataInput* input);
+
 		Skin* readSkin(DataInput* input, bool defaultSkin, SkeletonData* skeletonData, bool nonessential);
 
 		Attachment* readAttachment(DataInput* input, Skin* skin, int slotIndex, const String& attachmentName, SkeletonData* skeletonData, bool nonessential);
 
-		void readVertices(DataInput* input, VertexAttachment* attachment, int vertexCount);
+		void readVertices(DataInput* input, VertexAttachment* attachment, int vertexCount, SkeletonData* skeletonData);
 
 		void readFloatArray(DataInput *input, int n, float scale, Vector<float>& array);
 
@@ -124,7 +173,28 @@ namespace spine {
 
 		Animation* readAnimation(const String& name, DataInput* input, SkeletonData *skeletonData);
 
+		/// Returns false if the animation could not be read.
+		bool readTimelines(DataInput* input, SkeletonData* skeletonData, Vector<Timeline*>& timelines, float& duration);
+
 		void readCurve(DataInput* input, int frameIndex, CurveTimeline* timeline);
+
+		/// Reads the animations on the thread pool. Returns false if one of them failed.
+		bool readAnimations(DataInput* input, int animationsCount, SkeletonData* skeletonData);
+
+		/// Creates the animations without timelines and keeps their bytes in a LazyAnimations decoder. Returns false if one
+		/// of them is invalid.
+		bool readLazyAnimations(DataInput* input, int animationsCount, SkeletonData* skeletonData);
+
+		/// Moves past an animation without creating its timelines. Returns false for an invalid timeline type.
+		/// @param duration Raised to the time of the last frame of every timeline.
+		bool skipAnimation(DataInput* input, SkeletonData* skeletonData, float& duration);
+
+		void skipString(DataInput* input);
+
+		/// Skips frames of frameSize bytes, each but the last followed by a curve.
+		void skipFrames(DataInput* input, int frameCount, int frameSize, float& duration);
+
+		void skipCurve(DataInput* input);
 	};
 }
 
@@ -32,6 +32,8 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
+#include <spine/HashMap.h>
+#include <spine/NameIndex.h>
 
 namespace spine {
 class BoneData;
@@ -50,6 +52,10 @@ class TransformConstraintData;
 
 class PathConstraintData;
 
+class AnimationDecoder;
+
+class Timeline;
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 class SP_API SkeletonData : public SpineObject {
 	friend class SkeletonBinary;
@@ -58,13 +64,14 @@ class SP_API SkeletonData : public SpineObject {
 
 	friend class Skeleton;
 
+	friend class AnimationStateData;
+
 public:
 	SkeletonData();
 
 	~SkeletonData();
 
-	/// Finds a bone by comparing each bone's name.
-	/// It is more efficient to cache the results of this method than to call it multiple times.
+	/// Finds a bone by name. The find methods look names up in hash indices which are built lazily as the items are added.
 	/// @return May be NULL.
 	BoneData *findBone(const String &boneName);
 
@@ -83,6 +90,7 @@ public:
 	/// @return May be NULL.
 	spine::EventData *findEvent(const String &eventDataName);
 
+	/// Decodes the animation if it was read lazily, see Animation::decode.
 	/// @return May be NULL.
 	Animation *findAnimation(const String &animationName);
 
@@ -166,6 +174,18 @@ public:
 	void setFps(float inValue);
 
 private:
+	/// Gives every attachment name of the skins, the slot setup poses and the attachment timelines an id, so attachments
+	/// are resolved without comparing names, and completes the name indices. Called by the loaders once everything is read.
+	void internAttachmentNames();
+
+	/// Interns the attachment names of the attachment timelines of an animation decoded after loading.
+	void internAttachmentNames(Vector<Timeline *> &timelines);
+
+	/// Indexes the names of all items read so far, so data shared between threads is only read by the find methods.
+	void updateNameIndices();
+
+	int internAttachmentName(const String &name);
+
 	String _name;
 	Vector<BoneData *> _bones; // Ordered parents first
 	Vector<SlotData *> _slots; // Setup pose draw order.
@@ -179,12 +199,33 @@ private:
 	float _x, _y, _width, _height;
 	String _version;
 	String _hash;
-	Vector<char*> _strings;
+	Vector<char*> _strings; // Point into _stringData.
+	char *_stringData;
 
 	// Nonessential.
 	float _fps;
 	String _imagesPath;
 	String _audioPath;
+
+	HashMap<String, int> _attachmentNameIds;
+
+	/// Set when the animations are read lazily.
+	AnimationDecoder *_animationDecoder;
+
+	NameIndex<BoneData> _boneIndex;
+	NameIndex<SlotData> _slotIndex;
+	NameIndex<Skin> _skinIndex;
+	NameIndex<EventData> _eventIndex;
+	NameIndex<Animation> _animationIndex;
+	NameIndex<IkConstraintData> _ikConstraintIndex;
+	NameIndex<TransformConstraintData> _transformConstraintIndex;
+	NameIndex<PathConstraintData> _pathConstraintIndex;
+
+	template<typename T>
+	static T *findWithIndex(Vector<T *> &items, NameIndex<T> &index, const String &name) {
+		int i = index.find(items, name);
+		return i == -1 ? NULL : items[i];
+	}
 };
 }
 
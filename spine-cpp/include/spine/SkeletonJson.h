@@ -53,6 +53,10 @@ class LinkedMesh;
 
 class String;
 
+class ThreadPool;
+
+class Timeline;
+
 class SP_API SkeletonJson : public SpineObject {
 public:
 	explicit SkeletonJson(Atlas *atlas);
@@ -67,21 +71,56 @@ public:
 
 	void setScale(float scale) { _scale = scale; }
 
+	/// The largest error of the bezier curves of the read animations, see CurveTimeline::setBezierTolerance.
+	void setBezierTolerance(float bezierTolerance) { _bezierTolerance = bezierTolerance; }
+
+	/// Reads the animations on the threads of the pool once bones, slots, constraints, skins and events are read. NULL, the
+	/// default, reads everything on the calling thread.
+	void setThreadPool(ThreadPool *threadPool) { _threadPool = threadPool; }
+
+	/// Only reads the names and durations of the animations. The text of the animations is kept by the skeleton data and
+	/// their timelines are read the first time an animation is needed, see Animation::decode. Errors in the animations then
+	/// leave them without timelines instead of failing the read. False by default.
+	void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
 	String &getError() { return _error; }
 
 private:
+	class ReadAnimationsTask;
+
+	class LazyAnimations;
+
 	AttachmentLoader *_attachmentLoader;
 	Vector<LinkedMesh *> _linkedMeshes;
 	float _scale;
 	const bool _ownsLoader;
+	float _bezierTolerance;
+	ThreadPool *_threadPool;
+	bool _lazyAnimations;
 	String _error;
 
+	/// Reads the timelines of lazily read animations, which needs no attachment loader.
+	SkeletonJson(float scale, float bezierTolerance);
+
 	static float toColor(const char *value, size_t index);
 
-	static void readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex);
+	/// Reads the skeleton data from text which is parsed in situ.
+	SkeletonData *readJsonInSitu(char *json);
+
+	/// Reads the skeleton data from a parsed document and deletes it.
+	/// @param lazyAnimations Holds the animations cut out of the document, or NULL.
+	SkeletonData *readJson(Json *root, LazyAnimations *lazyAnimations);
+
+	void readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex);
 
 	Animation *readAnimation(Json *root, SkeletonData *skeletonData);
 
+	/// Returns false if the animation could not be read.
+	bool readTimelines(Json *root, SkeletonData *skeletonData, Vector<Timeline *> &timelines, float &duration);
+
+	/// Reads the animations on the thread pool. Returns false if one of them failed.
+	bool readAnimations(Json *animations, SkeletonData *skeletonData);
+
 	void readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength);
 
 	void setError(Json *root, const String &value1, const String &value2);
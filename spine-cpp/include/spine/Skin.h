@@ -55,11 +55,13 @@ public:
 			size_t _slotIndex;
 			String _name;
 			Attachment *_attachment;
+			int _nameId;
 
-			Entry(size_t slotIndex, const String &name, Attachment *attachment) :
+			Entry(size_t slotIndex, const String &name, Attachment *attachment, int nameId = -1) :
 					_slotIndex(slotIndex),
 					_name(name),
-					_attachment(attachment) {
+					_attachment(attachment),
+					_nameId(nameId) {
 			}
 		};
 
@@ -95,10 +97,12 @@ public:
 			size_t _bucketIndex;
 		};
 
-		void put(size_t slotIndex, const String &attachmentName, Attachment *attachment);
+		void put(size_t slotIndex, const String &attachmentName, Attachment *attachment, int nameId = -1);
 
 		Attachment *get(size_t slotIndex, const String &attachmentName);
 
+		Attachment *get(size_t slotIndex, int nameId, const String &attachmentName);
+
 		void remove(size_t slotIndex, const String &attachmentName);
 
 		Entries getEntries();
@@ -124,6 +128,12 @@ public:
 	/// Returns the attachment for the specified slot index and name, or NULL.
 	Attachment *getAttachment(size_t slotIndex, const String &name);
 
+	/// Like getAttachment(size_t, const String&), but compares the id the skeleton data interned the name to at load instead
+	/// of the characters. Entries added after loading have no id and are still found by name.
+	/// @param nameId The id from SlotData::getAttachmentNameId or AttachmentTimeline::getAttachmentNameIds of the same
+	/// skeleton data, or -1.
+	Attachment *getAttachment(size_t slotIndex, int nameId, const String &name);
+
 	// Removes the attachment from the skin.
 	void removeAttachment(size_t slotIndex, const String& name);
 
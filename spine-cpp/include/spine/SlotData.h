@@ -43,6 +43,8 @@ class SP_API SlotData : public SpineObject {
 
 	friend class SkeletonJson;
 
+	friend class SkeletonData;
+
 	friend class AttachmentTimeline;
 
 	friend class ColorTimeline;
@@ -93,6 +95,10 @@ public:
 
 	void setAttachmentName(const String &inValue);
 
+	/// The id of the attachment name in the skeleton data's skins, see Skin::getAttachment. -1 if the name is empty or was
+	/// set after loading.
+	int getAttachmentNameId();
+
 	BlendMode getBlendMode();
 
 	void setBlendMode(BlendMode inValue);
@@ -106,6 +112,7 @@ private:
 
 	bool _hasDarkColor;
 	String _attachmentName;
+	int _attachmentNameId;
 	BlendMode _blendMode;
 };
 }
@@ -196,6 +196,14 @@ public:
 		return !(a == b);
 	}
 
+	/// FNV-1a hash of the characters, for HashMap keys.
+	size_t hash() const {
+		size_t hash = 2166136261u;
+		for (size_t i = 0; i < _length; i++)
+			hash = (hash ^ (unsigned char) _buffer[i]) * 16777619u;
+		return hash;
+	}
+
 	~String() {
 		if (_buffer) {
 			SpineExtension::free(_buffer, __FILE__, __LINE__);
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ThreadPool_h
+#define Spine_ThreadPool_h
+
+#include <spine/SpineObject.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spine {
+	/// Worker threads which run the indices of a task concurrently. The loaders use it to read animations in parallel, see
+	/// SkeletonJson::setThreadPool and SkeletonBinary::setThreadPool.
+	class SP_API ThreadPool : public SpineObject {
+	public:
+		class SP_API Task {
+		public:
+			virtual ~Task();
+
+			/// Called once for every index, on any of the threads.
+			virtual void run(size_t index) = 0;
+		};
+
+		/// @param threadCount The threads running a task, including the caller of run. 0 uses one per hardware thread.
+		explicit ThreadPool(int threadCount = 0);
+
+		~ThreadPool();
+
+		int getThreadCount();
+
+		/// Runs the task for every index below count and returns when all have finished. Concurrent calls are serialized.
+		void run(Task &task, size_t count);
+
+	private:
+		ThreadPool(const ThreadPool &);
+
+		ThreadPool &operator=(const ThreadPool &);
+
+		void work();
+
+		void runIndices(Task &task, size_t count);
+
+		std::vector<std::thread> _workers;
+		std::mutex _runMutex;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		Task *_task;
+		size_t _count;
+		std::atomic<size_t> _next;
+		size_t _active;
+		unsigned int _generation;
+		bool _stop;
+	};
+}
+
+#endif /* Spine_ThreadPool_h */
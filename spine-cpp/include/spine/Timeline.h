@@ -59,9 +59,10 @@ public:
 	///	time, an animation can be mixed in or out. alpha can also be useful to apply animations on top of each other (layered).
 	/// @param blend Controls how mixing is applied when alpha is than 1.
 	/// @param direction Indicates whether the timeline is mixing in or out. Used by timelines which perform instant transitions such as DrawOrderTimeline and AttachmentTimeline.
+	/// @param cursor Keyframe hint owned by the caller, see Animation::search. Keep one per timeline and apply the timeline with it at monotonic times for the hint to pay off. May be NULL.
 	virtual void
 	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
-		MixDirection direction) = 0;
+		MixDirection direction, int *cursor = NULL) = 0;
 
 	virtual int getPropertyId() = 0;
 };
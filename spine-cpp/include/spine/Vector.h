@@ -164,6 +164,12 @@ public:
 		return _buffer[inIndex];
 	}
 
+	inline const T &operator[](size_t inIndex) const {
+		assert(inIndex < _size);
+
+		return _buffer[inIndex];
+	}
+
 	inline friend bool operator==(Vector<T> &lhs, Vector<T> &rhs) {
 		if (lhs.size() != rhs.size()) {
 			return false;
@@ -186,6 +192,10 @@ public:
 		return _buffer;
 	}
 
+	inline const T *buffer() const {
+		return _buffer;
+	}
+
 private:
 	size_t _size;
 	size_t _capacity;
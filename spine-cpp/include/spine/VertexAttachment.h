@@ -37,6 +37,8 @@
 namespace spine {
 	class Slot;
 
+	class WeightedVertices;
+
 	/// An attachment with vertices that are transformed by one or more bones and can be deformed by a slot's vertices.
 	class SP_API VertexAttachment : public Attachment {
 		friend class SkeletonBinary;
@@ -65,8 +67,10 @@ namespace spine {
 		/// Gets a unique ID for this attachment.
 		int getId();
 
+		/// Call packWeights after changing the bones of a weighted attachment.
 		Vector<size_t>& getBones();
 
+		/// Call packWeights after changing the vertices of a weighted attachment.
 		Vector<float>& getVertices();
 
 		size_t getWorldVerticesLength();
@@ -77,6 +81,12 @@ namespace spine {
 
 		void copyTo(VertexAttachment* other);
 
+		/// Re-packs the weighted vertices for skinning, see WeightedVertices. Called by the loaders and copyTo, must be called
+		/// again after any change to Bones or Vertices of a weighted attachment. The packed data is a copy: edits in place
+		/// which keep their sizes are not detected and computeWorldVertices keeps skinning the old weights, only a change of
+		/// their sizes makes it skin vertex by vertex until the next call.
+		void packWeights();
+
 	protected:
 		Vector<size_t> _bones;
 		Vector<float> _vertices;
@@ -85,6 +95,7 @@ namespace spine {
 
 	private:
 		const int _id;
+		WeightedVertices* _weightedVertices;
 
 		static int getNextID();
 	};
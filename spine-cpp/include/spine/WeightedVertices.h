@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef Spine_WeightedVertices_h
+#define Spine_WeightedVertices_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Bone;
+
+	/// The weighted vertices of a VertexAttachment re-packed for skinning.
+	///
+	/// Vertices are grouped by their number of influences and packed in blocks of four, each block holding per influence
+	/// the local positions, weights, bones and deform offsets of its four vertices as structure of arrays. Vertices with 1,
+	/// 2 or 3 influences are skinned by unrolled kernels, the rest by a loop over the largest influence count of the block
+	/// with zero weights padding the others. The bone matrices used by the attachment are gathered once per call and the
+	/// four vertices of a block are transformed together with SSE2 or NEON, or a scalar loop where neither is available.
+	/// Influences are summed in their original order, so the results are the same as the per vertex loop of
+	/// VertexAttachment::computeWorldVertices.
+	class SP_API WeightedVertices : public SpineObject {
+	public:
+		/// Attachments using more distinct bones are left to the per vertex loop.
+		static const size_t MAX_BONES = 256;
+
+		/// @return NULL if bones is empty or uses more than MAX_BONES bones.
+		static WeightedVertices *create(Vector<size_t> &bones, Vector<float> &vertices);
+
+		/// Same as VertexAttachment::computeWorldVertices over all vertices.
+		/// @param deform NULL or at least getDeformLength() values.
+		void computeWorldVertices(Vector<Bone *> &skeletonBones, const float *deform, float *worldVertices, size_t offset,
+								  size_t stride);
+
+		/// Whether the packed data was created from bones and vertices of these sizes. Their values are not compared, see
+		/// VertexAttachment::packWeights.
+		bool matches(Vector<size_t> &bones, Vector<float> &vertices);
+
+		/// The number of deform values the weighted vertices use, two per influence.
+		size_t getDeformLength();
+
+	private:
+		WeightedVertices();
+
+		/// Skeleton bone indices of the bones used, the gathered matrices are in this order.
+		Vector<int> _skeletonBones;
+		/// Pairs of influence count and number of consecutive blocks.
+		Vector<int> _runs;
+		/// The four vertex indices of each block.
+		Vector<int> _outputs;
+		/// Per block and influence x, y and weight of the four vertices.
+		Vector<float> _values;
+		/// Per block and influence the gathered bone and the deform offset of the four vertices.
+		Vector<int> _indices;
+		size_t _bonesLength, _verticesLength;
+	};
+}
+
+#endif /* Spine_WeightedVertices_h */
@@ -31,8 +31,10 @@
 #define SPINE_SPINE_H_
 
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
+#include <spine/ArenaExtension.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
@@ -41,6 +43,7 @@
 #include <spine/AttachmentType.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
+#include <spine/BoneBatch.h>
 #include <spine/BoneData.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
@@ -66,6 +69,7 @@
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
+#include <spine/NameIndex.h>
 #include <spine/PathAttachment.h>
 #include <spine/PathConstraint.h>
 #include <spine/PathConstraintData.h>
@@ -74,7 +78,9 @@
 #include <spine/PathConstraintSpacingTimeline.h>
 #include <spine/PointAttachment.h>
 #include <spine/Pool.h>
+#include <spine/PoseCache.h>
 #include <spine/PositionMode.h>
+#include <spine/PropertyIdSet.h>
 #include <spine/RegionAttachment.h>
 #include <spine/RotateMode.h>
 #include <spine/RotateTimeline.h>
@@ -94,6 +100,7 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/TextureLoader.h>
+#include <spine/ThreadPool.h>
 #include <spine/Timeline.h>
 #include <spine/TimelineType.h>
 #include <spine/TransformConstraint.h>
@@ -102,11 +109,13 @@
 #include <spine/TransformMode.h>
 #include <spine/TranslateTimeline.h>
 #include <spine/Triangulator.h>
+#include <spine/Trigonometry.h>
 #include <spine/TwoColorTimeline.h>
 #include <spine/Updatable.h>
 #include <spine/Vector.h>
 #include <spine/VertexAttachment.h>
 #include <spine/VertexEffect.h>
 #include <spine/Vertices.h>
+#include <spine/WeightedVertices.h>
 
 #endif
@@ -11,8 +11,10 @@ INCLUDEPATH += \
 
 HEADERS += \
     include/spine/Animation.h \
+    include/spine/AnimationDecoder.h \
     include/spine/AnimationState.h \
     include/spine/AnimationStateData.h \
+    include/spine/ArenaExtension.h \
     include/spine/Atlas.h \
     include/spine/AtlasAttachmentLoader.h \
     include/spine/Attachment.h \
@@ -21,6 +23,7 @@ HEADERS += \
     include/spine/AttachmentType.h \
     include/spine/BlendMode.h \
     include/spine/Bone.h \
+    include/spine/BoneBatch.h \
     include/spine/BoneData.h \
     include/spine/BoundingBoxAttachment.h \
     include/spine/ClippingAttachment.h \
@@ -47,6 +50,7 @@ HEADERS += \
     include/spine/MeshAttachment.h \
     include/spine/MixBlend.h \
     include/spine/MixDirection.h \
+    include/spine/NameIndex.h \
     include/spine/PathAttachment.h \
     include/spine/PathConstraint.h \
     include/spine/PathConstraintData.h \
@@ -55,7 +59,9 @@ HEADERS += \
     include/spine/PathConstraintSpacingTimeline.h \
     include/spine/PointAttachment.h \
     include/spine/Pool.h \
+    include/spine/PoseCache.h \
     include/spine/PositionMode.h \
+    include/spine/PropertyIdSet.h \
     include/spine/RTTI.h \
     include/spine/RegionAttachment.h \
     include/spine/RotateMode.h \
@@ -75,6 +81,7 @@ HEADERS += \
     include/spine/SpineObject.h \
     include/spine/SpineString.h \
     include/spine/TextureLoader.h \
+    include/spine/ThreadPool.h \
     include/spine/Timeline.h \
     include/spine/TimelineType.h \
     include/spine/TransformConstraint.h \
@@ -83,25 +90,30 @@ HEADERS += \
     include/spine/TransformMode.h \
     include/spine/TranslateTimeline.h \
     include/spine/Triangulator.h \
+    include/spine/Trigonometry.h \
     include/spine/TwoColorTimeline.h \
     include/spine/Updatable.h \
     include/spine/Vector.h \
     include/spine/VertexAttachment.h \
     include/spine/VertexEffect.h \
     include/spine/Vertices.h \
+    include/spine/WeightedVertices.h \
     include/spine/dll.h \
     include/spine/spine.h
 
 SOURCES += \
     src/spine/Animation.cpp \
+    src/spine/AnimationDecoder.cpp \
     src/spine/AnimationState.cpp \
     src/spine/AnimationStateData.cpp \
+    src/spine/ArenaExtension.cpp \
     src/spine/Atlas.cpp \
     src/spine/AtlasAttachmentLoader.cpp \
     src/spine/Attachment.cpp \
     src/spine/AttachmentLoader.cpp \
     src/spine/AttachmentTimeline.cpp \
     src/spine/Bone.cpp \
+    src/spine/BoneBatch.cpp \
     src/spine/BoneData.cpp \
     src/spine/BoundingBoxAttachment.cpp \
     src/spine/ClippingAttachment.cpp \
@@ -128,6 +140,8 @@ SOURCES += \
     src/spine/PathConstraintPositionTimeline.cpp \
     src/spine/PathConstraintSpacingTimeline.cpp \
     src/spine/PointAttachment.cpp \
+    src/spine/PoseCache.cpp \
+    src/spine/PropertyIdSet.cpp \
     src/spine/RTTI.cpp \
     src/spine/RegionAttachment.cpp \
     src/spine/RotateTimeline.cpp \
@@ -144,6 +158,7 @@ SOURCES += \
     src/spine/SlotData.cpp \
     src/spine/SpineObject.cpp \
     src/spine/TextureLoader.cpp \
+    src/spine/ThreadPool.cpp \
     src/spine/Timeline.cpp \
     src/spine/TransformConstraint.cpp \
     src/spine/TransformConstraintData.cpp \
@@ -153,4 +168,5 @@ SOURCES += \
     src/spine/TwoColorTimeline.cpp \
     src/spine/Updatable.cpp \
     src/spine/VertexAttachment.cpp \
-    src/spine/VertexEffect.cpp
+    src/spine/VertexEffect.cpp \
+    src/spine/WeightedVertices.cpp
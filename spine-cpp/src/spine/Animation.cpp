@@ -32,6 +32,7 @@
 #endif
 
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/Timeline.h>
 #include <spine/Skeleton.h>
 #include <spine/Event.h>
@@ -40,20 +41,42 @@
 
 #include <stdint.h>
 
+#include <mutex>
+
 using namespace spine;
 
+namespace {
+// Decoding happens once per animation, so one lock serves all of them.
+std::mutex decodeMutex;
+}
+
 Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) :
 		_timelines(timelines),
 		_timelineIds(),
 		_duration(duration),
-		_name(name) {
+		_name(name),
+		_decoder(NULL),
+		_decoderIndex(0),
+		_decoded(true) {
 	assert(_name.length() > 0);
 	for (int i = 0; i < (int)timelines.size(); i++)
-		_timelineIds.put(timelines[i]->getPropertyId(), true);
+		_timelineIds.add(timelines[i]->getPropertyId());
+}
+
+Animation::Animation(const String &name, float duration, AnimationDecoder &decoder, size_t decoderIndex) :
+		_timelines(),
+		_timelineIds(),
+		_duration(duration),
+		_name(name),
+		_decoder(&decoder),
+		_decoderIndex(decoderIndex),
+		_decoded(false) {
+	assert(_name.length() > 0);
 }
 
 bool Animation::hasTimeline(int id) {
-	return _timelineIds.containsKey(id);
+	decode();
+	return _timelineIds.contains(id);
 }
 
 Animation::~Animation() {
@@ -63,6 +86,8 @@ Animation::~Animation() {
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
 ) {
+	decode();
+
 	if (loop && _duration != 0) {
 		time = MathUtil::fmod(time, _duration);
 		if (lastTime > 0) {
@@ -80,6 +105,7 @@ const String &Animation::getName() {
 }
 
 Vector<Timeline *> &Animation::getTimelines() {
+	decode();
 	return _timelines;
 }
 
@@ -91,6 +117,21 @@ void Animation::setDuration(float inValue) {
 	_duration = inValue;
 }
 
+bool Animation::isDecoded() {
+	return _decoded.load(std::memory_order_acquire);
+}
+
+void Animation::decode() {
+	if (_decoded.load(std::memory_order_acquire)) return;
+
+	std::lock_guard<std::mutex> lock(decodeMutex);
+	if (_decoded.load(std::memory_order_relaxed)) return;
+	_decoder->decode(_decoderIndex, _timelines, _duration);
+	for (size_t i = 0, n = _timelines.size(); i < n; i++)
+		_timelineIds.add(_timelines[i]->getPropertyId());
+	_decoded.store(true, std::memory_order_release);
+}
+
 int Animation::binarySearch(Vector<float> &values, float target, int step) {
 	int low = 0;
 	int size = (int)values.size();
@@ -131,6 +172,19 @@ int Animation::binarySearch(Vector<float> &values, float target) {
 	}
 }
 
+int Animation::search(Vector<float> &values, float target, int step, int *cursor) {
+	if (!cursor) return binarySearch(values, target, step);
+
+	int last = (int)values.size() - step;
+	int frame = *cursor;
+	if (frame >= step && frame <= last && values[frame - step] <= target) {
+		for (int i = 0; i < 4; i++, frame += step) {
+			if (frame == last || values[frame] > target) return *cursor = frame;
+		}
+	}
+	return *cursor = binarySearch(values, target, step);
+}
+
 int Animation::linearSearch(Vector<float> &values, float target, int step) {
 	for (int i = 0, last = (int)values.size() - step; i <= last; i += step) {
 		if (values[i] > target) {
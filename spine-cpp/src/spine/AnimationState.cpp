@@ -61,7 +61,7 @@ TrackEntry::TrackEntry() : _animation(NULL), _next(NULL), _mixingFrom(NULL), _mi
 	_eventThreshold(0), _attachmentThreshold(0), _drawOrderThreshold(0), _animationStart(0),
 	_animationEnd(0), _animationLast(0), _nextAnimationLast(0), _delay(0), _trackTime(0),
 	_trackLast(0), _nextTrackLast(0), _trackEnd(0), _timeScale(1.0f), _alpha(0), _mixTime(0),
-	_mixDuration(0), _interruptAlpha(0), _totalAlpha(0), _mixBlend(MixBlend_Replace),
+	_mixDuration(0), _interruptAlpha(0), _totalAlpha(0), _appliedTime(0), _appliedMixTime(0), _appliedAlpha(0), _mixBlend(MixBlend_Replace),
 	_listener(dummyOnAnimationEventFunc), _listenerObject(NULL) {
 }
 
@@ -183,6 +183,7 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_timelineCursors.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -205,6 +206,8 @@ EventQueueEntry EventQueue::newEventQueueEntry(EventType eventType, TrackEntry *
 EventQueue::EventQueue(AnimationState &state, Pool<TrackEntry> &trackEntryPool) : _state(state),
 	_trackEntryPool(trackEntryPool),
 	_drainDisabled(false) {
+	// Cleared after every drain but keeps its capacity, so a steady state of events does not allocate.
+	_eventQueueEntries.ensureCapacity(16);
 }
 
 EventQueue::~EventQueue() {
@@ -304,6 +307,7 @@ AnimationState::AnimationState(AnimationStateData *data) :
 		_listenerObject(NULL),
 		_unkeyedState(0),
 		_timeScale(1) {
+	_events.ensureCapacity(16);
 }
 
 AnimationState::~AnimationState() {
@@ -422,13 +426,15 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		float animationLast = current._animationLast, animationTime = current.getAnimationTime();
 		size_t timelineCount = current._animation->_timelines.size();
 		Vector<Timeline *> &timelines = current._animation->_timelines;
+		if (current._timelineCursors.size() != timelineCount) current._timelineCursors.setSize(timelineCount, 0);
+		Vector<int> &timelineCursors = current._timelineCursors;
 		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
                 Timeline *timeline = timelines[ii];
                 if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, blend, true);
+                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, blend, true, &timelineCursors[ii]);
                 else
-                    timeline->apply(skeleton, animationLast, animationTime, &_events, mix, blend, MixDirection_In);
+                    timeline->apply(skeleton, animationLast, animationTime, &_events, mix, blend, MixDirection_In, &timelineCursors[ii]);
             }
 		} else {
 			Vector<int> &timelineMode = current._timelineMode;
@@ -444,11 +450,11 @@ bool AnimationState::apply(Skeleton &skeleton) {
 				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
 
 				if (timeline->getRTTI().isExactly(RotateTimeline::rtti))
-					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, animationTime, mix, timelineBlend, timelinesRotation, ii << 1, firstFrame);
+					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, animationTime, mix, timelineBlend, timelinesRotation, ii << 1, firstFrame, &timelineCursors[ii]);
 				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, timelineBlend, true);
+                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, timelineBlend, true, &timelineCursors[ii]);
 				else
-					timeline->apply(skeleton, animationLast, animationTime, &_events, mix, timelineBlend, MixDirection_In);
+					timeline->apply(skeleton, animationLast, animationTime, &_events, mix, timelineBlend, MixDirection_In, &timelineCursors[ii]);
 			}
 		}
 
@@ -456,6 +462,8 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		_events.clear();
 		current._nextAnimationLast = animationTime;
 		current._nextTrackLast = current._trackTime;
+		current._appliedTime = animationTime;
+		current._appliedAlpha = current._alpha;
 	}
 
     int setupState = _unkeyedState + Setup;
@@ -464,7 +472,7 @@ bool AnimationState::apply(Skeleton &skeleton) {
         Slot* slot = slots[i];
         if (slot->getAttachmentState() == setupState) {
             const String& attachmentName = slot->getData().getAttachmentName();
-            slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), attachmentName));
+            slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), slot->getData().getAttachmentNameId(), attachmentName));
         }
     }
     _unkeyedState += 2;
@@ -473,6 +481,52 @@ bool AnimationState::apply(Skeleton &skeleton) {
 	return applied;
 }
 
+bool AnimationState::applyEvents(Skeleton &skeleton) {
+	for (size_t i = 1, n = _tracks.size(); i < n; ++i)
+		if (_tracks[i] != NULL) return false;
+
+	TrackEntry *current = _tracks.size() > 0 ? _tracks[0] : NULL;
+	if (current == NULL || current->_delay > 0 || current->_mixingFrom != NULL || current->_alpha != 1) return false;
+	// The last application of an entry resets to the setup pose, leave that to apply.
+	if (current->_trackTime >= current->_trackEnd && current->_next == NULL) return false;
+
+	if (_animationsChanged) animationsChanged();
+
+	float animationLast = current->_animationLast, animationTime = current->getAnimationTime();
+	Vector<Timeline *> &timelines = current->_animation->_timelines;
+	for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+		Timeline *timeline = timelines[i];
+		if (timeline->getRTTI().isExactly(EventTimeline::rtti))
+			timeline->apply(skeleton, animationLast, animationTime, &_events, 1, MixBlend_First, MixDirection_In);
+	}
+
+	queueEvents(current, animationTime);
+	_events.clear();
+	current->_nextAnimationLast = animationTime;
+	current->_nextTrackLast = current->_trackTime;
+	current->_appliedTime = animationTime;
+	current->_appliedAlpha = current->_alpha;
+	_queue->drain();
+	return true;
+}
+
+bool AnimationState::needsApply() {
+	if (_animationsChanged) return true;
+
+	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
+		TrackEntry *current = _tracks[i];
+		if (current == NULL) continue;
+		// update still has to advance these, even if the pose itself holds.
+		if (current->_delay > 0 || current->_next != NULL || current->_trackEnd != FLT_MAX) return true;
+
+		for (TrackEntry *entry = current; entry != NULL; entry = entry->_mixingFrom) {
+			if (entry->getAnimationTime() != entry->_appliedTime || entry->_alpha != entry->_appliedAlpha) return true;
+			if (entry->_mixingFrom != NULL && entry->_mixTime != entry->_appliedMixTime) return true;
+		}
+	}
+	return false;
+}
+
 void AnimationState::clearTracks() {
 	bool oldDrainDisabled = _queue->_drainDisabled;
 	_queue->_drainDisabled = true;
@@ -656,21 +710,21 @@ Animation *AnimationState::getEmptyAnimation() {
 	return &ret;
 }
 
-void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float time, MixBlend blend, bool attachments) {
+void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float time, MixBlend blend, bool attachments, int *cursor) {
     Slot* slot = skeleton.getSlots()[attachmentTimeline->getSlotIndex()];
     if (!slot->getBone().isActive()) return;
 
     Vector<float>& frames = attachmentTimeline->getFrames();
     if (time < frames[0]) {
         if (blend == MixBlend_Setup || blend == MixBlend_First)
-            setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), attachments);
+            setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), slot->getData().getAttachmentNameId(), attachments);
     } else {
         int frameIndex = 0;
         if (time >= frames[attachmentTimeline->getFrames().size() - 1])
             frameIndex = attachmentTimeline->getFrames().size() - 1;
         else
-            frameIndex = Animation::binarySearch(frames, time) - 1;
-        setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frameIndex], attachments);
+            frameIndex = Animation::search(frames, time, 1, cursor) - 1;
+        setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frameIndex], attachmentTimeline->getAttachmentNameIds()[frameIndex], attachments);
     }
 
     /* If an attachment wasn't set (ie before the first frame or attachments is false), set the setup attachment later.*/
@@ -679,12 +733,12 @@ void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimel
 
 
 void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha,
-	MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame
+	MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame, int *cursor
 ) {
 	if (firstFrame) timelinesRotation[i] = 0;
 
 	if (alpha == 1) {
-		rotateTimeline->apply(skeleton, 0, time, NULL, 1, blend, MixDirection_In);
+		rotateTimeline->apply(skeleton, 0, time, NULL, 1, blend, MixDirection_In, cursor);
 		return;
 	}
 
@@ -709,7 +763,7 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 			r2 = bone->_data._rotation + frames[frames.size() + RotateTimeline::PREV_ROTATION];
 		} else {
 			// Interpolate between the previous frame and the current frame.
-			int frame = Animation::binarySearch(frames, time, RotateTimeline::ENTRIES);
+			int frame = Animation::search(frames, time, RotateTimeline::ENTRIES, cursor);
 			float prevRotation = frames[frame + RotateTimeline::PREV_ROTATION];
 			float frameTime = frames[frame];
 			float percent = rotateTimeline->getCurvePercent((frame >> 1) - 1, 1 - (time - frameTime) / (frames[frame +
@@ -806,11 +860,16 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	float animationLast = from->_animationLast, animationTime = from->getAnimationTime();
 	Vector<Timeline *> &timelines = from->_animation->_timelines;
 	size_t timelineCount = timelines.size();
+	if (from->_timelineCursors.size() != timelineCount) from->_timelineCursors.setSize(timelineCount, 0);
+	Vector<int> &timelineCursors = from->_timelineCursors;
+	from->_appliedTime = animationTime;
+	from->_appliedAlpha = from->_alpha;
+	to->_appliedMixTime = to->_mixTime;
 	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
 
 	if (blend == MixBlend_Add) {
 		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, animationTime, eventBuffer, alphaMix, blend, MixDirection_Out);
+			timelines[i]->apply(skeleton, animationLast, animationTime, eventBuffer, alphaMix, blend, MixDirection_Out, &timelineCursors[i]);
 	} else {
 		Vector<int> &timelineMode = from->_timelineMode;
 		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
@@ -848,13 +907,13 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 			}
 			from->_totalAlpha += alpha;
 			if ((timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
-				applyRotateTimeline((RotateTimeline*)timeline, skeleton, animationTime, alpha, timelineBlend, timelinesRotation, i << 1, firstFrame);
+				applyRotateTimeline((RotateTimeline*)timeline, skeleton, animationTime, alpha, timelineBlend, timelinesRotation, i << 1, firstFrame, &timelineCursors[i]);
 			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
-                applyAttachmentTimeline(static_cast<AttachmentTimeline*>(timeline), skeleton, animationTime, timelineBlend, attachments);
+                applyAttachmentTimeline(static_cast<AttachmentTimeline*>(timeline), skeleton, animationTime, timelineBlend, attachments, &timelineCursors[i]);
             } else {
 			    if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) && timelineBlend == MixBlend_Setup)
 			        direction = MixDirection_In;
-			    timeline->apply(skeleton, animationLast, animationTime, eventBuffer, alpha, timelineBlend, direction);
+			    timeline->apply(skeleton, animationLast, animationTime, eventBuffer, alpha, timelineBlend, direction, &timelineCursors[i]);
 			}
 		}
 	}
@@ -870,8 +929,8 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	return mix;
 }
 
-void AnimationState::setAttachment(Skeleton& skeleton, Slot& slot, const String& attachmentName, bool attachments) {
-    slot.setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName));
+void AnimationState::setAttachment(Skeleton& skeleton, Slot& slot, const String& attachmentName, int attachmentNameId, bool attachments) {
+    slot.setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentNameId, attachmentName));
     if (attachments) slot.setAttachmentState(_unkeyedState + Current);
 }
 
@@ -938,6 +997,9 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry *entryP = _trackEntryPool.obtain(); // Pooling
 	TrackEntry &entry = *entryP;
 
+	// Applying reads the timelines directly, so lazily read animations are decoded when they are set or added.
+	animation->decode();
+
 	entry._trackIndex = trackIndex;
 	entry._animation = animation;
 	entry._loop = loop;
@@ -964,6 +1026,14 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	entry._mixTime = 0;
 	entry._mixDuration = (last == NULL) ? 0 : _data->getMix(last->_animation, animation);
 
+	// Reset keeps the capacity of the per timeline storage, so a pooled entry only allocates when it is given an
+	// animation with more timelines than any it played before.
+	size_t timelineCount = animation->_timelines.size();
+	entry._timelineMode.ensureCapacity(timelineCount);
+	entry._timelineHoldMix.ensureCapacity(timelineCount);
+	entry._timelinesRotation.ensureCapacity(timelineCount << 1);
+	entry._timelineCursors.ensureCapacity(timelineCount);
+
 	return entryP;
 }
 
@@ -1006,8 +1076,7 @@ void AnimationState::computeHold(TrackEntry *entry) {
 
 	if (to != NULL && to->_holdPrevious) {
 		for (size_t i = 0; i < timelinesCount; i++) {
-			int id = timelines[i]->getPropertyId();
-			if (!_propertyIDs.containsKey(id)) _propertyIDs.put(id, true);
+			_propertyIDs.add(timelines[i]->getPropertyId());
 			timelineMode[i] = Hold;
 		}
 		return;
@@ -1019,11 +1088,9 @@ void AnimationState::computeHold(TrackEntry *entry) {
 	for (; i < timelinesCount; ++i) {
 		Timeline *timeline = timelines[i];
 		int id = timeline->getPropertyId();
-		if (_propertyIDs.containsKey(id)) {
+		if (!_propertyIDs.add(id)) {
 			timelineMode[i] = Subsequent;
 		} else {
-			_propertyIDs.put(id, true);
-
 			if (to == NULL || timeline->getRTTI().isExactly(AttachmentTimeline::rtti) ||
 					timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) ||
 					timeline->getRTTI().isExactly(EventTimeline::rtti) || !to->_animation->hasTimeline(id)) {
@@ -41,8 +41,9 @@ AnimationStateData::AnimationStateData(SkeletonData *skeletonData) : _skeletonDa
 }
 
 void AnimationStateData::setMix(const String &fromName, const String &toName, float duration) {
-	Animation *from = _skeletonData->findAnimation(fromName);
-	Animation *to = _skeletonData->findAnimation(toName);
+	// Mixes only key on the animations, so lazily read ones are not decoded by findAnimation.
+	Animation *from = SkeletonData::findWithIndex(_skeletonData->_animations, _skeletonData->_animationIndex, fromName);
+	Animation *to = SkeletonData::findWithIndex(_skeletonData->_animations, _skeletonData->_animationIndex, toName);
 
 	setMix(from, to, duration);
 }
@@ -83,3 +84,7 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
 	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
 }
+
+size_t AnimationStateData::AnimationPair::hash() const {
+	return _a1->_name.hash() * 31 + _a2->_name.hash();
+}
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/ArenaExtension.h>
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace spine;
+
+namespace {
+const size_t ALIGNMENT = 16;
+
+// Every allocation handed out by the extension is preceded by its size and owning arena, NULL for memory of the wrapped
+// extension, padded to keep the allocation aligned. Frees find the owner without any lookup or lock.
+struct Header {
+	size_t size;
+	Arena *arena;
+};
+
+const size_t HEADER_SIZE = 16;
+
+const size_t MAX_BLOCK_GROWTH = 64;
+
+inline size_t align(size_t size) {
+	return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+inline Header *getHeader(const void *ptr) {
+	return (Header *) ((char *) ptr - HEADER_SIZE);
+}
+
+thread_local Arena *currentArena = NULL;
+}
+
+Arena::Arena(size_t blockSize) : _blocks(NULL), _blockSize(blockSize), _usedMemory(0), _reservedMemory(0), _last(NULL) {
+	assert(blockSize > HEADER_SIZE);
+}
+
+Arena::~Arena() {
+	while (_blocks) {
+		Block *previous = _blocks->previous;
+		::free(_blocks);
+		_blocks = previous;
+	}
+}
+
+void *Arena::alloc(size_t size) {
+	if (size == 0) return NULL;
+
+	size_t needed = HEADER_SIZE + align(size);
+	if (!_blocks || (size_t) (_blocks->end - _blocks->top) < needed) {
+		// Allocations larger than half a block get their own block, so the current one keeps filling.
+		bool large = _blocks && needed > _blockSize / 2;
+		Block *block = addBlock(large ? needed : std::max(_blockSize, needed), large);
+		if (!block) return NULL;
+		if (large) {
+			Header *header = (Header *) block->top;
+			header->size = size;
+			header->arena = this;
+			block->top += needed;
+			_usedMemory += needed;
+			return block->top - needed + HEADER_SIZE;
+		}
+		if (_blockSize < DEFAULT_BLOCK_SIZE * MAX_BLOCK_GROWTH) _blockSize <<= 1;
+	}
+
+	Header *header = (Header *) _blocks->top;
+	header->size = size;
+	header->arena = this;
+	_last = _blocks->top + HEADER_SIZE;
+	_blocks->top += needed;
+	_usedMemory += needed;
+	return _last;
+}
+
+void *Arena::realloc(void *ptr, size_t size) {
+	if (!ptr) return alloc(size);
+	if (size == 0) return NULL;
+
+	size_t oldSize = getSize(ptr);
+	if (ptr == _last) {
+		size_t oldNeeded = align(oldSize), needed = align(size);
+		if ((size_t) (_blocks->end - _last) >= needed) {
+			getHeader(_last)->size = size;
+			_blocks->top = _last + needed;
+			_usedMemory += needed - oldNeeded;
+			return ptr;
+		}
+	}
+
+	void *mem = alloc(size);
+	if (mem) memcpy(mem, ptr, std::min(oldSize, size));
+	return mem;
+}
+
+void Arena::free(void *ptr) {
+	if (!ptr || ptr != _last) return;
+
+	_usedMemory -= HEADER_SIZE + align(getSize(ptr));
+	_blocks->top = _last - HEADER_SIZE;
+	_last = NULL;
+}
+
+bool Arena::owns(const void *ptr) const {
+	for (Block *block = _blocks; block; block = block->previous)
+		if ((const char *) ptr > (const char *) block && (const char *) ptr < block->end) return true;
+	return false;
+}
+
+size_t Arena::getSize(const void *ptr) {
+	return getHeader(ptr)->size;
+}
+
+Arena *Arena::getOwner(const void *ptr) {
+	return getHeader(ptr)->arena;
+}
+
+size_t Arena::getUsedMemory() const {
+	return _usedMemory;
+}
+
+size_t Arena::getReservedMemory() const {
+	return _reservedMemory;
+}
+
+Arena::Block *Arena::addBlock(size_t size, bool large) {
+	size_t offset = align(sizeof(Block));
+	Block *block = (Block *) ::malloc(offset + size);
+	if (!block) return NULL;
+	block->top = (char *) block + offset;
+	block->end = block->top + size;
+	if (large) {
+		// Insert behind the current block.
+		block->previous = _blocks->previous;
+		_blocks->previous = block;
+	} else {
+		block->previous = _blocks;
+		_blocks = block;
+		_last = NULL;
+	}
+	_reservedMemory += offset + size;
+	return block;
+}
+
+ArenaExtension::Scope::Scope(Arena *arena) : _previous(currentArena) {
+	currentArena = arena;
+}
+
+ArenaExtension::Scope::~Scope() {
+	currentArena = _previous;
+}
+
+ArenaExtension::ArenaExtension(SpineExtension *extension) : SpineExtension(), _extension(extension) {
+	assert(extension);
+}
+
+ArenaExtension::~ArenaExtension() {
+}
+
+Arena *ArenaExtension::getArena() {
+	return currentArena;
+}
+
+void *ArenaExtension::_alloc(size_t size, const char *file, int line) {
+	if (currentArena) return currentArena->alloc(size);
+
+	char *mem = (char *) _extension->_alloc(HEADER_SIZE + size, file, line);
+	if (!mem) return NULL;
+	Header *header = (Header *) mem;
+	header->size = size;
+	header->arena = NULL;
+	return mem + HEADER_SIZE;
+}
+
+void *ArenaExtension::_calloc(size_t size, const char *file, int line) {
+	if (!currentArena) {
+		char *mem = (char *) _extension->_calloc(HEADER_SIZE + size, file, line);
+		if (!mem) return NULL;
+		Header *header = (Header *) mem;
+		header->size = size;
+		header->arena = NULL;
+		return mem + HEADER_SIZE;
+	}
+
+	void *ptr = currentArena->alloc(size);
+	if (ptr) memset(ptr, 0, size);
+	return ptr;
+}
+
+void *ArenaExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+	if (!ptr) return _alloc(size, file, line);
+
+	Arena *owner = Arena::getOwner(ptr);
+	// Memory of the wrapped extension stays there, its allocator knows best how to grow it.
+	if (!owner) {
+		char *mem = (char *) _extension->_realloc(getHeader(ptr), HEADER_SIZE + size, file, line);
+		if (!mem) return NULL;
+		((Header *) mem)->size = size;
+		return mem + HEADER_SIZE;
+	}
+	if (owner == currentArena) return owner->realloc(ptr, size);
+
+	void *mem = _alloc(size, file, line);
+	if (mem) memcpy(mem, ptr, std::min(Arena::getSize(ptr), size));
+	return mem;
+}
+
+void ArenaExtension::_free(void *mem, const char *file, int line) {
+	if (!mem) return;
+
+	Arena *owner = Arena::getOwner(mem);
+	if (!owner) {
+		_extension->_free(getHeader(mem), file, line);
+		return;
+	}
+	if (owner == currentArena) owner->free(mem);
+}
+
+char *ArenaExtension::_readFile(const String &path, int *length) {
+	Scope scope(NULL);
+	return _extension->_readFile(path, length);
+}
+
+void ArenaExtension::_beforeFree(void *ptr) {
+	_extension->_beforeFree(ptr);
+}
@@ -89,9 +89,8 @@ void Atlas::flipV() {
 }
 
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
-	return NULL;
+	if (!_regionIndices.containsKey(name)) return NULL;
+	return _regions[_regionIndices[name]];
 }
 
 Vector<AtlasPage*> &Atlas::getPages() {
@@ -229,6 +228,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 
 			region->index = toInt(&str);
 
+			if (!_regionIndices.containsKey(region->name)) _regionIndices.put(region->name, (int)_regions.size());
 			_regions.add(region);
 		}
 	}
@@ -51,18 +51,19 @@ AttachmentTimeline::AttachmentTimeline(int frameCount) : Timeline(), _slotIndex(
 	_attachmentNames.ensureCapacity(frameCount);
 
 	_frames.setSize(frameCount, 0);
+	_attachmentNameIds.setSize(frameCount, -1);
 
 	for (int i = 0; i < frameCount; ++i) {
 		_attachmentNames.add(String());
 	}
 }
 
-void AttachmentTimeline::setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName) {
-    slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+void AttachmentTimeline::setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName, int attachmentNameId) {
+    slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, attachmentNameId, *attachmentName));
 }
 
 void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -76,14 +77,14 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 	if (!slot._bone.isActive()) return;
 
 	if (direction == MixDirection_Out) {
-	    if (blend == MixBlend_Setup) setAttachment(skeleton, slot, &slot._data._attachmentName);
+	    if (blend == MixBlend_Setup) setAttachment(skeleton, slot, &slot._data._attachmentName, slot._data._attachmentNameId);
 		return;
 	}
 
 	if (time < _frames[0]) {
 		// Time is before first frame.
 		if (blend == MixBlend_Setup || blend == MixBlend_First) {
-            setAttachment(skeleton, slot, &slot._data._attachmentName);
+            setAttachment(skeleton, slot, &slot._data._attachmentName, slot._data._attachmentNameId);
 		}
 		return;
 	}
@@ -93,11 +94,11 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 		// Time is after last frame.
 		frameIndex = _frames.size() - 1;
 	} else {
-		frameIndex = Animation::binarySearch(_frames, time, 1) - 1;
+		frameIndex = Animation::search(_frames, time, 1, cursor) - 1;
 	}
 
 	attachmentName = &_attachmentNames[frameIndex];
-	slot.setAttachment(attachmentName->length() == 0 ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+	slot.setAttachment(attachmentName->length() == 0 ? NULL : skeleton.getAttachment(_slotIndex, _attachmentNameIds[frameIndex], *attachmentName));
 }
 
 int AttachmentTimeline::getPropertyId() {
@@ -107,6 +108,7 @@ int AttachmentTimeline::getPropertyId() {
 void AttachmentTimeline::setFrame(int frameIndex, float time, const String &attachmentName) {
 	_frames[frameIndex] = time;
 	_attachmentNames[frameIndex] = attachmentName;
+	_attachmentNameIds[frameIndex] = -1;
 }
 
 size_t AttachmentTimeline::getSlotIndex() {
@@ -125,6 +127,10 @@ Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
 
+Vector<int> &AttachmentTimeline::getAttachmentNameIds() {
+	return _attachmentNameIds;
+}
+
 size_t AttachmentTimeline::getFrameCount() {
 	return _frames.size();
 }
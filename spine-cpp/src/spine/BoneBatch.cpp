@@ -0,0 +1,201 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BoneBatch.h>
+
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SPINE_BONE_BATCH_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPINE_BONE_BATCH_NEON
+#endif
+
+using namespace spine;
+
+namespace {
+	/// Rows of the structure of arrays, the local matrix and the position are overwritten by the world transform.
+	enum Field {
+		Field_A, Field_B, Field_C, Field_D, Field_X, Field_Y,
+		Field_ParentA, Field_ParentB, Field_ParentC, Field_ParentD, Field_ParentX, Field_ParentY,
+		Field_Count
+	};
+
+	/// count is a multiple of 4. Multiplies and adds are kept separate and in the order of Bone::updateWorldTransform.
+	void transform(float *buffer, size_t stride, size_t count) {
+		float *a = buffer + Field_A * stride, *b = buffer + Field_B * stride;
+		float *c = buffer + Field_C * stride, *d = buffer + Field_D * stride;
+		float *x = buffer + Field_X * stride, *y = buffer + Field_Y * stride;
+		const float *pa = buffer + Field_ParentA * stride, *pb = buffer + Field_ParentB * stride;
+		const float *pc = buffer + Field_ParentC * stride, *pd = buffer + Field_ParentD * stride;
+		const float *px = buffer + Field_ParentX * stride, *py = buffer + Field_ParentY * stride;
+#if defined(SPINE_BONE_BATCH_SSE)
+		for (size_t i = 0; i < count; i += 4) {
+			__m128 la = _mm_loadu_ps(a + i), lb = _mm_loadu_ps(b + i), lc = _mm_loadu_ps(c + i), ld = _mm_loadu_ps(d + i);
+			__m128 lx = _mm_loadu_ps(x + i), ly = _mm_loadu_ps(y + i);
+			__m128 ma = _mm_loadu_ps(pa + i), mb = _mm_loadu_ps(pb + i), mc = _mm_loadu_ps(pc + i), md = _mm_loadu_ps(pd + i);
+			_mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ma, lx), _mm_mul_ps(mb, ly)), _mm_loadu_ps(px + i)));
+			_mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(mc, lx), _mm_mul_ps(md, ly)), _mm_loadu_ps(py + i)));
+			_mm_storeu_ps(a + i, _mm_add_ps(_mm_mul_ps(ma, la), _mm_mul_ps(mb, lc)));
+			_mm_storeu_ps(b + i, _mm_add_ps(_mm_mul_ps(ma, lb), _mm_mul_ps(mb, ld)));
+			_mm_storeu_ps(c + i, _mm_add_ps(_mm_mul_ps(mc, la), _mm_mul_ps(md, lc)));
+			_mm_storeu_ps(d + i, _mm_add_ps(_mm_mul_ps(mc, lb), _mm_mul_ps(md, ld)));
+		}
+#elif defined(SPINE_BONE_BATCH_NEON)
+		for (size_t i = 0; i < count; i += 4) {
+			float32x4_t la = vld1q_f32(a + i), lb = vld1q_f32(b + i), lc = vld1q_f32(c + i), ld = vld1q_f32(d + i);
+			float32x4_t lx = vld1q_f32(x + i), ly = vld1q_f32(y + i);
+			float32x4_t ma = vld1q_f32(pa + i), mb = vld1q_f32(pb + i), mc = vld1q_f32(pc + i), md = vld1q_f32(pd + i);
+			vst1q_f32(x + i, vaddq_f32(vaddq_f32(vmulq_f32(ma, lx), vmulq_f32(mb, ly)), vld1q_f32(px + i)));
+			vst1q_f32(y + i, vaddq_f32(vaddq_f32(vmulq_f32(mc, lx), vmulq_f32(md, ly)), vld1q_f32(py + i)));
+			vst1q_f32(a + i, vaddq_f32(vmulq_f32(ma, la), vmulq_f32(mb, lc)));
+			vst1q_f32(b + i, vaddq_f32(vmulq_f32(ma, lb), vmulq_f32(mb, ld)));
+			vst1q_f32(c + i, vaddq_f32(vmulq_f32(mc, la), vmulq_f32(md, lc)));
+			vst1q_f32(d + i, vaddq_f32(vmulq_f32(mc, lb), vmulq_f32(md, ld)));
+		}
+#else
+		for (size_t i = 0; i < count; i++) {
+			float la = a[i], lb = b[i], lc = c[i], ld = d[i], lx = x[i], ly = y[i];
+			x[i] = pa[i] * lx + pb[i] * ly + px[i];
+			y[i] = pc[i] * lx + pd[i] * ly + py[i];
+			a[i] = pa[i] * la + pb[i] * lc;
+			b[i] = pa[i] * lb + pb[i] * ld;
+			c[i] = pc[i] * la + pd[i] * lc;
+			d[i] = pc[i] * lb + pd[i] * ld;
+		}
+#endif
+	}
+}
+
+BoneBatch::BoneBatch(Vector<Updatable *> &updateCache, size_t start, size_t count) : _start(start), _stride(0) {
+	// Depth within the run, -1 for bones outside it. Bones precede their children in the update cache.
+	Vector<int> depths;
+	depths.setSize(static_cast<Bone *>(updateCache[start])->getSkeleton().getBones().size(), -1);
+	int maxDepth = -1;
+	for (size_t i = start, n = start + count; i < n; i++) {
+		Bone *bone = static_cast<Bone *>(updateCache[i]);
+		Bone *parent = bone->getParent();
+		int depth = parent ? depths[parent->getData().getIndex()] + 1 : 0;
+		depths[bone->getData().getIndex()] = depth;
+		if (!parent)
+			_roots.add(bone);
+		else if (depth > maxDepth)
+			maxDepth = depth;
+	}
+
+	_bones.ensureCapacity(count - _roots.size());
+	for (int depth = 0; depth <= maxDepth; depth++) {
+		size_t first = _bones.size();
+		_levels.add(first);
+		for (size_t i = start, n = start + count; i < n; i++) {
+			Bone *bone = static_cast<Bone *>(updateCache[i]);
+			if (bone->getParent() && depths[bone->getData().getIndex()] == depth) _bones.add(bone);
+		}
+		size_t padded = (_bones.size() - first + 3) & ~(size_t) 3;
+		if (padded > _stride) _stride = padded;
+	}
+	_levels.add(_bones.size());
+	_buffer.setSize(_stride * Field_Count, 0);
+}
+
+void BoneBatch::update() {
+	for (size_t i = 0, n = _roots.size(); i < n; i++)
+		_roots[i]->update();
+
+	float *buffer = _buffer.buffer();
+	size_t stride = _stride;
+	for (size_t level = 0, levelCount = _levels.size() - 1; level < levelCount; level++) {
+		Bone **bones = _bones.buffer() + _levels[level];
+		size_t count = _levels[level + 1] - _levels[level];
+		if (count == 0) continue;
+
+		for (size_t i = 0; i < count; i++) {
+			Bone &bone = *bones[i];
+			if (bone._data.getTransformMode() != TransformMode_Normal) continue;
+			Bone &parent = *bone._parent;
+			float sinX, cosX, sinY, cosY;
+			MathUtil::sincosDeg(bone._rotation + bone._shearX, sinX, cosX);
+			MathUtil::sincosDeg(bone._rotation + 90 + bone._shearY, sinY, cosY);
+			buffer[Field_A * stride + i] = cosX * bone._scaleX;
+			buffer[Field_B * stride + i] = cosY * bone._scaleY;
+			buffer[Field_C * stride + i] = sinX * bone._scaleX;
+			buffer[Field_D * stride + i] = sinY * bone._scaleY;
+			buffer[Field_X * stride + i] = bone._x;
+			buffer[Field_Y * stride + i] = bone._y;
+			buffer[Field_ParentA * stride + i] = parent._a;
+			buffer[Field_ParentB * stride + i] = parent._b;
+			buffer[Field_ParentC * stride + i] = parent._c;
+			buffer[Field_ParentD * stride + i] = parent._d;
+			buffer[Field_ParentX * stride + i] = parent._worldX;
+			buffer[Field_ParentY * stride + i] = parent._worldY;
+		}
+
+		transform(buffer, stride, (count + 3) & ~(size_t) 3);
+
+		for (size_t i = 0; i < count; i++) {
+			Bone &bone = *bones[i];
+			if (bone._data.getTransformMode() != TransformMode_Normal) {
+				bone.update();
+				continue;
+			}
+			bone._ax = bone._x;
+			bone._ay = bone._y;
+			bone._arotation = bone._rotation;
+			bone._ascaleX = bone._scaleX;
+			bone._ascaleY = bone._scaleY;
+			bone._ashearX = bone._shearX;
+			bone._ashearY = bone._shearY;
+			bone._appliedValid = true;
+			bone._a = buffer[Field_A * stride + i];
+			bone._b = buffer[Field_B * stride + i];
+			bone._c = buffer[Field_C * stride + i];
+			bone._d = buffer[Field_D * stride + i];
+			bone._worldX = buffer[Field_X * stride + i];
+			bone._worldY = buffer[Field_Y * stride + i];
+		}
+	}
+}
+
+size_t BoneBatch::getStart() {
+	return _start;
+}
+
+size_t BoneBatch::getCount() {
+	return _roots.size() + _bones.size();
+}
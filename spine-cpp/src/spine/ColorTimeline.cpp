@@ -62,7 +62,7 @@ ColorTimeline::ColorTimeline(int frameCount) : CurveTimeline(frameCount), _slotI
 }
 
 void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -96,7 +96,7 @@ void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		a = _frames[i + PREV_A];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
+		size_t frame = (size_t)Animation::search(_frames, time, ENTRIES, cursor);
 		r = _frames[frame + PREV_R];
 		g = _frames[frame + PREV_G];
 		b = _frames[frame + PREV_B];
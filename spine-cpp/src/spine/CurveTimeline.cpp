@@ -42,55 +42,109 @@ RTTI_IMPL(CurveTimeline, Timeline)
 const float CurveTimeline::LINEAR = 0;
 const float CurveTimeline::STEPPED = 1;
 const float CurveTimeline::BEZIER = 2;
-const int CurveTimeline::BEZIER_SIZE = 10 * 2 - 1;
+const float CurveTimeline::DEFAULT_BEZIER_TOLERANCE = 0.001f;
+const int CurveTimeline::MAX_BEZIER_SAMPLES = 256;
+
+// Writes y at x = i / count for i from 0 to count. The bezier is walked with forward differences at two steps per sample,
+// x is monotonic for cx1 and cx2 within 0..1, and y is interpolated between the steps around each sample's x.
+static void sampleBezier(float cx1, float cy1, float cx2, float cy2, int count, float *values) {
+	int steps = count * 2;
+	float h = 1.0f / steps, h2 = h * h, h3 = h2 * h;
+	float ax = 1 + (cx1 - cx2) * 3, bx = cx2 * 3 - cx1 * 6, ay = 1 + (cy1 - cy2) * 3, by = cy2 * 3 - cy1 * 6;
+	float dfx = ax * h3 + bx * h2 + cx1 * 3 * h, dfy = ay * h3 + by * h2 + cy1 * 3 * h;
+	float ddfx = ax * 6 * h3 + bx * 2 * h2, ddfy = ay * 6 * h3 + by * 2 * h2;
+	float dddfx = ax * 6 * h3, dddfy = ay * 6 * h3;
+
+	float prevX = 0, prevY = 0, x = 0, y = 0;
+	int step = 0;
+	values[0] = 0;
+	for (int i = 1; i < count; i++) {
+		float target = (float) i / count;
+		while (x < target && step < steps) {
+			prevX = x;
+			prevY = y;
+			x += dfx;
+			y += dfy;
+			dfx += ddfx;
+			dfy += ddfy;
+			ddfx += dddfx;
+			ddfy += dddfy;
+			step++;
+		}
+		values[i] = x > prevX ? prevY + (y - prevY) * (target - prevX) / (x - prevX) : y;
+	}
+	values[count] = 1;
+}
 
-CurveTimeline::CurveTimeline(int frameCount) {
+// The largest difference between the values halfway between count samples taken from values and their linear interpolation.
+static float sampleError(float *values, int resolution, int count) {
+	int stride = resolution / count, half = stride >> 1;
+	float error = 0;
+	for (int i = 0; i < resolution; i += stride)
+		error = MathUtil::max(error, MathUtil::abs(values[i + half] - (values[i] + values[i + stride]) * 0.5f));
+	return error;
+}
+
+CurveTimeline::CurveTimeline(int frameCount) : _bezierTolerance(DEFAULT_BEZIER_TOLERANCE) {
 	assert(frameCount > 0);
 
-	_curves.setSize((frameCount - 1) * BEZIER_SIZE, 0);
+	_types.setSize(frameCount - 1, (unsigned char) LINEAR);
 }
 
 CurveTimeline::~CurveTimeline() {
 }
 
 size_t CurveTimeline::getFrameCount() {
-	return _curves.size() / BEZIER_SIZE + 1;
+	return _types.size() + 1;
 }
 
 void CurveTimeline::setLinear(size_t frameIndex) {
-	_curves[frameIndex * BEZIER_SIZE] = LINEAR;
+	_types[frameIndex] = (unsigned char) LINEAR;
 }
 
 void CurveTimeline::setStepped(size_t frameIndex) {
-	_curves[frameIndex * BEZIER_SIZE] = STEPPED;
+	_types[frameIndex] = (unsigned char) STEPPED;
 }
 
 void CurveTimeline::setCurve(size_t frameIndex, float cx1, float cy1, float cx2, float cy2) {
-	float tmpx = (-cx1 * 2 + cx2) * 0.03f, tmpy = (-cy1 * 2 + cy2) * 0.03f;
-	float dddfx = ((cx1 - cx2) * 3 + 1) * 0.006f, dddfy = ((cy1 - cy2) * 3 + 1) * 0.006f;
-	float ddfx = tmpx * 2 + dddfx, ddfy = tmpy * 2 + dddfy;
-	float dfx = cx1 * 0.3f + tmpx + dddfx * 0.16666667f, dfy = cy1 * 0.3f + tmpy + dddfy * 0.16666667f;
-
-	size_t i = frameIndex * BEZIER_SIZE;
-	_curves[i++] = BEZIER;
-
-	float x = dfx, y = dfy;
-	for (size_t n = i + BEZIER_SIZE - 1; i < n; i += 2) {
-		_curves[i] = x;
-		_curves[i + 1] = y;
-		dfx += ddfx;
-		dfy += ddfy;
-		ddfx += dddfx;
-		ddfy += dddfy;
-		x += dfx;
-		y += dfy;
+	if (_offsets.size() == 0) _offsets.setSize(_types.size(), -1);
+	_types[frameIndex] = (unsigned char) BEZIER;
+	if (_offsets[frameIndex] != -1) removeCurve(frameIndex);
+	size_t offset = _curves.size();
+	_offsets[frameIndex] = (int) offset;
+
+	// One pass at a higher resolution measures the error of the sample counts below it, so most curves are walked once.
+	int count = 8, resolution = 64;
+	float *values;
+	while (true) {
+		_curves.setSize(offset + 1 + resolution + 1, 0);
+		values = _curves.buffer() + offset + 1;
+		sampleBezier(cx1, cy1, cx2, cy2, resolution, values);
+		while (count < resolution && count < MAX_BEZIER_SAMPLES && sampleError(values, resolution, count) > _bezierTolerance)
+			count <<= 1;
+		if (count < resolution) break;
+		resolution <<= 2;
 	}
+	for (int i = 1, stride = resolution / count; i <= count; i++)
+		values[i] = values[i * stride];
+	_curves[offset] = (float) count;
+	_curves.setSize(offset + 1 + count + 1, 0);
+}
+
+void CurveTimeline::removeCurve(size_t frameIndex) {
+	int start = _offsets[frameIndex], size = (int) _curves[start] + 2;
+	float *curves = _curves.buffer();
+	for (size_t i = start + size, n = _curves.size(); i < n; i++)
+		curves[i - size] = curves[i];
+	_curves.setSize(_curves.size() - size, 0);
+	for (size_t i = 0, n = _offsets.size(); i < n; i++)
+		if (_offsets[i] > start) _offsets[i] -= size;
+	_offsets[frameIndex] = -1;
 }
 
 float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 	percent = MathUtil::clamp(percent, 0, 1);
-	size_t i = frameIndex * BEZIER_SIZE;
-	float type = _curves[i];
+	float type = _types[frameIndex];
 
 	if (type == LINEAR) {
 		return percent;
@@ -100,28 +154,22 @@ float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 		return 0;
 	}
 
-	i++;
-	float x = 0;
-	for (size_t start = i, n = i + BEZIER_SIZE - 1; i < n; i += 2) {
-		x = _curves[i];
-		if (x >= percent) {
-			float prevX, prevY;
-			if (i == start) {
-				prevX = 0;
-				prevY = 0;
-			} else {
-				prevX = _curves[i - 2];
-				prevY = _curves[i - 1];
-			}
-			return prevY + (_curves[i + 1] - prevY) * (percent - prevX) / (x - prevX);
-		}
-	}
+	float *curve = _curves.buffer() + _offsets[frameIndex];
+	int count = (int) curve[0];
+	float sample = percent * count;
+	int i = (int) sample;
+	if (i >= count) return 1;
+	return curve[i + 1] + (curve[i + 2] - curve[i + 1]) * (sample - i);
+}
 
-	float y = _curves[i - 1];
+float CurveTimeline::getCurveType(size_t frameIndex) {
+	return _types[frameIndex];
+}
 
-	return y + (1 - y) * (percent - x) / (1 - x); // Last point is 1,1.
+float CurveTimeline::getBezierTolerance() {
+	return _bezierTolerance;
 }
 
-float CurveTimeline::getCurveType(size_t frameIndex) {
-	return _curves[frameIndex * BEZIER_SIZE];
+void CurveTimeline::setBezierTolerance(float inValue) {
+	_bezierTolerance = inValue;
 }
@@ -61,7 +61,7 @@ DeformTimeline::DeformTimeline(int frameCount) : CurveTimeline(frameCount), _slo
 }
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -184,7 +184,7 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(frames, time);
+	int frame = Animation::search(frames, time, 1, cursor);
 	Vector<float> &prevVertices = frameVertices[frame - 1];
 	Vector<float> &nextVertices = frameVertices[frame];
 	float frameTime = frames[frame];
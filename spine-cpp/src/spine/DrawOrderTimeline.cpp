@@ -58,7 +58,7 @@ DrawOrderTimeline::DrawOrderTimeline(int frameCount) : Timeline() {
 }
 
 void DrawOrderTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -91,7 +91,7 @@ void DrawOrderTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 		// Time is after last frame.
 		frame = _frames.size() - 1;
 	} else
-		frame = (size_t)Animation::binarySearch(_frames, time) - 1;
+		frame = (size_t)Animation::search(_frames, time, 1, cursor) - 1;
 
 	Vector<int> &drawOrderToSetupIndex = _drawOrders[frame];
 	if (drawOrderToSetupIndex.size() == 0) {
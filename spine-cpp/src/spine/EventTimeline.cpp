@@ -59,7 +59,7 @@ EventTimeline::~EventTimeline() {
 }
 
 void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	if (pEvents == NULL) return;
 
@@ -82,7 +82,7 @@ void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	if (lastTime < _frames[0]) {
 		frame = 0;
 	} else {
-		frame = Animation::binarySearch(_frames, lastTime);
+		frame = Animation::search(_frames, lastTime, 1, cursor);
 		float frameTime = _frames[frame];
 		while (frame > 0) {
 			// Fire multiple events with the same frame.
@@ -210,9 +210,11 @@ void IkConstraint::apply(Bone &parent, Bone &child, float targetX, float targetY
 			float maxAngle = 0, maxX = l1 + a, maxDist = maxX * maxX, maxY = 0;
 			c0 = -a * l1 / (aa - bb);
 			if (c0 >= -1 && c0 <= 1) {
+				float sin, cos;
 				c0 = MathUtil::acos(c0);
-				x = a * MathUtil::cos(c0) + l1;
-				y = b * MathUtil::sin(c0);
+				MathUtil::sincos(c0, sin, cos);
+				x = a * cos + l1;
+				y = b * sin;
 				d = x * x + y * y;
 				if (d < minDist) {
 					minAngle = c0;
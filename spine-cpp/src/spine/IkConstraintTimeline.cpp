@@ -65,7 +65,7 @@ IkConstraintTimeline::IkConstraintTimeline(int frameCount) : CurveTimeline(frame
 }
 
 void IkConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-								 MixBlend blend, MixDirection direction) {
+								 MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
@@ -123,7 +123,7 @@ void IkConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time,
 	}
 
 	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(_frames, time, ENTRIES);
+	int frame = Animation::search(_frames, time, ENTRIES, cursor);
 	float mix = _frames[frame + PREV_MIX];
 	float softness = _frames[frame + PREV_SOFTNESS];
 	float frameTime = _frames[frame];
@@ -44,6 +44,7 @@ THE SOFTWARE.
 
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 using namespace spine;
 
@@ -57,8 +58,36 @@ const int Json::JSON_OBJECT = 6;
 
 const char *Json::_error = NULL;
 
+namespace {
+/* Items allocated per block of the root. */
+const int BLOCK_ITEMS = 1024;
+
+/* Blocks start with the pointer to the previous block, padded to keep the items aligned. */
+const size_t BLOCK_HEADER = sizeof(double) > sizeof(char *) ? sizeof(double) : sizeof(char *);
+
+/* Powers of ten which are exact in a double. */
+const double POWERS_OF_TEN[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Significant digits which fit an unsigned long long. */
+const int MAX_DIGITS = 19;
+}
+
 Json *Json::getItem(Json *object, const char *string) {
-	Json *c = object->_child;
+	Json *start = object->_cursor ? object->_cursor->_next : NULL;
+	if (!start) start = object->_child;
+
+	Json *c;
+	for (c = start; c; c = c->_next) {
+		if (c->_name && !strcmp(c->_name, string)) return object->_cursor = c;
+	}
+	for (c = object->_child; c != start; c = c->_next) {
+		if (c->_name && !strcmp(c->_name, string)) return object->_cursor = c;
+	}
+
+	c = object->_child;
 	while (c && json_strcasecmp(c->_name, string)) {
 		c = c->_next;
 	}
@@ -100,46 +129,99 @@ const char *Json::getError() {
 	return _error;
 }
 
+Json::Json() :
+		_next(NULL),
+#if SPINE_JSON_HAVE_PREV
+		_prev(NULL),
+#endif
+		_child(NULL),
+		_cursor(NULL),
+		_type(0),
+		_size(0),
+		_valueString(NULL),
+		_valueInt(0),
+		_valueFloat(0),
+		_name(NULL),
+		_buffer(NULL),
+		_blocks(NULL),
+		_blockItems(0) {
+}
+
 Json::Json(const char *value) :
 		_next(NULL),
 #if SPINE_JSON_HAVE_PREV
 		_prev(NULL),
 #endif
 		_child(NULL),
+		_cursor(NULL),
 		_type(0),
 		_size(0),
 		_valueString(NULL),
 		_valueInt(0),
 		_valueFloat(0),
-		_name(NULL) {
-	if (value) {
-		value = parseValue(this, skip(value));
+		_name(NULL),
+		_buffer(NULL),
+		_blocks(NULL),
+		_blockItems(0) {
+	if (value) parse(copy(value));
+}
 
-		assert(value);
-	}
+Json::Json(char *value, bool inSitu) :
+		_next(NULL),
+#if SPINE_JSON_HAVE_PREV
+		_prev(NULL),
+#endif
+		_child(NULL),
+		_cursor(NULL),
+		_type(0),
+		_size(0),
+		_valueString(NULL),
+		_valueInt(0),
+		_valueFloat(0),
+		_name(NULL),
+		_buffer(NULL),
+		_blocks(NULL),
+		_blockItems(0) {
+	if (value) parse(inSitu ? value : copy(value));
 }
 
 Json::~Json() {
-    spine::Json* curr = nullptr;
-    spine::Json* next = _child;
-    do {
-        curr = next;
-        if (curr) {
-            next = curr->_next;
-        }
-        delete curr;
-    } while(next);
-
-    if (_valueString) {
-        SpineExtension::free(_valueString, __FILE__, __LINE__);
-    }
-
-    if (_name) {
-        SpineExtension::free(_name, __FILE__, __LINE__);
-    }
+	/* Items in the blocks own nothing, the root frees them all at once. */
+	while (_blocks) {
+		char *previous = *(char **) _blocks;
+		SpineExtension::free(_blocks, __FILE__, __LINE__);
+		_blocks = previous;
+	}
+
+	if (_buffer) {
+		SpineExtension::free(_buffer, __FILE__, __LINE__);
+	}
+}
+
+char *Json::copy(const char *value) {
+	size_t length = strlen(value);
+	_buffer = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+	memcpy(_buffer, value, length + 1);
+	return _buffer;
 }
 
-const char *Json::skip(const char *inValue) {
+void Json::parse(char *value) {
+	value = parseValue(this, skip(value));
+
+	assert(value);
+}
+
+Json *Json::newItem() {
+	if (!_blocks || _blockItems == BLOCK_ITEMS) {
+		char *block = SpineExtension::alloc<char>(BLOCK_HEADER + BLOCK_ITEMS * sizeof(Json), __FILE__, __LINE__);
+		*(char **) block = _blocks;
+		_blocks = block;
+		_blockItems = 0;
+	}
+	return new(_blocks + BLOCK_HEADER + _blockItems++ * sizeof(Json)) Json();
+}
+
+char *Json::skip(char *inValue) {
 	if (!inValue) {
 		/* must propagate NULL since it's often called in skip(f(...)) form */
 		return NULL;
@@ -152,7 +234,50 @@ const char *Json::skip(const char *inValue) {
 	return inValue;
 }
 
-const char *Json::parseValue(Json *item, const char *value) {
+char *Json::skipValue(char *value) {
+	/* Strings and containers end at their closing character, other values at the next delimiter. */
+	int depth = 0;
+	for (;;) {
+		switch (*value) {
+			case '\0':
+				return depth == 0 ? value : NULL;
+			case '"':
+				for (value++;; value++) {
+					value += strcspn(value, "\"\\");
+					if (*value == '"') break;
+					/* Moves onto the escaped character. */
+					if (!*value || !*++value) return NULL;
+				}
+				value++;
+				if (depth == 0) return value;
+				break;
+			case '{':
+			case '[':
+				depth++;
+				value++;
+				break;
+			case '}':
+			case ']':
+				if (depth == 0) return value;
+				value++;
+				if (--depth == 0) return value;
+				break;
+			case ',':
+				if (depth == 0) return value;
+				value++;
+				break;
+			default:
+				if (depth > 0)
+					value += strcspn(value, "\"{}[]");
+				else if ((unsigned char) *value <= 32)
+					return value;
+				else
+					value++;
+		}
+	}
+}
+
+char *Json::parseValue(Json *item, char *value) {
 	/* Referenced by constructor, parseArray(), and parseObject(). */
 	/* Always called with the result of skip(). */
 #ifdef SPINE_JSON_DEBUG /* Checked at entry to graph, constructor, and after every parse call. */
@@ -214,10 +339,9 @@ const char *Json::parseValue(Json *item, const char *value) {
 
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 
-const char *Json::parseString(Json *item, const char *str) {
-	const char *ptr = str + 1;
+char *Json::parseString(Json *item, char *str) {
+	char *ptr = str + 1;
 	char *ptr2;
-	char *out;
 	int len = 0;
 	unsigned uc, uc2;
 	if (*str != '\"') {
@@ -226,19 +350,12 @@ const char *Json::parseString(Json *item, const char *str) {
 		return 0;
 	} /* not a string! */
 
-	while (*ptr != '\"' && *ptr && ++len) {
-		if (*ptr++ == '\\') {
-			ptr++; /* Skip escaped quotes. */
-		}
+	/* Unescaped text stays where it is, an escape sequence is never shorter than what it stands for. */
+	while (*ptr != '\"' && *ptr != '\\' && *ptr) {
+		ptr++;
 	}
 
-	out = SpineExtension::alloc<char>(len + 1, __FILE__, __LINE__); /* The length needed for the string, roughly. */
-	if (!out) {
-		return 0;
-	}
-
-	ptr = str + 1;
-	ptr2 = out;
+	ptr2 = ptr;
 	while (*ptr != '\"' && *ptr) {
 		if (*ptr != '\\') {
 			*ptr2++ = *ptr++;
@@ -319,78 +436,87 @@ const char *Json::parseString(Json *item, const char *str) {
 		}
 	}
 
+	/* The terminator may overwrite the closing quote. */
+	bool closed = *ptr == '\"';
 	*ptr2 = 0;
 
-	if (*ptr == '\"') {
+	if (closed) {
 		ptr++; /* TODO error handling if not \" or \0 ? */
 	}
 
-	item->_valueString = out;
+	item->_valueString = str + 1;
 	item->_type = JSON_STRING;
 
 	return ptr;
 }
 
-const char *Json::parseNumber(Json *item, const char *num) {
-	double result = 0.0;
-	int negative = 0;
-	char *ptr = (char *) num;
+char *Json::parseNumber(Json *item, char *num) {
+	/* Up to MAX_DIGITS significant digits are accumulated exactly in an integer, scaled by an exact power of ten when
+	 * possible, which gives the correctly rounded value of most numbers with a single multiplication or division. */
+	unsigned long long mantissa = 0;
+	int digits = 0, exponent = 0;
+	bool negative = false;
+	char *ptr = num;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = true;
 		++ptr;
 	}
 
 	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
+		if (digits < MAX_DIGITS) {
+			mantissa = mantissa * 10 + (*ptr - '0');
+			if (mantissa) ++digits;
+		} else {
+			++exponent;
+		}
 		++ptr;
 	}
 
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
 		++ptr;
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
+			if (digits < MAX_DIGITS) {
+				mantissa = mantissa * 10 + (*ptr - '0');
+				if (mantissa) ++digits;
+				--exponent;
+			}
 			++ptr;
-			++n;
 		}
-		result += fraction / pow(10.0, n);
-	}
-
-	if (negative) {
-		result = -result;
 	}
 
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
-		int expNegative = 0;
-		int n = 0;
+		int value = 0;
+		bool expNegative = false;
 		++ptr;
 
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = true;
 			++ptr;
 		} else if (*ptr == '+') {
 			++ptr;
 		}
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
+			if (value < 10000) value = value * 10 + (*ptr - '0');
 			++ptr;
-			++n;
 		}
 
-		if (expNegative) {
-			result = result / pow(10, exponent);
-		} else {
-			result = result * pow(10, exponent);
-		}
+		exponent += expNegative ? -value : value;
 	}
 
 	if (ptr != num) {
 		/* Parse success, number found. */
+		double result = (double) mantissa;
+		if (exponent < 0 && exponent >= -22)
+			result /= POWERS_OF_TEN[-exponent];
+		else if (exponent > 0 && exponent <= 22)
+			result *= POWERS_OF_TEN[exponent];
+		else if (exponent != 0)
+			result *= pow(10.0, exponent);
+		if (negative) result = -result;
+
 		item->_valueFloat = (float)result;
 		item->_valueInt = (int)result;
 		item->_type = JSON_NUMBER;
@@ -402,7 +528,7 @@ const char *Json::parseNumber(Json *item, const char *num) {
 	}
 }
 
-const char *Json::parseArray(Json *item, const char *value) {
+char *Json::parseArray(Json *item, char *value) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -418,10 +544,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new(__FILE__, __LINE__) Json(NULL);
-	if (!item->_child) {
-		return NULL; /* memory fail */
-	}
+	item->_child = child = newItem();
 
 	value = skip(parseValue(child, skip(value))); /* skip any spacing, get the value. */
 
@@ -432,10 +555,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new(__FILE__, __LINE__) Json(NULL);
-		if (!new_item) {
-			return NULL; /* memory fail */
-		}
+		Json *new_item = newItem();
 		child->_next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
@@ -458,7 +578,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 }
 
 /* Build an object from the text. */
-const char *Json::parseObject(Json *item, const char *value) {
+char *Json::parseObject(Json *item, char *value) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -474,10 +594,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new(__FILE__, __LINE__) Json(NULL);
-	if (!item->_child) {
-		return NULL;
-	}
+	item->_child = child = newItem();
 	value = skip(parseString(child, skip(value)));
 	if (!value) {
 		return NULL;
@@ -497,10 +614,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new(__FILE__, __LINE__) Json(NULL);
-		if (!new_item) {
-			return NULL; /* memory fail */
-		}
+		Json *new_item = newItem();
 		child->_next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
@@ -47,6 +47,71 @@ const float MathUtil::Pi_2 = 3.1415926535897932385f * 2;
 const float MathUtil::Deg_Rad = (3.1415926535897932385f / 180.0f);
 const float MathUtil::Rad_Deg = (180.0f / 3.1415926535897932385f);
 
+Trigonometry MathUtil::_trigonometry = Trigonometry_Precise;
+
+namespace {
+	const int SIN_BITS = 14;
+	const int SIN_COUNT = 1 << SIN_BITS;
+	const int SIN_MASK = SIN_COUNT - 1;
+	const float RAD_TO_INDEX = SIN_COUNT / (3.1415926535897932385f * 2);
+	const float DEG_TO_INDEX = SIN_COUNT / 360.0f;
+	/// Sample i is the sine at the center of the i-th of SIN_COUNT steps of the circle.
+	float sinTable[SIN_COUNT];
+	bool sinTableFilled = false;
+
+	inline void tableSinCos(float index, float &outSin, float &outCos) {
+		int i = (int) index;
+		if (index < i) i--;
+		outSin = sinTable[i & SIN_MASK];
+		outCos = sinTable[(i + SIN_COUNT / 4) & SIN_MASK];
+	}
+
+	/// The rational approximation of libgdx, largest error of 0.00488 radians.
+	float tableAtan2(float y, float x) {
+		const float pi = 3.1415926535897932385f;
+		if (x == 0) {
+			if (y > 0) return pi / 2;
+			if (y == 0) return 0;
+			return -pi / 2;
+		}
+		float atan, z = y / x;
+		if ((z < 0 ? -z : z) < 1) {
+			atan = z / (1 + 0.28f * z * z);
+			if (x < 0) return atan + (y < 0 ? -pi : pi);
+			return atan;
+		}
+		atan = pi / 2 - z / (z * z + 0.28f);
+		return y < 0 ? atan - pi : atan;
+	}
+
+	/// Hastings' minimax polynomial of atan on [0, 1] and the octant symmetries, largest error of 0.000012 radians.
+	float polynomialAtan2(float y, float x) {
+		const float pi = 3.1415926535897932385f;
+		float ax = x < 0 ? -x : x, ay = y < 0 ? -y : y;
+		if (ax == 0 && ay == 0) return 0;
+		bool steep = ay > ax;
+		float z = steep ? ax / ay : ay / ax;
+		float z2 = z * z;
+		float r = ((((0.0208351f * z2 - 0.0851330f) * z2 + 0.1801410f) * z2 - 0.3302995f) * z2 + 0.9998660f) * z;
+		if (steep) r = pi / 2 - r;
+		if (x < 0) r = pi - r;
+		return y < 0 ? -r : r;
+	}
+}
+
+void MathUtil::setTrigonometry(Trigonometry inValue) {
+	if (inValue == Trigonometry_Table && !sinTableFilled) {
+		for (int i = 0; i < SIN_COUNT; i++)
+			sinTable[i] = (float) ::sin((i + 0.5) / SIN_COUNT * 3.14159265358979323846 * 2);
+		sinTableFilled = true;
+	}
+	_trigonometry = inValue;
+}
+
+Trigonometry MathUtil::getTrigonometry() {
+	return _trigonometry;
+}
+
 float MathUtil::abs(float v) {
 	return ((v) < 0 ? -(v) : (v));
 }
@@ -63,38 +128,70 @@ float MathUtil::fmod(float a, float b) {
 	return (float)::fmod(a, b);
 }
 
-/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-/// degrees), largest error of 0.00488 radians (0.2796 degrees).
 float MathUtil::atan2(float y, float x) {
-	return (float)::atan2(y, x);
+	switch (_trigonometry) {
+		case Trigonometry_Table:
+			return tableAtan2(y, x);
+		case Trigonometry_Polynomial:
+			return polynomialAtan2(y, x);
+		default:
+			return (float)::atan2(y, x);
+	}
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cos(float radians) {
-	return (float)::cos(radians);
+	if (_trigonometry == Trigonometry_Precise) return (float)::cos(radians);
+	float s, c;
+	sincos(radians, s, c);
+	return c;
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sin(float radians) {
-	return (float)::sin(radians);
+	if (_trigonometry == Trigonometry_Precise) return (float)::sin(radians);
+	float s, c;
+	sincos(radians, s, c);
+	return s;
 }
 
-float MathUtil::sqrt(float v) {
-	return (float)::sqrt(v);
+float MathUtil::sinDeg(float degrees) {
+	if (_trigonometry == Trigonometry_Precise) return (float)::sin(degrees * MathUtil::Deg_Rad);
+	float s, c;
+	sincosDeg(degrees, s, c);
+	return s;
 }
 
-float MathUtil::acos(float v) {
-	return (float)::acos(v);
+float MathUtil::cosDeg(float degrees) {
+	if (_trigonometry == Trigonometry_Precise) return (float)::cos(degrees * MathUtil::Deg_Rad);
+	float s, c;
+	sincosDeg(degrees, s, c);
+	return c;
 }
 
-/// Returns the sine in radians from a lookup table.
-float MathUtil::sinDeg(float degrees) {
-	return (float)::sin(degrees * MathUtil::Deg_Rad);
+void MathUtil::sincosLibraryOrTable(float radians, float &outSin, float &outCos) {
+	if (_trigonometry == Trigonometry_Table) {
+		tableSinCos(radians * RAD_TO_INDEX, outSin, outCos);
+		return;
+	}
+	outSin = (float)::sin(radians);
+	outCos = (float)::cos(radians);
 }
 
-/// Returns the cosine in radians from a lookup table.
-float MathUtil::cosDeg(float degrees) {
-	return (float)::cos(degrees * MathUtil::Deg_Rad);
+void MathUtil::sincosDegLibraryOrTable(float degrees, float &outSin, float &outCos) {
+	if (_trigonometry == Trigonometry_Table) {
+		tableSinCos(degrees * DEG_TO_INDEX, outSin, outCos);
+		return;
+	}
+	float radians = degrees * MathUtil::Deg_Rad;
+	outSin = (float)::sin(radians);
+	outCos = (float)::cos(radians);
+}
+
+float MathUtil::sqrt(float v) {
+	return (float)::sqrt(v);
+}
+
+float MathUtil::acos(float v) {
+	return (float)::acos(v);
 }
 
 /* Need to pass 0 as an argument, so VC++ doesn't error with C2124 */
@@ -42,6 +42,8 @@
 #include <spine/SlotData.h>
 #include <spine/BoneData.h>
 
+#include <string.h>
+
 using namespace spine;
 
 RTTI_IMPL(PathConstraint, Updatable)
@@ -50,6 +52,9 @@ const float PathConstraint::EPSILON = 0.00001f;
 const int PathConstraint::NONE = -1;
 const int PathConstraint::BEFORE = -2;
 const int PathConstraint::AFTER = -3;
+const int PathConstraint::SEGMENTS = 10;
+const int PathConstraint::MIN_ARC_LENGTH_SEGMENTS = 4;
+const int PathConstraint::MAX_ARC_LENGTH_SEGMENTS = 64;
 
 PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : Updatable(),
 	_data(data),
@@ -59,6 +64,9 @@ PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : U
 	_spacing(data.getSpacing()),
 	_rotateMix(data.getRotateMix()),
 	_translateMix(data.getTranslateMix()),
+	_segmentStride(SEGMENTS),
+	_arcLengthTolerance(0),
+	_arcLengthPath(NULL),
 	_active(false)
 {
 	_bones.ensureCapacity(_data.getBones().size());
@@ -66,8 +74,6 @@ PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : U
 		BoneData *boneData = _data.getBones()[i];
 		_bones.add(skeleton.findBone(boneData->getName()));
 	}
-
-	_segments.setSize(10, 0);
 }
 
 void PathConstraint::apply() {
@@ -180,8 +186,7 @@ void PathConstraint::update() {
 			r -= MathUtil::atan2(c, a);
 
 			if (tip) {
-				cos = MathUtil::cos(r);
-				sin = MathUtil::sin(r);
+				MathUtil::sincos(r, sin, cos);
 				float length = bone._data.getLength();
 				boneX += (length * (cos * a - sin * c) - dx) * rotateMix;
 				boneY += (length * (sin * a + cos * c) - dy) * rotateMix;
@@ -194,8 +199,7 @@ void PathConstraint::update() {
 				r += MathUtil::Pi_2;
 
 			r *= rotateMix;
-			cos = MathUtil::cos(r);
-			sin = MathUtil::sin(r);
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -258,6 +262,17 @@ PathConstraintData &PathConstraint::getData() {
 	return _data;
 }
 
+float PathConstraint::getArcLengthTolerance() {
+	return _arcLengthTolerance;
+}
+
+void PathConstraint::setArcLengthTolerance(float inValue) {
+	if (inValue < 0) inValue = 0;
+	if (_arcLengthTolerance == inValue) return;
+	_arcLengthTolerance = inValue;
+	_arcLengthPath = NULL;
+}
+
 Vector<float>&
 PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, bool tangents, bool percentPosition, bool percentSpacing) {
 	Slot &target = *_target;
@@ -313,17 +328,12 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			}
 
 			// Determine curve containing position.
-			for (;; curve++) {
-				float length = lengths[curve];
-				if (p > length) continue;
-
-				if (curve == 0)
-					p /= length;
-				else {
-					float prev = lengths[curve - 1];
-					p = (p - prev) / (length - prev);
-				}
-				break;
+			curve = search(lengths.buffer(), curve, curveCount + 1, p);
+			if (curve == 0)
+				p /= lengths[0];
+			else {
+				float prev = lengths[curve - 1];
+				p = (p - prev) / (lengths[curve] - prev);
 			}
 
 			if (curve != prevCurve) {
@@ -356,42 +366,12 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		path.computeWorldVertices(target, 2, verticesLength, world, 0);
 	}
 
-	// Curve lengths.
-	_curves.setSize(curveCount, 0);
-	pathLength = 0;
-	float x1 = world[0], y1 = world[1], cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
-	float tmpx, tmpy, dddfx, dddfy, ddfx, ddfy, dfx, dfy;
-	for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
-		cx1 = world[w];
-		cy1 = world[w + 1];
-		cx2 = world[w + 2];
-		cy2 = world[w + 3];
-		x2 = world[w + 4];
-		y2 = world[w + 5];
-		tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
-		tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
-		dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
-		dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
-		ddfx = tmpx * 2 + dddfx;
-		ddfy = tmpy * 2 + dddfy;
-		dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
-		dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		ddfx += dddfx;
-		ddfy += dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx + dddfx;
-		dfy += ddfy + dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		_curves[i] = pathLength;
-		x1 = x2;
-		y1 = y2;
+	// Curve lengths, kept while the world vertices stay the same.
+	if (_arcLengthPath != &path || _arcLengthWorld.size() != world.size() ||
+		memcmp(_arcLengthWorld.buffer(), world.buffer(), world.size() * sizeof(float)) != 0) {
+		computeArcLengths(path, curveCount);
 	}
+	pathLength = _curves[curveCount - 1];
 
 	if (percentPosition)
 		position *= pathLength;
@@ -403,8 +383,9 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			_spaces[i] *= pathLength;
 	}
 
-	float curveLength = 0;
-	for (int i = 0, o = 0, curve = 0, segment = 0; i < spacesCount; i++, o += 3) {
+	float x1 = 0, y1 = 0, cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
+	float *segments = NULL, curveLength = 0;
+	for (int i = 0, o = 0, curve = 0, segment = 0, segmentCount = 0; i < spacesCount; i++, o += 3) {
 		float space = _spaces[i];
 		position += space;
 		float p = position;
@@ -422,16 +403,12 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		}
 
 		// Determine curve containing position.
-		for (;; curve++) {
-			float length = _curves[curve];
-			if (p > length) continue;
-			if (curve == 0)
-				p /= length;
-			else {
-				float prev = _curves[curve - 1];
-				p = (p - prev) / (length - prev);
-			}
-			break;
+		curve = search(_curves.buffer(), curve, curveCount, p);
+		if (curve == 0)
+			p /= _curves[0];
+		else {
+			float prev = _curves[curve - 1];
+			p = (p - prev) / (_curves[curve] - prev);
 		}
 
 		// Curve segment lengths.
@@ -446,63 +423,160 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			cy2 = world[ii + 5];
 			x2 = world[ii + 6];
 			y2 = world[ii + 7];
-			tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
-			tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
-			dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
-			dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
-			ddfx = tmpx * 2 + dddfx;
-			ddfy = tmpy * 2 + dddfy;
-			dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
-			dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
-			curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[0] = curveLength;
-			for (ii = 1; ii < 8; ii++) {
-				dfx += ddfx;
-				dfy += ddfy;
-				ddfx += dddfx;
-				ddfy += dddfy;
-				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-				_segments[ii] = curveLength;
-			}
-			dfx += ddfx;
-			dfy += ddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[8] = curveLength;
-			dfx += ddfx + dddfx;
-			dfy += ddfy + dddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[9] = curveLength;
+			segments = getSegments(curve, segmentCount);
+			curveLength = segments[segmentCount - 1];
 			segment = 0;
 		}
 
 		// Weight by segment length.
 		p *= curveLength;
-		for (;; segment++) {
-			float length = _segments[segment];
-			if (p > length) continue;
-			if (segment == 0)
-				p /= length;
-			else {
-				float prev = _segments[segment - 1];
-				p = segment + (p - prev) / (length - prev);
-			}
-			break;
+		segment = search(segments, segment, segmentCount, p);
+		if (segment == 0)
+			p /= segments[0];
+		else {
+			float prev = segments[segment - 1];
+			p = segment + (p - prev) / (segments[segment] - prev);
 		}
-		addCurvePosition(p * 0.1f, x1, y1, cx1, cy1, cx2, cy2, x2, y2, out, o,
+		addCurvePosition(p * (1.0f / segmentCount), x1, y1, cx1, cy1, cx2, cy2, x2, y2, out, o,
 			tangents || (i > 0 && space < EPSILON));
 	}
 
 	return out;
 }
 
+void PathConstraint::computeArcLengths(PathAttachment &path, int curveCount) {
+	Vector<float> &world = _world;
+	_arcLengthPath = &path;
+	_arcLengthWorld.clearAndAddAll(world);
+	_curves.setSize(curveCount, 0);
+	_segmentCounts.clear();
+	_segmentCounts.setSize(curveCount, 0);
+	float pathLength = 0;
+
+	if (_arcLengthTolerance > 0) {
+		// Every curve is divided up front, its segments give its length.
+		_segmentStride = MAX_ARC_LENGTH_SEGMENTS;
+		_segments.setSize(curveCount * _segmentStride, 0);
+		for (int i = 0, w = 0; i < curveCount; i++, w += 6) {
+			float *segments = _segments.buffer() + i * _segmentStride;
+			int count = MIN_ARC_LENGTH_SEGMENTS;
+			computeSegments(world[w], world[w + 1], world[w + 2], world[w + 3], world[w + 4], world[w + 5], world[w + 6],
+				world[w + 7], count, segments);
+			float length = segments[count - 1];
+			while (count < MAX_ARC_LENGTH_SEGMENTS) {
+				count <<= 1;
+				computeSegments(world[w], world[w + 1], world[w + 2], world[w + 3], world[w + 4], world[w + 5], world[w + 6],
+					world[w + 7], count, segments);
+				float finer = segments[count - 1];
+				if (finer - length <= _arcLengthTolerance) break;
+				length = finer;
+			}
+			_segmentCounts[i] = count;
+			pathLength += segments[count - 1];
+			_curves[i] = pathLength;
+		}
+		return;
+	}
+
+	// Curve lengths from 4 samples, the segments of a curve are computed when a bone first lands on it.
+	_segmentStride = SEGMENTS;
+	_segments.setSize(curveCount * _segmentStride, 0);
+	float x1 = world[0], y1 = world[1], cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
+	float tmpx, tmpy, dddfx, dddfy, ddfx, ddfy, dfx, dfy;
+	for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
+		cx1 = world[w];
+		cy1 = world[w + 1];
+		cx2 = world[w + 2];
+		cy2 = world[w + 3];
+		x2 = world[w + 4];
+		y2 = world[w + 5];
+		tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
+		tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
+		dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
+		dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
+		ddfx = tmpx * 2 + dddfx;
+		ddfy = tmpy * 2 + dddfy;
+		dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
+		dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
+		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		dfx += ddfx;
+		dfy += ddfy;
+		ddfx += dddfx;
+		ddfy += dddfy;
+		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		dfx += ddfx;
+		dfy += ddfy;
+		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		dfx += ddfx + dddfx;
+		dfy += ddfy + dddfy;
+		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		_curves[i] = pathLength;
+		x1 = x2;
+		y1 = y2;
+	}
+}
+
+float *PathConstraint::getSegments(int curve, int &count) {
+	float *segments = _segments.buffer() + curve * _segmentStride;
+	count = _segmentCounts[curve];
+	if (count == 0) {
+		Vector<float> &world = _world;
+		int w = curve * 6;
+		count = SEGMENTS;
+		computeSegments(world[w], world[w + 1], world[w + 2], world[w + 3], world[w + 4], world[w + 5], world[w + 6],
+			world[w + 7], count, segments);
+		_segmentCounts[curve] = count;
+	}
+	return segments;
+}
+
+void PathConstraint::computeSegments(float x1, float y1, float cx1, float cy1, float cx2, float cy2, float x2, float y2,
+	int count, float *segments
+) {
+	// Forward differences with a step of 1 / count, for 10 steps these are the editor's 0.3, 0.03 and 0.006.
+	float step1 = (float) (3.0 / count), step2 = (float) (3.0 / (count * count)), step3 = (float) (6.0 / (count * count * count));
+	float tmpx = (x1 - cx1 * 2 + cx2) * step2;
+	float tmpy = (y1 - cy1 * 2 + cy2) * step2;
+	float dddfx = ((cx1 - cx2) * 3 - x1 + x2) * step3;
+	float dddfy = ((cy1 - cy2) * 3 - y1 + y2) * step3;
+	float ddfx = tmpx * 2 + dddfx;
+	float ddfy = tmpy * 2 + dddfy;
+	float dfx = (cx1 - x1) * step1 + tmpx + dddfx * 0.16666667f;
+	float dfy = (cy1 - y1) * step1 + tmpy + dddfy * 0.16666667f;
+	float length = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+	segments[0] = length;
+	for (int i = 1; i < count; i++) {
+		dfx += ddfx;
+		dfy += ddfy;
+		ddfx += dddfx;
+		ddfy += dddfy;
+		length += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+		segments[i] = length;
+	}
+}
+
+int PathConstraint::search(const float *lengths, int from, int to, float p) {
+	// The first length from "from" on which p does not exceed, like scanning forward from it.
+	int low = from, high = to - 1;
+	while (low < high) {
+		int middle = (low + high) >> 1;
+		if (p > lengths[middle])
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
 void PathConstraint::addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o) {
 	float x1 = temp[i];
 	float y1 = temp[i + 1];
 	float dx = temp[i + 2] - x1;
 	float dy = temp[i + 3] - y1;
-	float r = MathUtil::atan2(dy, dx);
-	output[o] = x1 + p * MathUtil::cos(r);
-	output[o + 1] = y1 + p * MathUtil::sin(r);
+	float r = MathUtil::atan2(dy, dx), sin, cos;
+	MathUtil::sincos(r, sin, cos);
+	output[o] = x1 + p * cos;
+	output[o + 1] = y1 + p * sin;
 	output[o + 2] = r;
 }
 
@@ -511,9 +585,10 @@ void PathConstraint::addAfterPosition(float p, Vector<float> &temp, int i, Vecto
 	float y1 = temp[i + 3];
 	float dx = x1 - temp[i];
 	float dy = y1 - temp[i + 1];
-	float r = MathUtil::atan2(dy, dx);
-	output[o] = x1 + p * MathUtil::cos(r);
-	output[o + 1] = y1 + p * MathUtil::sin(r);
+	float r = MathUtil::atan2(dy, dx), sin, cos;
+	MathUtil::sincos(r, sin, cos);
+	output[o] = x1 + p * cos;
+	output[o + 1] = y1 + p * sin;
 	output[o + 2] = r;
 }
 
@@ -61,7 +61,7 @@ PathConstraintMixTimeline::PathConstraintMixTimeline(int frameCount) : CurveTime
 }
 
 void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -93,7 +93,7 @@ void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float
 		translate = _frames[_frames.size() + PREV_TRANSLATE];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, cursor);
 		rotate = _frames[frame + PREV_ROTATE];
 		translate = _frames[frame + PREV_TRANSLATE];
 		float frameTime = _frames[frame];
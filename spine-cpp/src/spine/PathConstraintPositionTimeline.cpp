@@ -62,7 +62,7 @@ PathConstraintPositionTimeline::~PathConstraintPositionTimeline() {
 }
 
 void PathConstraintPositionTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
-	float alpha, MixBlend blend, MixDirection direction
+	float alpha, MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -91,7 +91,7 @@ void PathConstraintPositionTimeline::apply(Skeleton &skeleton, float lastTime, f
 		position = _frames[_frames.size() + PREV_VALUE];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, cursor);
 		position = _frames[frame + PREV_VALUE];
 		float frameTime = _frames[frame];
 		float percent = getCurvePercent(frame / ENTRIES - 1,
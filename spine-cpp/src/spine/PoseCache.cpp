@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/PoseCache.h>
+
+#include <spine/Animation.h>
+#include <spine/AnimationState.h>
+#include <spine/Bone.h>
+#include <spine/DeformTimeline.h>
+#include <spine/DrawOrderTimeline.h>
+#include <spine/EventTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+using namespace spine;
+
+namespace spine {
+	class PoseCache::BakedPose : public SpineObject {
+	public:
+		static const int BONE_ENTRIES = 6;
+		static const int SLOT_ENTRIES = 7;
+
+		BakedPose(SkeletonData *skeletonData, Animation *animation, Skin *skin, int fps, float scaleX, float scaleY) :
+				_skeletonData(skeletonData), _animation(animation), _skin(skin), _fps(fps), _scaleX(scaleX), _scaleY(scaleY),
+				_duration(animation->getDuration()), _frameCount(0), _boneCount(0), _slotCount(0), _lastUse(0) {
+		}
+
+		bool matches(Skeleton &skeleton, Animation &animation, int fps) {
+			return _animation == &animation && _skeletonData == skeleton.getData() && _skin == skeleton.getSkin() &&
+				   _fps == fps && _scaleX == skeleton.getScaleX() && _scaleY == skeleton.getScaleY();
+		}
+
+		/// Samples frameCount + 1 poses, the last one at the animation duration.
+		void bake() {
+			Vector<Timeline *> &timelines = _animation->getTimelines();
+			bool drawOrder = false;
+			for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+				Timeline *timeline = timelines[i];
+				if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+					int slotIndex = static_cast<DeformTimeline *>(timeline)->getSlotIndex();
+					if (!_deformSlots.contains(slotIndex)) _deformSlots.add(slotIndex);
+				}
+				if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti)) drawOrder = true;
+				if (timeline->getRTTI().isExactly(EventTimeline::rtti)) _eventTimelines.add(timeline);
+			}
+
+			Skeleton skeleton(_skeletonData);
+			skeleton.setSkin(_skin);
+			skeleton.setScaleX(_scaleX);
+			skeleton.setScaleY(_scaleY);
+
+			float frames = _duration * _fps;
+			_frameCount = MathUtil::max((size_t) 1, (size_t) frames);
+			if (_frameCount < frames) _frameCount++;
+			_boneCount = skeleton.getBones().size();
+			_slotCount = skeleton.getSlots().size();
+			size_t samples = _frameCount + 1;
+			_bones.setSize(samples * _boneCount * BONE_ENTRIES, 0);
+			_slots.setSize(samples * _slotCount * SLOT_ENTRIES, 0);
+			_attachments.setSize(samples * _slotCount, NULL);
+			if (drawOrder) _drawOrder.setSize(samples * _slotCount, 0);
+			_deformRanges.setSize(samples * _deformSlots.size() * 2, 0);
+
+			for (size_t frame = 0; frame < samples; ++frame) {
+				skeleton.setToSetupPose();
+				_animation->apply(skeleton, 0, frameTime(frame), false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+
+				Vector<Bone *> &bones = skeleton.getBones();
+				float *boneValues = _bones.buffer() + frame * _boneCount * BONE_ENTRIES;
+				for (size_t i = 0; i < _boneCount; ++i, boneValues += BONE_ENTRIES) {
+					Bone *bone = bones[i];
+					boneValues[0] = bone->getA();
+					boneValues[1] = bone->getB();
+					boneValues[2] = bone->getC();
+					boneValues[3] = bone->getD();
+					boneValues[4] = bone->getWorldX();
+					boneValues[5] = bone->getWorldY();
+				}
+
+				Vector<Slot *> &slots = skeleton.getSlots();
+				float *slotValues = _slots.buffer() + frame * _slotCount * SLOT_ENTRIES;
+				Attachment **attachments = _attachments.buffer() + frame * _slotCount;
+				for (size_t i = 0; i < _slotCount; ++i, slotValues += SLOT_ENTRIES) {
+					Slot *slot = slots[i];
+					Color &color = slot->getColor(), &darkColor = slot->getDarkColor();
+					slotValues[0] = color.r;
+					slotValues[1] = color.g;
+					slotValues[2] = color.b;
+					slotValues[3] = color.a;
+					slotValues[4] = darkColor.r;
+					slotValues[5] = darkColor.g;
+					slotValues[6] = darkColor.b;
+					attachments[i] = slot->getAttachment();
+				}
+
+				if (drawOrder) {
+					Vector<Slot *> &order = skeleton.getDrawOrder();
+					int *indices = _drawOrder.buffer() + frame * _slotCount;
+					for (size_t i = 0; i < _slotCount; ++i)
+						indices[i] = order[i]->getData().getIndex();
+				}
+
+				// Deform vertex counts depend on the attachment, each sample keeps its own range of values.
+				int *ranges = _deformRanges.buffer() + frame * _deformSlots.size() * 2;
+				for (size_t i = 0, n = _deformSlots.size(); i < n; ++i) {
+					Vector<float> &deform = slots[_deformSlots[i]]->getDeform();
+					ranges[i * 2] = (int) _deformValues.size();
+					ranges[i * 2 + 1] = (int) deform.size();
+					_deformValues.addAll(deform);
+				}
+			}
+		}
+
+		void apply(Skeleton &skeleton, float time) {
+			float frameValue = MathUtil::clamp(time, 0, _duration) * _fps;
+			size_t frame = MathUtil::min((size_t) frameValue, _frameCount - 1);
+			float frameStart = frameTime(frame), frameDuration = frameTime(frame + 1) - frameStart;
+			float alpha = frameDuration > 0 ? MathUtil::clamp((time - frameStart) / frameDuration, 0, 1) : 0;
+
+			Vector<Bone *> &bones = skeleton.getBones();
+			const float *from = _bones.buffer() + frame * _boneCount * BONE_ENTRIES;
+			const float *to = from + _boneCount * BONE_ENTRIES;
+			float x = skeleton.getX(), y = skeleton.getY();
+			for (size_t i = 0; i < _boneCount; ++i, from += BONE_ENTRIES, to += BONE_ENTRIES) {
+				Bone *bone = bones[i];
+				bone->setA(from[0] + (to[0] - from[0]) * alpha);
+				bone->setB(from[1] + (to[1] - from[1]) * alpha);
+				bone->setC(from[2] + (to[2] - from[2]) * alpha);
+				bone->setD(from[3] + (to[3] - from[3]) * alpha);
+				bone->setWorldX(from[4] + (to[4] - from[4]) * alpha + x);
+				bone->setWorldY(from[5] + (to[5] - from[5]) * alpha + y);
+				bone->setAppliedValid(false);
+			}
+
+			Vector<Slot *> &slots = skeleton.getSlots();
+			from = _slots.buffer() + frame * _slotCount * SLOT_ENTRIES;
+			to = from + _slotCount * SLOT_ENTRIES;
+			Attachment **attachments = _attachments.buffer() + frame * _slotCount;
+			for (size_t i = 0; i < _slotCount; ++i, from += SLOT_ENTRIES, to += SLOT_ENTRIES) {
+				Slot *slot = slots[i];
+				slot->getColor().set(from[0] + (to[0] - from[0]) * alpha, from[1] + (to[1] - from[1]) * alpha,
+					from[2] + (to[2] - from[2]) * alpha, from[3] + (to[3] - from[3]) * alpha);
+				if (slot->hasDarkColor())
+					slot->getDarkColor().set(from[4] + (to[4] - from[4]) * alpha, from[5] + (to[5] - from[5]) * alpha,
+						from[6] + (to[6] - from[6]) * alpha, 1);
+				slot->setAttachment(attachments[i]);
+			}
+
+			if (_drawOrder.size() > 0) {
+				Vector<Slot *> &order = skeleton.getDrawOrder();
+				const int *indices = _drawOrder.buffer() + frame * _slotCount;
+				for (size_t i = 0; i < _slotCount; ++i)
+					order[i] = slots[indices[i]];
+			}
+
+			const int *fromRanges = _deformRanges.buffer() + frame * _deformSlots.size() * 2;
+			const int *toRanges = fromRanges + _deformSlots.size() * 2;
+			for (size_t i = 0, n = _deformSlots.size(); i < n; ++i) {
+				int count = fromRanges[i * 2 + 1];
+				Vector<float> &deform = slots[_deformSlots[i]]->getDeform();
+				deform.setSize(count, 0);
+				float *values = deform.buffer();
+				from = _deformValues.buffer() + fromRanges[i * 2];
+				if (toRanges[i * 2 + 1] == count) {
+					to = _deformValues.buffer() + toRanges[i * 2];
+					for (int ii = 0; ii < count; ++ii)
+						values[ii] = from[ii] + (to[ii] - from[ii]) * alpha;
+				} else {
+					for (int ii = 0; ii < count; ++ii)
+						values[ii] = from[ii];
+				}
+			}
+		}
+
+		void applyEvents(Skeleton &skeleton, float lastTime, float time, Vector<Event *> &events) {
+			for (size_t i = 0, n = _eventTimelines.size(); i < n; ++i)
+				_eventTimelines[i]->apply(skeleton, lastTime, time, &events, 1, MixBlend_First, MixDirection_In);
+		}
+
+		size_t getBytes() {
+			return sizeof(BakedPose) + _bones.size() * sizeof(float) + _slots.size() * sizeof(float) +
+				   _attachments.size() * sizeof(Attachment *) + _drawOrder.size() * sizeof(int) +
+				   _deformSlots.size() * sizeof(int) + _deformRanges.size() * sizeof(int) +
+				   _deformValues.size() * sizeof(float) + _eventTimelines.size() * sizeof(Timeline *);
+		}
+
+		float frameTime(size_t frame) {
+			return MathUtil::min((float) frame / _fps, _duration);
+		}
+
+		SkeletonData *_skeletonData;
+		Animation *_animation;
+		Skin *_skin;
+		int _fps;
+		float _scaleX, _scaleY;
+		float _duration;
+		size_t _frameCount;
+		size_t _boneCount;
+		size_t _slotCount;
+		Vector<float> _bones;
+		Vector<float> _slots;
+		Vector<Attachment *> _attachments;
+		Vector<int> _drawOrder;
+		Vector<int> _deformSlots;
+		Vector<int> _deformRanges;
+		Vector<float> _deformValues;
+		Vector<Timeline *> _eventTimelines;
+		size_t _lastUse;
+	};
+}
+
+PoseCache::PoseCache(size_t maxBytes, int fps) : _usedBytes(0), _maxBytes(maxBytes), _useCount(0), _fps(MathUtil::max(1, fps)) {
+}
+
+PoseCache::~PoseCache() {
+	clear();
+}
+
+bool PoseCache::apply(AnimationState &state, Skeleton &skeleton) {
+	Vector<TrackEntry *> &tracks = state._tracks;
+	for (size_t i = 1, n = tracks.size(); i < n; ++i)
+		if (tracks[i] != NULL) return false;
+
+	TrackEntry *current = tracks.size() > 0 ? tracks[0] : NULL;
+	if (current == NULL || current->_delay > 0 || current->_mixingFrom != NULL || current->_alpha != 1) return false;
+	// The last application of an entry resets to the setup pose, leave that to AnimationState.
+	if (current->_trackTime >= current->_trackEnd && current->_next == NULL) return false;
+
+	BakedPose *pose = getPose(skeleton, *current->_animation);
+	if (pose == NULL) return false;
+
+	if (state._animationsChanged) state.animationsChanged();
+
+	float animationTime = current->getAnimationTime();
+	pose->apply(skeleton, animationTime);
+	pose->applyEvents(skeleton, current->_animationLast, animationTime, state._events);
+
+	state.queueEvents(current, animationTime);
+	state._events.clear();
+	current->_nextAnimationLast = animationTime;
+	current->_nextTrackLast = current->_trackTime;
+	current->_appliedTime = animationTime;
+	current->_appliedAlpha = current->_alpha;
+	state._queue->drain();
+	return true;
+}
+
+void PoseCache::clear() {
+	ContainerUtil::cleanUpVectorOfPointers(_poses);
+	_usedBytes = 0;
+}
+
+size_t PoseCache::getUsedBytes() {
+	return _usedBytes;
+}
+
+size_t PoseCache::getMaxBytes() {
+	return _maxBytes;
+}
+
+void PoseCache::setMaxBytes(size_t inValue) {
+	_maxBytes = inValue;
+	evict(NULL);
+}
+
+int PoseCache::getFps() {
+	return _fps;
+}
+
+void PoseCache::setFps(int inValue) {
+	_fps = MathUtil::max(1, inValue);
+}
+
+PoseCache::BakedPose *PoseCache::getPose(Skeleton &skeleton, Animation &animation) {
+	BakedPose *pose = NULL;
+	for (size_t i = 0, n = _poses.size(); i < n; ++i) {
+		if (_poses[i]->matches(skeleton, animation, _fps)) {
+			pose = _poses[i];
+			break;
+		}
+	}
+
+	if (pose == NULL) {
+		pose = new(__FILE__, __LINE__) BakedPose(skeleton.getData(), &animation, skeleton.getSkin(), _fps,
+			skeleton.getScaleX(), skeleton.getScaleY());
+		pose->bake();
+		_poses.add(pose);
+		_usedBytes += pose->getBytes();
+		evict(pose);
+	}
+
+	pose->_lastUse = ++_useCount;
+	return pose;
+}
+
+void PoseCache::evict(BakedPose *keep) {
+	while (_usedBytes > _maxBytes) {
+		size_t oldest = _poses.size();
+		for (size_t i = 0, n = _poses.size(); i < n; ++i) {
+			if (_poses[i] != keep && (oldest == n || _poses[i]->_lastUse < _poses[oldest]->_lastUse)) oldest = i;
+		}
+		if (oldest == _poses.size()) break;
+
+		BakedPose *pose = _poses[oldest];
+		_usedBytes -= pose->getBytes();
+		_poses.removeAt(oldest);
+		delete pose;
+	}
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/PropertyIdSet.h>
+
+#include <spine/TimelineType.h>
+
+using namespace spine;
+
+const int PropertyIdSet::TYPE_BITS = 16;
+
+const int PropertyIdSet::DENSE_INDICES = 4096;
+
+PropertyIdSet::PropertyIdSet() {
+}
+
+bool PropertyIdSet::add(int id) {
+	if (isSparse(id)) {
+		if (_sparse.containsKey(id)) return false;
+		_sparse.put(id, true);
+		return true;
+	}
+
+	size_t bit = (size_t) (id & 0xffffff) * TYPE_BITS + (id >> 24), word = bit >> 5;
+	if (word >= _bits.size()) _bits.setSize(word + 1, 0);
+	unsigned int mask = 1u << (bit & 31);
+	if (_bits[word] & mask) return false;
+	_bits[word] |= mask;
+	return true;
+}
+
+bool PropertyIdSet::contains(int id) {
+	if (isSparse(id)) return _sparse.containsKey(id);
+
+	size_t bit = (size_t) (id & 0xffffff) * TYPE_BITS + (id >> 24), word = bit >> 5;
+	return word < _bits.size() && (_bits[word] & (1u << (bit & 31))) != 0;
+}
+
+bool PropertyIdSet::isSparse(int id) {
+	// Deform IDs add the attachment ID, which can carry into the type byte, so the type alone does not identify them.
+	// Any ID that is not a known type with a small index stays out of the bitset.
+	int type = id >> 24;
+	return type < 0 || type >= TYPE_BITS || type == TimelineType_Deform || (id & 0xffffff) >= DENSE_INDICES;
+}
+
+void PropertyIdSet::clear() {
+	for (size_t i = 0, n = _bits.size(); i < n; i++)
+		_bits[i] = 0;
+	_sparse.clear();
+}
@@ -50,7 +50,7 @@ RotateTimeline::RotateTimeline(int frameCount) : CurveTimeline(frameCount), _bon
 }
 
 void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -96,7 +96,7 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(_frames, time, ENTRIES);
+	int frame = Animation::search(_frames, time, ENTRIES, cursor);
 	float prevRotation = _frames[frame + PREV_ROTATION];
 	float frameTime = _frames[frame];
 	float percent = getCurvePercent((frame >> 1) - 1,
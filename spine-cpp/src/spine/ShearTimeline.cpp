@@ -49,7 +49,7 @@ ShearTimeline::ShearTimeline(int frameCount) : TranslateTimeline(frameCount) {
 }
 
 void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -80,7 +80,7 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		y = _frames[_frames.size() + PREV_Y];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, cursor);
 		x = _frames[frame + PREV_X];
 		y = _frames[frame + PREV_Y];
 		float frameTime = _frames[frame];
@@ -35,6 +35,7 @@
 
 #include <spine/SkeletonData.h>
 #include <spine/Bone.h>
+#include <spine/BoneBatch.h>
 #include <spine/Slot.h>
 #include <spine/IkConstraint.h>
 #include <spine/PathConstraint.h>
@@ -130,9 +131,12 @@ Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	ContainerUtil::cleanUpVectorOfPointers(_boneBatches);
 }
 
 void Skeleton::updateCache() {
+	// The batches point into the update cache and are built again at the end.
+	ContainerUtil::cleanUpVectorOfPointers(_boneBatches);
 	_updateCache.clear();
 	_updateCacheReset.clear();
 
@@ -195,6 +199,18 @@ void Skeleton::updateCache() {
 	for (i = 0; i < n; ++i) {
 		sortBone(_bones[i]);
 	}
+
+	batchBones();
+}
+
+void Skeleton::batchBones() {
+	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
+		size_t start = i;
+		while (i < n && _updateCache[i]->getRTTI().isExactly(Bone::rtti))
+			i++;
+		if (i - start >= BoneBatch::MIN_BONES)
+			_boneBatches.add(new(__FILE__, __LINE__) BoneBatch(_updateCache, start, i - start));
+	}
 }
 
 void Skeleton::printUpdateCache() {
@@ -226,8 +242,21 @@ void Skeleton::updateWorldTransform() {
 		bone._appliedValid = true;
 	}
 
-	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
-		_updateCache[i]->update();
+	// Without batches, also after getUpdateCacheList, every entry is updated on its own.
+	if (_boneBatches.size() == 0) {
+		for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
+			_updateCache[i]->update();
+		}
+		return;
+	}
+
+	for (size_t i = 0, n = _updateCache.size(), batch = 0; i < n;) {
+		if (batch < _boneBatches.size() && _boneBatches[batch]->getStart() == i) {
+			_boneBatches[batch]->update();
+			i += _boneBatches[batch++]->getCount();
+		} else {
+			_updateCache[i++]->update();
+		}
 	}
 }
 
@@ -287,19 +316,22 @@ void Skeleton::setSlotsToSetupPose() {
 }
 
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	// Bones and slots are created in the order of their data.
+	int index = _data->findBoneIndex(boneName);
+	return index == -1 ? NULL : _bones[index];
 }
 
 int Skeleton::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithDataName(_bones, boneName);
+	return _data->findBoneIndex(boneName);
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	int index = _data->findSlotIndex(slotName);
+	return index == -1 ? NULL : _slots[index];
 }
 
 int Skeleton::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithDataName(_slots, slotName);
+	return _data->findSlotIndex(slotName);
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -319,7 +351,7 @@ void Skeleton::setSkin(Skin *newSkin) {
 				Slot &slot = *slotP;
 				const String &name = slot._data.getAttachmentName();
 				if (name.length() > 0) {
-					Attachment *attachment = newSkin->getAttachment(i, name);
+					Attachment *attachment = newSkin->getAttachment(i, slot._data.getAttachmentNameId(), name);
 					if (attachment != NULL) {
 						slot.setAttachment(attachment);
 					}
@@ -349,23 +381,35 @@ Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName)
 	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentName) : NULL;
 }
 
+Attachment *Skeleton::getAttachment(int slotIndex, int attachmentNameId, const String &attachmentName) {
+	if (attachmentName.isEmpty()) return NULL;
+
+	if (_skin != NULL) {
+		Attachment *attachment = _skin->getAttachment(slotIndex, attachmentNameId, attachmentName);
+		if (attachment != NULL) {
+			return attachment;
+		}
+	}
+
+	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentNameId, attachmentName) : NULL;
+}
+
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
 	assert(slotName.length() > 0);
 
-	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+	int i = _data->findSlotIndex(slotName);
+	if (i != -1) {
 		Slot *slot = _slots[i];
-		if (slot->_data.getName() == slotName) {
-			Attachment *attachment = NULL;
-			if (attachmentName.length() > 0) {
-				attachment = getAttachment(i, attachmentName);
+		Attachment *attachment = NULL;
+		if (attachmentName.length() > 0) {
+			attachment = getAttachment(i, attachmentName);
 
-				assert(attachment != NULL);
-			}
+			assert(attachment != NULL);
+		}
 
-			slot->setAttachment(attachment);
+		slot->setAttachment(attachment);
 
-			return;
-		}
+		return;
 	}
 
 	printf("Slot not found: %s", slotName.buffer());
@@ -476,6 +520,8 @@ Vector<Bone *> &Skeleton::getBones() {
 }
 
 Vector<Updatable *> &Skeleton::getUpdateCacheList() {
+	// The caller may change the list, which the batches would not see.
+	ContainerUtil::cleanUpVectorOfPointers(_boneBatches);
 	return _updateCache;
 }
 
@@ -73,9 +73,65 @@
 #include <spine/DrawOrderTimeline.h>
 #include <spine/EventTimeline.h>
 #include <spine/Event.h>
+#include <spine/ThreadPool.h>
+#include <spine/AnimationDecoder.h>
 
 using namespace spine;
 
+namespace {
+// Guards the errors of animations read on a thread pool.
+std::mutex errorMutex;
+}
+
+class SkeletonBinary::ReadAnimationsTask : public ThreadPool::Task {
+public:
+	ReadAnimationsTask(SkeletonBinary &binary, Vector<const unsigned char *> &offsets, const unsigned char *end,
+		SkeletonData &skeletonData) : _binary(binary), _offsets(offsets), _end(end), _skeletonData(skeletonData) {
+	}
+
+	virtual void run(size_t index) {
+		DataInput input;
+		input.cursor = _offsets[index];
+		input.end = _end;
+		String name(_binary.readString(&input), true);
+		_skeletonData._animations[index] = _binary.readAnimation(name, &input, &_skeletonData);
+	}
+
+private:
+	SkeletonBinary &_binary;
+	Vector<const unsigned char *> &_offsets;
+	const unsigned char *_end;
+	SkeletonData &_skeletonData;
+};
+
+class SkeletonBinary::LazyAnimations : public AnimationDecoder {
+public:
+	LazyAnimations(float scale, float bezierTolerance, SkeletonData &skeletonData) : _binary(scale, bezierTolerance),
+		_skeletonData(skeletonData) {
+	}
+
+	/// Copies the bytes of the animations.
+	void setData(const unsigned char *start, const unsigned char *end) {
+		_data.setSize(end - start, 0);
+		memcpy(_data.buffer(), start, end - start);
+	}
+
+	/// @param offset Of the timelines of the animation in the data.
+	virtual bool decode(size_t offset, Vector<Timeline *> &timelines, float &duration) {
+		DataInput input;
+		input.cursor = _data.buffer() + offset;
+		input.end = _data.buffer() + _data.size();
+		if (!_binary.readTimelines(&input, &_skeletonData, timelines, duration)) return false;
+		_skeletonData.internAttachmentNames(timelines);
+		return true;
+	}
+
+private:
+	SkeletonBinary _binary;
+	SkeletonData &_skeletonData;
+	Vector<unsigned char> _data;
+};
+
 const int SkeletonBinary::BONE_ROTATE = 0;
 const int SkeletonBinary::BONE_TRANSLATE = 1;
 const int SkeletonBinary::BONE_SCALE = 2;
@@ -94,16 +150,22 @@ const int SkeletonBinary::CURVE_STEPPED = 1;
 const int SkeletonBinary::CURVE_BEZIER = 2;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
-		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _ownsLoader(true) {
+		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _ownsLoader(true),
+		_bezierTolerance(CurveTimeline::DEFAULT_BEZIER_TOLERANCE), _threadPool(NULL), _lazyAnimations(false) {
 
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _error(),
-	_scale(1), _ownsLoader(false)
+	_scale(1), _ownsLoader(false), _bezierTolerance(CurveTimeline::DEFAULT_BEZIER_TOLERANCE), _threadPool(NULL),
+	_lazyAnimations(false)
 {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale, float bezierTolerance) : _attachmentLoader(NULL), _error(), _scale(scale),
+	_ownsLoader(false), _bezierTolerance(bezierTolerance), _threadPool(NULL), _lazyAnimations(false)
+{}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -150,15 +212,20 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	int numStrings = readVarint(input, true);
-	for (int i = 0; i < numStrings; i++)
-		skeletonData->_strings.add(readString(input));
+	readStrings(input, numStrings, skeletonData);
 
 	/* Bones. */
 	int numBones = readVarint(input, true);
 	skeletonData->_bones.setSize(numBones, 0);
 	for (int i = 0; i < numBones; ++i) {
 		const char *name = readString(input);
-		BoneData *parent = i == 0 ? 0 : skeletonData->_bones[readVarint(input, true)];
+		if (input->truncated) break;
+		BoneData *parent = NULL;
+		if (i > 0) {
+			// A parent is read before its children.
+			int parentIndex = readIndex(input, i);
+			if (parentIndex != -1) parent = skeletonData->_bones[parentIndex];
+		}
 		BoneData *data = new(__FILE__, __LINE__) BoneData(i, String(name, true), parent);
 		data->_rotation = readFloat(input);
 		data->_x = readFloat(input) * _scale;
@@ -179,7 +246,12 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	skeletonData->_slots.setSize(slotsCount, 0);
 	for (int i = 0; i < slotsCount; ++i) {
 		const char *slotName = readString(input);
-		BoneData *boneData = skeletonData->_bones[readVarint(input, true)];
+		if (input->truncated) break;
+		BoneData *boneData = readReference(input, skeletonData->_bones);
+		if (!boneData) {
+			SpineExtension::free(slotName, __FILE__, __LINE__);
+			break;
+		}
 		SlotData *slotData = new(__FILE__, __LINE__) SlotData(i, String(slotName, true), *boneData);
 
 		readColor(input, slotData->getColor());
@@ -201,14 +273,15 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	skeletonData->_ikConstraints.setSize(ikConstraintsCount, 0);
 	for (int i = 0; i < ikConstraintsCount; ++i) {
 		const char *name = readString(input);
+		if (input->truncated) break;
 		IkConstraintData *data = new(__FILE__, __LINE__) IkConstraintData(String(name, true));
 		data->setOrder(readVarint(input, true));
 		data->setSkinRequired(readBoolean(input));
 		int bonesCount = readVarint(input, true);
 		data->_bones.setSize(bonesCount, 0);
 		for (int ii = 0; ii < bonesCount; ++ii)
-			data->_bones[ii] = skeletonData->_bones[readVarint(input, true)];
-		data->_target = skeletonData->_bones[readVarint(input, true)];
+			data->_bones[ii] = readReference(input, skeletonData->_bones);
+		data->_target = readReference(input, skeletonData->_bones);
 		data->_mix = readFloat(input);
 		data->_softness = readFloat(input) * _scale;
 		data->_bendDirection = readSByte(input);
@@ -223,14 +296,15 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	skeletonData->_transformConstraints.setSize(transformConstraintsCount, 0);
 	for (int i = 0; i < transformConstraintsCount; ++i) {
 		const char *name = readString(input);
+		if (input->truncated) break;
 		TransformConstraintData *data = new(__FILE__, __LINE__) TransformConstraintData(String(name, true));
 		data->setOrder(readVarint(input, true));
 		data->setSkinRequired(readBoolean(input));
 		int bonesCount = readVarint(input, true);
 		data->_bones.setSize(bonesCount, 0);
 		for (int ii = 0; ii < bonesCount; ++ii)
-			data->_bones[ii] = skeletonData->_bones[readVarint(input, true)];
-		data->_target = skeletonData->_bones[readVarint(input, true)];
+			data->_bones[ii] = readReference(input, skeletonData->_bones);
+		data->_target = readReference(input, skeletonData->_bones);
 		data->_local = readBoolean(input);
 		data->_relative = readBoolean(input);
 		data->_offsetRotation = readFloat(input);
@@ -251,14 +325,15 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	skeletonData->_pathConstraints.setSize(pathConstraintsCount, 0);
 	for (int i = 0; i < pathConstraintsCount; ++i) {
 		const char *name = readString(input);
+		if (input->truncated) break;
 		PathConstraintData *data = new(__FILE__, __LINE__) PathConstraintData(String(name, true));
 		data->setOrder(readVarint(input, true));
 		data->setSkinRequired(readBoolean(input));
 		int bonesCount = readVarint(input, true);
 		data->_bones.setSize(bonesCount, 0);
 		for (int ii = 0; ii < bonesCount; ++ii)
-			data->_bones[ii] = skeletonData->_bones[readVarint(input, true)];
-		data->_target = skeletonData->_slots[readVarint(input, true)];
+			data->_bones[ii] = readReference(input, skeletonData->_bones);
+		data->_target = readReference(input, skeletonData->_slots);
 		data->_positionMode = static_cast<PositionMode>(readVarint(input, true));
 		data->_spacingMode = static_cast<SpacingMode>(readVarint(input, true));
 		data->_rotateMode = static_cast<RotateMode>(readVarint(input, true));
@@ -284,6 +359,13 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	for (size_t i = 0, n = (size_t)readVarint(input, true); i < n; ++i)
 		skeletonData->_skins.add(readSkin(input, false, skeletonData, nonessential));
 
+	if (input->truncated) {
+		setError(input->invalidIndex ? "Invalid index in skeleton data." : "Truncated skeleton data.", "");
+		delete input;
+		delete skeletonData;
+		return NULL;
+	}
+
 	/* Linked meshes. */
 	for (int i = 0, n = _linkedMeshes.size(); i < n; ++i) {
 		LinkedMesh *linkedMesh = _linkedMeshes[i];
@@ -315,6 +397,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	skeletonData->_events.setSize(eventsCount, 0);
 	for (int i = 0; i < eventsCount; ++i) {
 		const char *name = readStringRef(input, skeletonData);
+		if (input->truncated) break;
 		EventData *eventData = new(__FILE__, __LINE__) EventData(String(name));
 		eventData->_intValue = readVarint(input, false);
 		eventData->_floatValue = readFloat(input);
@@ -327,21 +410,43 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		skeletonData->_events[i] = eventData;
 	}
 
+	if (input->truncated) {
+		setError(input->invalidIndex ? "Invalid index in skeleton data." : "Truncated skeleton data.", "");
+		delete input;
+		delete skeletonData;
+		return NULL;
+	}
+
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
-	for (int i = 0; i < animationsCount; ++i) {
-		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
-		if (!animation) {
+	if (_lazyAnimations) {
+		if (!readLazyAnimations(input, animationsCount, skeletonData)) {
+			delete input;
+			delete skeletonData;
+			return NULL;
+		}
+	} else if (_threadPool && animationsCount > 1) {
+		if (!readAnimations(input, animationsCount, skeletonData)) {
 			delete input;
 			delete skeletonData;
 			return NULL;
 		}
-		skeletonData->_animations[i] = animation;
+	} else {
+		for (int i = 0; i < animationsCount; ++i) {
+			String name(readString(input), true);
+			Animation *animation = readAnimation(name, input, skeletonData);
+			if (!animation) {
+				delete input;
+				delete skeletonData;
+				return NULL;
+			}
+			skeletonData->_animations[i] = animation;
+		}
 	}
 
 	delete input;
+	skeletonData->internAttachmentNames();
 	return skeletonData;
 }
 
@@ -364,23 +469,64 @@ void SkeletonBinary::setError(const char *value1, const char *value2) {
 	strcpy(message, value1);
 	length = (int) strlen(value1);
 	if (value2) strncat(message + length, value2, 255 - length);
+	std::lock_guard<std::mutex> lock(errorMutex);
 	_error = String(message);
 }
 
+const unsigned char *SkeletonBinary::readBytes(DataInput *input, size_t count) {
+	if ((size_t) (input->end - input->cursor) < count) {
+		input->cursor = input->end;
+		input->truncated = true;
+		return NULL;
+	}
+	const unsigned char *bytes = input->cursor;
+	input->cursor += count;
+	return bytes;
+}
+
 char *SkeletonBinary::readString(DataInput *input) {
 	int length = readVarint(input, true);
 	char *string;
-	if (length == 0) return NULL;
+	if (length <= 0) return NULL;
+	const unsigned char *bytes = readBytes(input, length - 1);
+	if (!bytes) return NULL;
 	string = SpineExtension::alloc<char>(length, __FILE__, __LINE__);
-	memcpy(string, input->cursor, length - 1);
-	input->cursor += length - 1;
+	memcpy(string, bytes, length - 1);
 	string[length - 1] = '\0';
 	return string;
 }
 
+void SkeletonBinary::readStrings(DataInput *input, int count, SkeletonData *skeletonData) {
+	// The first pass only sums the lengths.
+	DataInput lengths = *input;
+	size_t size = 0;
+	for (int i = 0; i < count; i++) {
+		int length = readVarint(&lengths, true);
+		if (length <= 0) continue;
+		readBytes(&lengths, length - 1);
+		size += length;
+	}
+	if (lengths.truncated) {
+		*input = lengths;
+		return;
+	}
+
+	char *data = size > 0 ? SpineExtension::alloc<char>(size, __FILE__, __LINE__) : NULL;
+	skeletonData->_stringData = data;
+	skeletonData->_strings.setSize(count, NULL);
+	for (int i = 0; i < count; i++) {
+		int length = readVarint(input, true);
+		if (length <= 0) continue;
+		memcpy(data, readBytes(input, length - 1), length - 1);
+		data[length - 1] = '\0';
+		skeletonData->_strings[i] = data;
+		data += length;
+	}
+}
+
 char* SkeletonBinary::readStringRef(DataInput* input, SkeletonData* skeletonData) {
-	int index = readVarint(input, true);
-	return index == 0 ? nullptr : skeletonData->_strings[index - 1];
+	int index = readIndex(input, skeletonData->_strings.size() + 1);
+	return index <= 0 ? nullptr : skeletonData->_strings[index - 1];
 }
 
 float SkeletonBinary::readFloat(DataInput *input) {
@@ -392,7 +538,26 @@ float SkeletonBinary::readFloat(DataInput *input) {
 	return intToFloat.floatValue;
 }
 
+void SkeletonBinary::readFloats(DataInput *input, float *values, size_t count, float scale) {
+	const unsigned char *bytes = readBytes(input, count * 4);
+	if (!bytes) return;
+	// A branch free loop over the bytes, which compilers turn into byte swapping loads.
+	for (size_t i = 0; i < count; i++, bytes += 4) {
+		union {
+			unsigned int intValue;
+			float floatValue;
+		} intToFloat;
+		intToFloat.intValue = (unsigned int) bytes[0] << 24 | (unsigned int) bytes[1] << 16 |
+			(unsigned int) bytes[2] << 8 | bytes[3];
+		values[i] = intToFloat.floatValue * scale;
+	}
+}
+
 unsigned char SkeletonBinary::readByte(DataInput *input) {
+	if (input->cursor == input->end) {
+		input->truncated = true;
+		return 0;
+	}
 	return *input->cursor++;
 }
 
@@ -405,14 +570,9 @@ bool SkeletonBinary::readBoolean(DataInput *input) {
 }
 
 int SkeletonBinary::readInt(DataInput *input) {
-	int result = readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	return result;
+	const unsigned char *bytes = readBytes(input, 4);
+	if (!bytes) return 0;
+	return (int) ((unsigned int) bytes[0] << 24 | (unsigned int) bytes[1] << 16 | (unsigned int) bytes[2] << 8 | bytes[3]);
 }
 
 void SkeletonBinary::readColor(DataInput *input, Color &color) {
@@ -442,6 +602,28 @@ int SkeletonBinary::readVarint(DataInput *input, bool optimizePositive) {
 	return value;
 }
 
+int SkeletonBinary::readIndex(DataInput *input, size_t count) {
+	int index = readVarint(input, true);
+	if (input->truncated) return -1;
+	if (index < 0 || (size_t) index >= count) {
+		setInvalidIndex(input);
+		return -1;
+	}
+	return index;
+}
+
+template<typename T>
+T *SkeletonBinary::readReference(DataInput *input, Vector<T *> &items) {
+	int index = readIndex(input, items.size());
+	return index == -1 ? NULL : items[index];
+}
+
+void SkeletonBinary::setInvalidIndex(DataInput *input) {
+	input->cursor = input->end;
+	input->truncated = true;
+	input->invalidIndex = true;
+}
+
 Skin *SkeletonBinary::readSkin(DataInput *input, bool defaultSkin, SkeletonData *skeletonData, bool nonessential) {
 	Skin *skin;
 	int slotCount = 0;
@@ -450,25 +632,28 @@ Skin *SkeletonBinary::readSkin(DataInput *input, bool defaultSkin, SkeletonData
 		if (slotCount == 0) return NULL;
 		skin = new(__FILE__, __LINE__) Skin("default");
 	} else {
-		skin = new(__FILE__, __LINE__) Skin(readStringRef(input, skeletonData));
+		const char *name = readStringRef(input, skeletonData);
+		if (input->truncated) return NULL;
+		skin = new(__FILE__, __LINE__) Skin(name);
 		for (int i = 0, n = readVarint(input, true); i < n; i++)
-			skin->getBones().add(skeletonData->_bones[readVarint(input, true)]);
+			skin->getBones().add(readReference(input, skeletonData->_bones));
 
 		for (int i = 0, n = readVarint(input, true); i < n; i++)
-			skin->getConstraints().add(skeletonData->_ikConstraints[readVarint(input, true)]);
+			skin->getConstraints().add(readReference(input, skeletonData->_ikConstraints));
 
 		for (int i = 0, n = readVarint(input, true); i < n; i++)
-			skin->getConstraints().add(skeletonData->_transformConstraints[readVarint(input, true)]);
+			skin->getConstraints().add(readReference(input, skeletonData->_transformConstraints));
 
 		for (int i = 0, n = readVarint(input, true); i < n; i++)
-			skin->getConstraints().add(skeletonData->_pathConstraints[readVarint(input, true)]);
+			skin->getConstraints().add(readReference(input, skeletonData->_pathConstraints));
 		slotCount = readVarint(input, true);
 	}
 
 	for (int i = 0; i < slotCount; ++i) {
-		int slotIndex = readVarint(input, true);
+		int slotIndex = readIndex(input, skeletonData->_slots.size());
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
 			String name(readStringRef(input, skeletonData));
+			if (input->truncated) return skin;
 			Attachment *attachment = readAttachment(input, skin, slotIndex, name, skeletonData, nonessential);
 			if (attachment) skin->setAttachment(slotIndex, String(name), attachment);
 		}
@@ -483,6 +668,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 	if (name.isEmpty()) name = attachmentName;
 
 	AttachmentType type = static_cast<AttachmentType>(readByte(input));
+	if (input->truncated) return NULL;
 	switch (type) {
 	case AttachmentType_Region: {
 		String path(readStringRef(input, skeletonData));
@@ -504,7 +690,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 	case AttachmentType_Boundingbox: {
 		int vertexCount = readVarint(input, true);
 		BoundingBoxAttachment *box = _attachmentLoader->newBoundingBoxAttachment(*skin, String(name));
-		readVertices(input, static_cast<VertexAttachment *>(box), vertexCount);
+		readVertices(input, static_cast<VertexAttachment *>(box), vertexCount, skeletonData);
 		if (nonessential) {
 			/* Skip color. */
 			readInt(input);
@@ -524,7 +710,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 		vertexCount = readVarint(input, true);
 		readFloatArray(input, vertexCount << 1, 1, mesh->getRegionUVs());
 		readShortArray(input, mesh->getTriangles());
-		readVertices(input, static_cast<VertexAttachment *>(mesh), vertexCount);
+		readVertices(input, static_cast<VertexAttachment *>(mesh), vertexCount, skeletonData);
 		mesh->updateUVs();
 		mesh->_hullLength = readVarint(input, true) << 1;
 		if (nonessential) {
@@ -563,7 +749,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 		path->_closed = readBoolean(input);
 		path->_constantSpeed = readBoolean(input);
 		int vertexCount = readVarint(input, true);
-		readVertices(input, static_cast<VertexAttachment *>(path), vertexCount);
+		readVertices(input, static_cast<VertexAttachment *>(path), vertexCount, skeletonData);
 		int lengthsLength = vertexCount / 3;
 		path->_lengths.setSize(lengthsLength, 0);
 		for (int i = 0; i < lengthsLength; ++i) {
@@ -590,11 +776,11 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 		return point;
 	}
 	case AttachmentType_Clipping: {
-		int endSlotIndex = readVarint(input, true);
+		SlotData *endSlot = readReference(input, skeletonData->_slots);
 		int vertexCount = readVarint(input, true);
 		ClippingAttachment *clip = _attachmentLoader->newClippingAttachment(*skin, name);
-		readVertices(input, static_cast<VertexAttachment *>(clip), vertexCount);
-		clip->_endSlot = skeletonData->_slots[endSlotIndex];
+		readVertices(input, static_cast<VertexAttachment *>(clip), vertexCount, skeletonData);
+		clip->_endSlot = endSlot;
 		if (nonessential) {
 			/* Skip color. */
 			readInt(input);
@@ -606,7 +792,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 	return NULL;
 }
 
-void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment, int vertexCount) {
+void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment, int vertexCount, SkeletonData *skeletonData) {
 	float scale = _scale;
 	int verticesLength = vertexCount << 1;
 	attachment->setWorldVerticesLength(vertexCount << 1);
@@ -625,51 +811,50 @@ void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment
 		int boneCount = readVarint(input, true);
 		bones.add(boneCount);
 		for (int ii = 0; ii < boneCount; ++ii) {
-			bones.add(readVarint(input, true));
+			bones.add(readIndex(input, skeletonData->_bones.size()));
 			vertices.add(readFloat(input) * scale);
 			vertices.add(readFloat(input) * scale);
 			vertices.add(readFloat(input));
 		}
 	}
+	// The bone indices are only packed when they are all read and valid.
+	if (input->truncated) return;
+	attachment->packWeights();
 }
 
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
 	array.setSize(n, 0);
-
-	int i;
-	if (scale == 1) {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input);
-		}
-	} else {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input) * scale;
-		}
-	}
+	readFloats(input, array.buffer(), n, scale);
 }
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array) {
 	int n = readVarint(input, true);
 	array.setSize(n, 0);
 
-	int i;
-	for (i = 0; i < n; ++i) {
-		array[i] = readByte(input) << 8;
-		array[i] |= readByte(input);
-	}
+	const unsigned char *bytes = readBytes(input, n * 2);
+	if (!bytes) return;
+	for (int i = 0; i < n; ++i, bytes += 2)
+		array[i] = (unsigned short) (bytes[0] << 8 | bytes[1]);
 }
 
 Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
 	Vector<Timeline *> timelines;
+	float duration;
+	if (!readTimelines(input, skeletonData, timelines, duration)) return NULL;
+	return new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+}
+
+bool SkeletonBinary::readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines, float &duration) {
 	float scale = _scale;
-	float duration = 0;
+	duration = 0;
 
 	// Slot timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		int slotIndex = readVarint(input, true);
+		int slotIndex = readIndex(input, skeletonData->_slots.size());
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
 			unsigned char timelineType = readByte(input);
 			int frameCount = readVarint(input, true);
+			if (input->truncated) break;
 			switch (timelineType) {
 				case SLOT_ATTACHMENT: {
 					AttachmentTimeline *timeline = new(__FILE__, __LINE__) AttachmentTimeline(frameCount);
@@ -725,7 +910,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -733,10 +918,11 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// Bone timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		int boneIndex = readVarint(input, true);
+		int boneIndex = readIndex(input, skeletonData->_bones.size());
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
 			unsigned char timelineType = readByte(input);
 			int frameCount = readVarint(input, true);
+			if (input->truncated) break;
 			switch (timelineType) {
 				case BONE_ROTATE: {
 					RotateTimeline *timeline = new(__FILE__, __LINE__) RotateTimeline(frameCount);
@@ -781,7 +967,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -789,8 +975,9 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// IK timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		int index = readVarint(input, true);
+		int index = readIndex(input, skeletonData->_ikConstraints.size());
 		int frameCount = readVarint(input, true);
+		if (input->truncated) break;
 		IkConstraintTimeline *timeline = new(__FILE__, __LINE__) IkConstraintTimeline(frameCount);
 		timeline->_ikConstraintIndex = index;
 		for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
@@ -809,8 +996,9 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// Transform constraint timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		int index = readVarint(input, true);
+		int index = readIndex(input, skeletonData->_transformConstraints.size());
 		int frameCount = readVarint(input, true);
+		if (input->truncated) break;
 		TransformConstraintTimeline *timeline = new(__FILE__, __LINE__) TransformConstraintTimeline(frameCount);
 		timeline->_transformConstraintIndex = index;
 		for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
@@ -828,11 +1016,13 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// Path constraint timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		int index = readVarint(input, true);
+		int index = readIndex(input, skeletonData->_pathConstraints.size());
+		if (input->truncated) break;
 		PathConstraintData *data = skeletonData->_pathConstraints[index];
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
 			int timelineType = readSByte(input);
 			int frameCount = readVarint(input, true);
+			if (input->truncated) break;
 			switch (timelineType) {
 				case PATH_POSITION:
 				case PATH_SPACING: {
@@ -879,9 +1069,10 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 	// Deform timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
-		Skin *skin = skeletonData->_skins[readVarint(input, true)];
+		Skin *skin = readReference(input, skeletonData->_skins);
+		if (!skin) break;
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
-			int slotIndex = readVarint(input, true);
+			int slotIndex = readIndex(input, skeletonData->_slots.size());
 			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
 				const char *attachmentName = readStringRef(input, skeletonData);
 				Attachment *baseAttachment = skin->getAttachment(slotIndex, String(attachmentName));
@@ -889,7 +1080,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Attachment not found: ", attachmentName);
-					return NULL;
+					return false;
 				}
 
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
@@ -899,6 +1090,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				size_t deformLength = weighted ? vertices.size() / 3 * 2 : vertices.size();
 
 				size_t frameCount = (size_t)readVarint(input, true);
+				if (input->truncated) break;
 
 				DeformTimeline *timeline = new(__FILE__, __LINE__) DeformTimeline(frameCount);
 				timeline->_slotIndex = slotIndex;
@@ -920,13 +1112,13 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 						deform.setSize(deformLength, 0);
 						size_t start = (size_t)readVarint(input, true);
 						end += start;
-						if (scale == 1) {
-							for (size_t v = start; v < end; ++v)
-								deform[v] = readFloat(input);
-						} else {
-							for (size_t v = start; v < end; ++v)
-								deform[v] = readFloat(input) * scale;
+						if (end > deformLength) {
+							ContainerUtil::cleanUpVectorOfPointers(timelines);
+							delete timeline;
+							setError("Invalid deform frame for attachment: ", attachmentName);
+							return false;
 						}
+						readFloats(input, deform.buffer() + start, end - start, scale);
 
 						if (!weighted) {
 							for (size_t v = 0, vn = deform.size(); v < vn; ++v)
@@ -953,6 +1145,8 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		for (size_t i = 0; i < drawOrderCount; ++i) {
 			float time = readFloat(input);
 			size_t offsetCount = (size_t)readVarint(input, true);
+			if (offsetCount > slotCount) setInvalidIndex(input);
+			if (input->truncated) break;
 
 			Vector<int> drawOrder;
 			drawOrder.setSize(slotCount, 0);
@@ -963,13 +1157,30 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 			unchanged.setSize(slotCount - offsetCount, 0);
 			size_t originalIndex = 0, unchangedIndex = 0;
 			for (size_t ii = 0; ii < offsetCount; ++ii) {
-				size_t slotIndex = (size_t)readVarint(input, true);
+				// The changed slots are in increasing order and each moves by an offset, which may be negative, to a free index.
+				size_t slotIndex = (size_t)readIndex(input, slotCount);
+				if (input->truncated) break;
+				if (slotIndex < originalIndex) {
+					setInvalidIndex(input);
+					break;
+				}
 				// Collect unchanged items.
 				while (originalIndex != slotIndex)
 					unchanged[unchangedIndex++] = originalIndex++;
 				// Set changed items.
-				size_t index = originalIndex;
-				drawOrder[index + (size_t)readVarint(input, true)] = originalIndex++;
+				size_t index = originalIndex + (size_t)readVarint(input, true);
+				if (input->truncated) break;
+				if (index >= slotCount || drawOrder[index] != -1) {
+					setInvalidIndex(input);
+					break;
+				}
+				drawOrder[index] = originalIndex++;
+			}
+			if (input->truncated) {
+				delete timeline;
+				ContainerUtil::cleanUpVectorOfPointers(timelines);
+				setError(input->invalidIndex ? "Invalid index in animation data." : "Truncated animation data.", "");
+				return false;
 			}
 
 			// Collect remaining unchanged items.
@@ -993,15 +1204,17 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 		for (int i = 0; i < eventCount; ++i) {
 			float time = readFloat(input);
-			EventData *eventData = skeletonData->_events[readVarint(input, true)];
+			EventData *eventData = readReference(input, skeletonData->_events);
+			if (!eventData) break;
 			Event *event = new(__FILE__, __LINE__) Event(time, *eventData);
 
 			event->_intValue = readVarint(input, false);
 			event->_floatValue = readFloat(input);
 			bool freeString = readBoolean(input);
-			const char *event_stringValue = freeString ? readString(input) : eventData->_stringValue.buffer();
-			event->_stringValue = String(event_stringValue);
-			if (freeString) SpineExtension::free(event_stringValue, __FILE__, __LINE__);
+			if (freeString)
+				event->_stringValue.own(readString(input));
+			else
+				event->_stringValue = eventData->_stringValue;
 
 			if (!eventData->_audioPath.isEmpty()) {
 				event->_volume = readFloat(input);
@@ -1014,7 +1227,12 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		duration = MathUtil::max(duration, timeline->_frames[eventCount - 1]);
 	}
 
-	return new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	if (input->truncated) {
+		ContainerUtil::cleanUpVectorOfPointers(timelines);
+		setError(input->invalidIndex ? "Invalid index in animation data." : "Truncated animation data.", "");
+		return false;
+	}
+	return true;
 }
 
 void SkeletonBinary::readCurve(DataInput *input, int frameIndex, CurveTimeline *timeline) {
@@ -1028,8 +1246,212 @@ void SkeletonBinary::readCurve(DataInput *input, int frameIndex, CurveTimeline *
 		float cy1 = readFloat(input);
 		float cx2 = readFloat(input);
 		float cy2 = readFloat(input);
+		timeline->setBezierTolerance(_bezierTolerance);
 		timeline->setCurve(frameIndex, cx1, cy1, cx2, cy2);
 		break;
 	}
 	}
 }
+
+bool SkeletonBinary::readAnimations(DataInput *input, int animationsCount, SkeletonData *skeletonData) {
+	// Animations are not prefixed with their size, so the offsets are found by walking the frames on this thread.
+	Vector<const unsigned char *> offsets;
+	offsets.setSize(animationsCount, NULL);
+	for (int i = 0; i < animationsCount; ++i) {
+		offsets[i] = input->cursor;
+		skipString(input);
+		float duration = 0;
+		if (!skipAnimation(input, skeletonData, duration)) {
+			// Read it to report the error.
+			input->cursor = offsets[i];
+			String name(readString(input), true);
+			readAnimation(name, input, skeletonData);
+			return false;
+		}
+	}
+
+	skeletonData->updateNameIndices();
+
+	ReadAnimationsTask task(*this, offsets, input->end, *skeletonData);
+	_threadPool->run(task, offsets.size());
+
+	for (int i = 0; i < animationsCount; ++i) {
+		if (!skeletonData->_animations[i]) {
+			// Read the first failed animation again, so the error does not depend on the order the threads failed in.
+			input->cursor = offsets[i];
+			String name(readString(input), true);
+			readAnimation(name, input, skeletonData);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SkeletonBinary::readLazyAnimations(DataInput *input, int animationsCount, SkeletonData *skeletonData) {
+	LazyAnimations *lazyAnimations = new(__FILE__, __LINE__) LazyAnimations(_scale, _bezierTolerance, *skeletonData);
+	skeletonData->_animationDecoder = lazyAnimations;
+	const unsigned char *start = input->cursor;
+	for (int i = 0; i < animationsCount; ++i) {
+		const unsigned char *animation = input->cursor;
+		String name(readString(input), true);
+		size_t offset = input->cursor - start;
+		float duration = 0;
+		if (!skipAnimation(input, skeletonData, duration)) {
+			// Read it to report the error.
+			input->cursor = animation;
+			skipString(input);
+			readAnimation(name, input, skeletonData);
+			return false;
+		}
+		skeletonData->_animations[i] = new(__FILE__, __LINE__) Animation(name, duration, *lazyAnimations, offset);
+	}
+	lazyAnimations->setData(start, input->cursor);
+	return true;
+}
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData, float &duration) {
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_slots.size());
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			switch (timelineType) {
+				case SLOT_ATTACHMENT:
+					for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+						float time = readFloat(input);
+						readVarint(input, true);
+						if (frameIndex == frameCount - 1) duration = MathUtil::max(duration, time);
+					}
+					break;
+				case SLOT_COLOR:
+					skipFrames(input, frameCount, 8, duration);
+					break;
+				case SLOT_TWO_COLOR:
+					skipFrames(input, frameCount, 12, duration);
+					break;
+				default:
+					return false;
+			}
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_bones.size());
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			switch (timelineType) {
+				case BONE_ROTATE:
+					skipFrames(input, frameCount, 8, duration);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					skipFrames(input, frameCount, 12, duration);
+					break;
+				default:
+					return false;
+			}
+		}
+	}
+
+	// IK timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_ikConstraints.size());
+		skipFrames(input, readVarint(input, true), 15, duration);
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_transformConstraints.size());
+		skipFrames(input, readVarint(input, true), 20, duration);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_pathConstraints.size());
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int timelineType = readSByte(input);
+			int frameCount = readVarint(input, true);
+			switch (timelineType) {
+				case PATH_POSITION:
+				case PATH_SPACING:
+					skipFrames(input, frameCount, 8, duration);
+					break;
+				case PATH_MIX:
+					skipFrames(input, frameCount, 12, duration);
+					break;
+			}
+		}
+	}
+
+	// Deform timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readIndex(input, skeletonData->_skins.size());
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readIndex(input, skeletonData->_slots.size());
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				readVarint(input, true);
+				int frameCount = readVarint(input, true);
+				for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+					float time = readFloat(input);
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						readBytes(input, end * 4);
+					}
+					if (frameIndex < frameCount - 1)
+						skipCurve(input);
+					else
+						duration = MathUtil::max(duration, time);
+				}
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		float time = readFloat(input);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+		if (i == n - 1) duration = MathUtil::max(duration, time);
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		float time = readFloat(input);
+		EventData *eventData = readReference(input, skeletonData->_events);
+		if (!eventData) break;
+		readVarint(input, false);
+		readBytes(input, 4);
+		if (readBoolean(input)) skipString(input);
+		if (!eventData->_audioPath.isEmpty()) readBytes(input, 8);
+		if (i == n - 1) duration = MathUtil::max(duration, time);
+	}
+
+	return !input->truncated;
+}
+
+void SkeletonBinary::skipString(DataInput *input) {
+	int length = readVarint(input, true);
+	if (length > 0) readBytes(input, length - 1);
+}
+
+void SkeletonBinary::skipFrames(DataInput *input, int frameCount, int frameSize, float &duration) {
+	for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+		float time = readFloat(input);
+		readBytes(input, frameSize - 4);
+		if (frameIndex < frameCount - 1)
+			skipCurve(input);
+		else
+			duration = MathUtil::max(duration, time);
+	}
+}
+
+void SkeletonBinary::skipCurve(DataInput *input) {
+	if (readByte(input) == CURVE_BEZIER) readBytes(input, 16);
+}
@@ -38,6 +38,8 @@
 #include <spine/Skin.h>
 #include <spine/EventData.h>
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
+#include <spine/AttachmentTimeline.h>
 #include <spine/IkConstraintData.h>
 #include <spine/TransformConstraintData.h>
 #include <spine/PathConstraintData.h>
@@ -55,8 +57,10 @@ SkeletonData::SkeletonData() :
 		_height(0),
 		_version(),
 		_hash(),
+		_stringData(NULL),
 		_fps(0),
-		_imagesPath() {
+		_imagesPath(),
+		_animationDecoder(NULL) {
 }
 
 SkeletonData::~SkeletonData() {
@@ -68,56 +72,57 @@ SkeletonData::~SkeletonData() {
 
 	ContainerUtil::cleanUpVectorOfPointers(_events);
 	ContainerUtil::cleanUpVectorOfPointers(_animations);
+	delete _animationDecoder;
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
-	for (size_t i = 0; i < _strings.size(); i++) {
-		SpineExtension::free(_strings[i], __FILE__, __LINE__);
-	}
+	if (_stringData) SpineExtension::free(_stringData, __FILE__, __LINE__);
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	return findWithIndex(_bones, _boneIndex, boneName);
 }
 
 int SkeletonData::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithName(_bones, boneName);
+	return _boneIndex.find(_bones, boneName);
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	return findWithIndex(_slots, _slotIndex, slotName);
 }
 
 int SkeletonData::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithName(_slots, slotName);
+	return _slotIndex.find(_slots, slotName);
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	return findWithIndex(_skins, _skinIndex, skinName);
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	return findWithIndex(_events, _eventIndex, eventDataName);
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	Animation *animation = findWithIndex(_animations, _animationIndex, animationName);
+	if (animation) animation->decode();
+	return animation;
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	return findWithIndex(_ikConstraints, _ikConstraintIndex, constraintName);
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	return findWithIndex(_transformConstraints, _transformConstraintIndex, constraintName);
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	return findWithIndex(_pathConstraints, _pathConstraintIndex, constraintName);
 }
 
 int SkeletonData::findPathConstraintIndex(const String &pathConstraintName) {
-	return ContainerUtil::findIndexWithName(_pathConstraints, pathConstraintName);
+	return _pathConstraintIndex.find(_pathConstraints, pathConstraintName);
 }
 
 const String &SkeletonData::getName() {
@@ -240,3 +245,54 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+void SkeletonData::internAttachmentNames() {
+	for (size_t i = 0, n = _skins.size(); i < n; i++) {
+		Skin::AttachmentMap::Entries entries = _skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			entry._nameId = internAttachmentName(entry._name);
+		}
+	}
+
+	for (size_t i = 0, n = _slots.size(); i < n; i++) {
+		SlotData *slot = _slots[i];
+		slot->_attachmentNameId = slot->_attachmentName.isEmpty() ? -1 : internAttachmentName(slot->_attachmentName);
+	}
+
+	for (size_t i = 0, n = _animations.size(); i < n; i++) {
+		// Lazily read animations are interned when they are decoded.
+		if (_animations[i]->isDecoded()) internAttachmentNames(_animations[i]->getTimelines());
+	}
+
+	updateNameIndices();
+}
+
+void SkeletonData::internAttachmentNames(Vector<Timeline *> &timelines) {
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		if (!timelines[i]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+		AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[i]);
+		for (size_t frame = 0, frameCount = timeline->_attachmentNames.size(); frame < frameCount; frame++) {
+			String &name = timeline->_attachmentNames[frame];
+			timeline->_attachmentNameIds[frame] = name.isEmpty() ? -1 : internAttachmentName(name);
+		}
+	}
+}
+
+void SkeletonData::updateNameIndices() {
+	_boneIndex.update(_bones);
+	_slotIndex.update(_slots);
+	_skinIndex.update(_skins);
+	_eventIndex.update(_events);
+	_animationIndex.update(_animations);
+	_ikConstraintIndex.update(_ikConstraints);
+	_transformConstraintIndex.update(_transformConstraints);
+	_pathConstraintIndex.update(_pathConstraints);
+}
+
+int SkeletonData::internAttachmentName(const String &name) {
+	if (_attachmentNameIds.containsKey(name)) return _attachmentNameIds[name];
+	int id = (int) _attachmentNameIds.size();
+	_attachmentNameIds.put(name, id);
+	return id;
+}
@@ -33,6 +33,7 @@
 
 #include <spine/SkeletonJson.h>
 
+#include <spine/ArenaExtension.h>
 #include <spine/CurveTimeline.h>
 #include <spine/VertexAttachment.h>
 #include <spine/Json.h>
@@ -73,6 +74,8 @@
 #include <spine/EventTimeline.h>
 #include <spine/Event.h>
 #include <spine/Vertices.h>
+#include <spine/ThreadPool.h>
+#include <spine/AnimationDecoder.h>
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #define strdup _strdup
@@ -80,16 +83,136 @@
 
 using namespace spine;
 
+namespace {
+// Guards the errors of animations read on a thread pool.
+std::mutex errorMutex;
+}
+
+class SkeletonJson::ReadAnimationsTask : public ThreadPool::Task {
+public:
+	ReadAnimationsTask(SkeletonJson &json, Vector<Json *> &animationMaps, SkeletonData &skeletonData) : _json(json),
+		_animationMaps(animationMaps), _skeletonData(skeletonData) {
+	}
+
+	virtual void run(size_t index) {
+		_skeletonData._animations[index] = _json.readAnimation(_animationMaps[index], &_skeletonData);
+	}
+
+private:
+	SkeletonJson &_json;
+	Vector<Json *> &_animationMaps;
+	SkeletonData &_skeletonData;
+};
+
+class SkeletonJson::LazyAnimations : public AnimationDecoder {
+public:
+	LazyAnimations(float scale, float bezierTolerance) : _json(scale, bezierTolerance), _skeletonData(NULL) {
+	}
+
+	/// Copies the values of the members of the top level "animations" object and replaces them by 0 in the text, so
+	/// parsing it only reads the animation names. Returns false for malformed text.
+	bool cut(char *json) {
+		char *value = Json::skip(json);
+		if (!value || *value != '{') return false;
+		value = Json::skip(value + 1);
+		while (value && *value == '"') {
+			char *key = value, *keyEnd = Json::skipValue(key);
+			value = Json::skip(keyEnd);
+			if (!value || *value != ':') return false;
+			value = Json::skip(value + 1);
+			if (keyEnd - key == 12 && strncmp(key, "\"animations\"", 12) == 0 && *value == '{')
+				value = cutAnimations(value);
+			else
+				value = Json::skipValue(value);
+			value = Json::skip(value);
+			if (value && *value == ',') value = Json::skip(value + 1);
+		}
+		return value && *value == '}';
+	}
+
+	size_t getDurationCount() {
+		return _durations.size();
+	}
+
+	float getDuration(size_t index) {
+		return _durations[index];
+	}
+
+	void setSkeletonData(SkeletonData *skeletonData) {
+		_skeletonData = skeletonData;
+	}
+
+	virtual bool decode(size_t index, Vector<Timeline *> &timelines, float &duration) {
+		Json *root = new(__FILE__, __LINE__) Json(_text.buffer() + _offsets[index]);
+		bool decoded = _json.readTimelines(root, _skeletonData, timelines, duration);
+		delete root;
+		if (decoded) _skeletonData->internAttachmentNames(timelines);
+		return decoded;
+	}
+
+private:
+	SkeletonJson _json;
+	SkeletonData *_skeletonData;
+	Vector<char> _text;
+	Vector<size_t> _offsets;
+	Vector<float> _durations;
+
+	char *cutAnimations(char *object) {
+		char *value = Json::skip(object + 1);
+		while (value && *value == '"') {
+			value = Json::skip(Json::skipValue(value));
+			if (!value || *value != ':') return NULL;
+			value = Json::skip(value + 1);
+			char *end = Json::skipValue(value);
+			if (!end) return NULL;
+
+			size_t offset = _text.size(), length = end - value;
+			_text.setSize(offset + length + 1, 0);
+			memcpy(_text.buffer() + offset, value, length);
+			_offsets.add(offset);
+			_durations.add(readDuration(_text.buffer() + offset));
+
+			*value = '0';
+			memset(value + 1, ' ', length - 1);
+
+			value = Json::skip(end);
+			if (value && *value == ',') value = Json::skip(value + 1);
+		}
+		return value && *value == '}' ? value + 1 : NULL;
+	}
+
+	/// The keys of a timeline are sorted by time, so the largest time is the duration readTimelines computes.
+	static float readDuration(char *animation) {
+		float duration = 0;
+		for (char *time = strstr(animation, "\"time\""); time; time = strstr(time + 6, "\"time\"")) {
+			char *value = Json::skip(time + 6);
+			if (*value != ':') continue;
+			value = Json::skip(value + 1);
+			if (*value != '-' && (*value < '0' || *value > '9')) continue;
+			Json number;
+			Json::parseNumber(&number, value);
+			duration = MathUtil::max(duration, number._valueFloat);
+		}
+		return duration;
+	}
+};
+
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new(__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-	_scale(1), _ownsLoader(true)
+	_scale(1), _ownsLoader(true), _bezierTolerance(CurveTimeline::DEFAULT_BEZIER_TOLERANCE), _threadPool(NULL),
+	_lazyAnimations(false)
 {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _scale(1),
-	_ownsLoader(false)
+	_ownsLoader(false), _bezierTolerance(CurveTimeline::DEFAULT_BEZIER_TOLERANCE), _threadPool(NULL),
+	_lazyAnimations(false)
 {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonJson::SkeletonJson(float scale, float bezierTolerance) : _attachmentLoader(NULL), _scale(scale),
+	_ownsLoader(false), _bezierTolerance(bezierTolerance), _threadPool(NULL), _lazyAnimations(false)
+{}
+
 SkeletonJson::~SkeletonJson() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 
@@ -99,13 +222,17 @@ SkeletonJson::~SkeletonJson() {
 SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
 	int length;
 	SkeletonData *skeletonData;
-	const char *json = SpineExtension::readFile(path, &length);
+	char *json = SpineExtension::readFile(path, &length);
 	if (length == 0 || !json) {
 		setError(NULL, "Unable to read skeleton file: ", path);
 		return NULL;
 	}
 
-	skeletonData = readSkeletonData(json);
+	// The file contents are only needed while reading, so they are parsed in situ. Extensions do not terminate the
+	// contents, growing the buffer by the terminator usually happens in place.
+	json = SpineExtension::realloc<char>(json, length + 1, __FILE__, __LINE__);
+	json[length] = '\0';
+	skeletonData = readJsonInSitu(json);
 
 	SpineExtension::free(json, __FILE__, __LINE__);
 
@@ -113,21 +240,67 @@ SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
 }
 
 SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
+	if (!_lazyAnimations) {
+		Json *root;
+		{
+			// The document only lives while reading, keep it out of an arena collecting the skeleton data.
+			ArenaExtension::Scope scope(NULL);
+			root = new(__FILE__, __LINE__) Json(json);
+		}
+		return readJson(root, NULL);
+	}
+
+	// Cutting the animations out modifies the text.
+	size_t length = strlen(json);
+	char *copy;
+	{
+		ArenaExtension::Scope scope(NULL);
+		copy = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+	}
+	memcpy(copy, json, length + 1);
+	SkeletonData *skeletonData = readJsonInSitu(copy);
+	SpineExtension::free(copy, __FILE__, __LINE__);
+	return skeletonData;
+}
+
+SkeletonData *SkeletonJson::readJsonInSitu(char *json) {
+	LazyAnimations *lazyAnimations = NULL;
+	if (_lazyAnimations) {
+		lazyAnimations = new(__FILE__, __LINE__) LazyAnimations(_scale, _bezierTolerance);
+		if (!lazyAnimations->cut(json)) {
+			delete lazyAnimations;
+			setError(NULL, "Invalid skeleton JSON: ", "malformed animations");
+			return NULL;
+		}
+	}
+	Json *root;
+	{
+		// The document only lives while reading, keep it out of an arena collecting the skeleton data.
+		ArenaExtension::Scope scope(NULL);
+		root = new(__FILE__, __LINE__) Json(json, true);
+	}
+	return readJson(root, lazyAnimations);
+}
+
+SkeletonData *SkeletonJson::readJson(Json *root, LazyAnimations *lazyAnimations) {
 	int i, ii;
 	SkeletonData *skeletonData;
-	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
+	Json *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
 
 	_error = "";
 	_linkedMeshes.clear();
 
-	root = new(__FILE__, __LINE__) Json(json);
-
 	if (!root) {
+		delete lazyAnimations;
 		setError(NULL, "Invalid skeleton JSON: ", Json::getError());
 		return NULL;
 	}
 
 	skeletonData = new(__FILE__, __LINE__) SkeletonData();
+	if (lazyAnimations) {
+		skeletonData->_animationDecoder = lazyAnimations;
+		lazyAnimations->setSkeletonData(skeletonData);
+	}
 
 	skeleton = Json::getItem(root, "skeleton");
 	if (skeleton) {
@@ -709,20 +882,36 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		Json *animationMap;
 		skeletonData->_animations.ensureCapacity(animations->_size);
 		skeletonData->_animations.setSize(animations->_size, 0);
-		int animationsIndex = 0;
-		for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next) {
-			Animation *animation = readAnimation(animationMap, skeletonData);
-			if (!animation) {
+		if (lazyAnimations) {
+			assert(lazyAnimations->getDurationCount() == (size_t) animations->_size);
+			int animationsIndex = 0;
+			for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next, ++animationsIndex) {
+				skeletonData->_animations[animationsIndex] = new(__FILE__, __LINE__) Animation(String(animationMap->_name),
+					lazyAnimations->getDuration(animationsIndex), *lazyAnimations, animationsIndex);
+			}
+		} else if (_threadPool && animations->_size > 1) {
+			if (!readAnimations(animations, skeletonData)) {
 				delete skeletonData;
 				delete root;
 				return NULL;
 			}
-			skeletonData->_animations[animationsIndex++] = animation;
+		} else {
+			int animationsIndex = 0;
+			for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next) {
+				Animation *animation = readAnimation(animationMap, skeletonData);
+				if (!animation) {
+					delete skeletonData;
+					delete root;
+					return NULL;
+				}
+				skeletonData->_animations[animationsIndex++] = animation;
+			}
 		}
 	}
 
 	delete root;
 
+	skeletonData->internAttachmentNames();
 	return skeletonData;
 }
 
@@ -754,13 +943,20 @@ void SkeletonJson::readCurve(Json *frame, CurveTimeline *timeline, size_t frameI
 		float c2 = Json::getFloat(frame, "c2", 0);
 		float c3 = Json::getFloat(frame, "c3", 1);
 		float c4 = Json::getFloat(frame, "c4", 1);
+		timeline->setBezierTolerance(_bezierTolerance);
 		timeline->setCurve(frameIndex, c1, c2, c3, c4);
 	}
 }
 
 Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	Vector<Timeline *> timelines;
-	float duration = 0;
+	float duration;
+	if (!readTimelines(root, skeletonData, timelines, duration)) return NULL;
+	return new(__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+}
+
+bool SkeletonJson::readTimelines(Json *root, SkeletonData *skeletonData, Vector<Timeline *> &timelines, float &duration) {
+	duration = 0;
 
 	size_t frameIndex;
 	Json *valueMap;
@@ -805,7 +1001,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		if (slotIndex == -1) {
 			ContainerUtil::cleanUpVectorOfPointers(timelines);
 			setError(NULL, "Slot not found: ", slotMap->_name);
-			return NULL;
+			return false;
 		}
 
 		for (timelineMap = slotMap->_child; timelineMap; timelineMap = timelineMap->_next) {
@@ -857,7 +1053,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 			} else {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
 				setError(NULL, "Invalid timeline type for a slot: ", timelineMap->_name);
-				return NULL;
+				return false;
 			}
 		}
 	}
@@ -870,7 +1066,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		if (boneIndex == -1) {
 			ContainerUtil::cleanUpVectorOfPointers(timelines);
 			setError(NULL, "Bone not found: ", boneMap->_name);
-			return NULL;
+			return false;
 		}
 
 		for (timelineMap = boneMap->_child; timelineMap; timelineMap = timelineMap->_next) {
@@ -917,7 +1113,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				} else {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError(NULL, "Invalid timeline type for a bone: ", timelineMap->_name);
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -976,7 +1172,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		if (!data) {
 			ContainerUtil::cleanUpVectorOfPointers(timelines);
 			setError(NULL, "Path constraint not found: ", constraintMap->_name);
-			return NULL;
+			return false;
 		}
 
 		for (i = 0; i < skeletonData->_pathConstraints.size(); i++) {
@@ -1046,7 +1242,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError(NULL, "Attachment not found: ", timelineMap->_name);
-					return NULL;
+					return false;
 				}
 
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
@@ -1125,7 +1321,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 					if (slotIndex == -1) {
 						ContainerUtil::cleanUpVectorOfPointers(timelines);
 						setError(NULL, "Slot not found: ", Json::getString(offsetMap, "slot", 0));
-						return NULL;
+						return false;
 					}
 					/* Collect unchanged items. */
 					while (originalIndex != (size_t)slotIndex)
@@ -1158,7 +1354,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 			if (!eventData) {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
 				setError(NULL, "Event not found: ", Json::getString(valueMap, "name", 0));
-				return NULL;
+				return false;
 			}
 
 			event = new(__FILE__, __LINE__) Event(Json::getFloat(valueMap, "time", 0), *eventData);
@@ -1176,7 +1372,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		duration = MathUtil::max(duration, timeline->_frames[events->_size - 1]);
 	}
 
-	return new(__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+	return true;
 }
 
 void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength) {
@@ -1220,9 +1416,35 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
+	attachment->packWeights();
+}
+
+bool SkeletonJson::readAnimations(Json *animations, SkeletonData *skeletonData) {
+	Vector<Json *> animationMaps;
+	animationMaps.ensureCapacity(animations->_size);
+	for (Json *animationMap = animations->_child; animationMap; animationMap = animationMap->_next)
+		animationMaps.add(animationMap);
+
+	// The threads only look names up.
+	skeletonData->updateNameIndices();
+
+	ReadAnimationsTask task(*this, animationMaps, *skeletonData);
+	_threadPool->run(task, animationMaps.size());
+
+	for (size_t i = 0, n = animationMaps.size(); i < n; ++i) {
+		if (!skeletonData->_animations[i]) {
+			// Read the first failed animation again, so the error does not depend on the order the threads failed in.
+			readAnimation(animationMaps[i], skeletonData);
+			return false;
+		}
+	}
+	return true;
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
-	_error = String(value1).append(value2);
+	{
+		std::lock_guard<std::mutex> lock(errorMutex);
+		_error = String(value1).append(value2);
+	}
 	delete root;
 }
@@ -53,7 +53,7 @@ static void disposeAttachment(Attachment* attachment) {
 	if (attachment->getRefCount() == 0) delete attachment;
 }
 
-void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, Attachment *attachment) {
+void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, Attachment *attachment, int nameId) {
 	if (slotIndex >= _buckets.size())
 		_buckets.setSize(slotIndex + 1, Vector<Entry>());
 	Vector<Entry> &bucket = _buckets[slotIndex];
@@ -62,8 +62,9 @@ void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, At
 	if (existing >= 0) {
 		disposeAttachment(bucket[existing]._attachment);
 		bucket[existing]._attachment = attachment;
+		if (nameId != -1) bucket[existing]._nameId = nameId;
 	} else {
-		bucket.add(Entry(slotIndex, attachmentName, attachment));
+		bucket.add(Entry(slotIndex, attachmentName, attachment, nameId));
 	}
 }
 
@@ -73,6 +74,21 @@ Attachment *Skin::AttachmentMap::get(size_t slotIndex, const String &attachmentN
 	return existing >= 0 ? _buckets[slotIndex][existing]._attachment : NULL;
 }
 
+Attachment *Skin::AttachmentMap::get(size_t slotIndex, int nameId, const String &attachmentName) {
+	if (slotIndex >= _buckets.size()) return NULL;
+	Vector<Entry> &bucket = _buckets[slotIndex];
+	if (nameId != -1) {
+		bool resolved = true;
+		for (size_t i = 0; i < bucket.size(); i++) {
+			if (bucket[i]._nameId == nameId) return bucket[i]._attachment;
+			if (bucket[i]._nameId == -1) resolved = false;
+		}
+		if (resolved) return NULL;
+	}
+	int existing = findInBucket(bucket, attachmentName);
+	return existing >= 0 ? bucket[existing]._attachment : NULL;
+}
+
 void Skin::AttachmentMap::remove(size_t slotIndex, const String &attachmentName) {
 	if (slotIndex >= _buckets.size()) return;
 	int existing = findInBucket(_buckets[slotIndex], attachmentName);
@@ -113,6 +129,10 @@ Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 	return _attachments.get(slotIndex, name);
 }
 
+Attachment *Skin::getAttachment(size_t slotIndex, int nameId, const String &name) {
+	return _attachments.get(slotIndex, nameId, name);
+}
+
 void Skin::removeAttachment(size_t slotIndex, const String& name) {
 	_attachments.remove(slotIndex, name);
 }
@@ -152,7 +172,7 @@ void Skin::attachAll(Skeleton &skeleton, Skin &oldSkin) {
 		Slot *slot = slots[slotIndex];
 
 		if (slot->getAttachment() == entry._attachment) {
-			Attachment *attachment = getAttachment(slotIndex, entry._name);
+			Attachment *attachment = getAttachment(slotIndex, entry._nameId, entry._name);
 			if (attachment) slot->setAttachment(attachment);
 		}
 	}
@@ -168,7 +188,7 @@ void Skin::addSkin(Skin* other) {
 	AttachmentMap::Entries entries = other->getAttachments();
 	while(entries.hasNext()) {
 		AttachmentMap::Entry& entry = entries.next();
-		setAttachment(entry._slotIndex, entry._name, entry._attachment);
+		_attachments.put(entry._slotIndex, entry._name, entry._attachment, entry._nameId);
 	}
 }
 
@@ -183,9 +203,9 @@ void Skin::copySkin(Skin* other) {
 	while(entries.hasNext()) {
 		AttachmentMap::Entry& entry = entries.next();
 		if (entry._attachment->getRTTI().isExactly(MeshAttachment::rtti))
-			setAttachment(entry._slotIndex, entry._name, static_cast<MeshAttachment*>(entry._attachment)->newLinkedMesh());
+			_attachments.put(entry._slotIndex, entry._name, static_cast<MeshAttachment*>(entry._attachment)->newLinkedMesh(), entry._nameId);
 		else
-			setAttachment(entry._slotIndex, entry._name, entry._attachment->copy());
+			_attachments.put(entry._slotIndex, entry._name, entry._attachment->copy(), entry._nameId);
 	}
 }
 
@@ -59,7 +59,7 @@ void Slot::setToSetupPose() {
 	const String &attachmentName = _data.getAttachmentName();
 	if (attachmentName.length() > 0) {
 		_attachment = NULL;
-		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName));
+		setAttachment(_skeleton.getAttachment(_data.getIndex(), _data.getAttachmentNameId(), attachmentName));
 	} else {
 		setAttachment(NULL);
 	}
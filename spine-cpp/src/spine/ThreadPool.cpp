@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/ThreadPool.h>
+
+using namespace spine;
+
+ThreadPool::Task::~Task() {
+}
+
+ThreadPool::ThreadPool(int threadCount) : _task(NULL), _count(0), _next(0), _active(0), _generation(0), _stop(false) {
+	if (threadCount <= 0) threadCount = (int) std::thread::hardware_concurrency();
+	for (int i = 1; i < threadCount; ++i)
+		_workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (size_t i = 0; i < _workers.size(); ++i)
+		_workers[i].join();
+}
+
+int ThreadPool::getThreadCount() {
+	return (int) _workers.size() + 1;
+}
+
+void ThreadPool::run(Task &task, size_t count) {
+	std::lock_guard<std::mutex> runLock(_runMutex);
+	if (count == 0) return;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		_count = count;
+		_next = 0;
+		_active = _workers.size();
+		++_generation;
+	}
+	_wake.notify_all();
+
+	runIndices(task, count);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (_active > 0)
+		_done.wait(lock);
+	_task = NULL;
+}
+
+void ThreadPool::work() {
+	unsigned int generation = 0;
+	for (;;) {
+		Task *task;
+		size_t count;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (!_stop && _generation == generation)
+				_wake.wait(lock);
+			if (_stop) return;
+			generation = _generation;
+			task = _task;
+			count = _count;
+		}
+
+		runIndices(*task, count);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_active == 0) _done.notify_one();
+	}
+}
+
+void ThreadPool::runIndices(Task &task, size_t count) {
+	for (size_t index = _next++; index < count; index = _next++)
+		task.run(index);
+}
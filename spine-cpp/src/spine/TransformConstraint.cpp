@@ -156,7 +156,8 @@ void TransformConstraint::applyAbsoluteWorld() {
 				r += MathUtil::Pi_2;
 
 			r *= rotateMix;
-			float cos = MathUtil::cos(r), sin = MathUtil::sin(r);
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -197,8 +198,10 @@ void TransformConstraint::applyAbsoluteWorld() {
 
 			r = by + (r + offsetShearY) * shearMix;
 			float s = MathUtil::sqrt(b * b + d * d);
-			bone._b = MathUtil::cos(r) * s;
-			bone._d = MathUtil::sin(r) * s;
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
+			bone._b = cos * s;
+			bone._d = sin * s;
 			modified = true;
 		}
 
@@ -227,7 +230,8 @@ void TransformConstraint::applyRelativeWorld() {
 				r += MathUtil::Pi_2;
 
 			r *= rotateMix;
-			float cos = MathUtil::cos(r), sin = MathUtil::sin(r);
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -263,8 +267,10 @@ void TransformConstraint::applyRelativeWorld() {
 			float b = bone._b, d = bone._d;
 			r = MathUtil::atan2(d, b) + (r - MathUtil::Pi / 2 + offsetShearY) * shearMix;
 			float s = MathUtil::sqrt(b * b + d * d);
-			bone._b = MathUtil::cos(r) * s;
-			bone._d = MathUtil::sin(r) * s;
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
+			bone._b = cos * s;
+			bone._d = sin * s;
 			modified = true;
 		}
 
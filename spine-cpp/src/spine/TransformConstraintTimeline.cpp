@@ -65,7 +65,7 @@ TransformConstraintTimeline::TransformConstraintTimeline(int frameCount) : Curve
 }
 
 void TransformConstraintTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents,
-										float alpha, MixBlend blend, MixDirection direction) {
+										float alpha, MixBlend blend, MixDirection direction, int *cursor) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
@@ -103,7 +103,7 @@ void TransformConstraintTimeline::apply(Skeleton &skeleton, float lastTime, floa
 		shear = _frames[i + PREV_SHEAR];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, cursor);
 		rotate = _frames[frame + PREV_ROTATE];
 		translate = _frames[frame + PREV_TRANSLATE];
 		scale = _frames[frame + PREV_SCALE];
@@ -61,7 +61,7 @@ TranslateTimeline::~TranslateTimeline() {
 }
 
 void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int *cursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -92,7 +92,7 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 		y = _frames[_frames.size() + PREV_Y];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, cursor);
 		x = _frames[frame + PREV_X];
 		y = _frames[frame + PREV_Y];
 		float frameTime = _frames[frame];
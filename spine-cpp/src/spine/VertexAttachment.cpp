@@ -37,15 +37,18 @@
 
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
+#include <spine/WeightedVertices.h>
 
 using namespace spine;
 
 RTTI_IMPL(VertexAttachment, Attachment)
 
-VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0), _deformAttachment(this), _id(getNextID()) {
+VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0), _deformAttachment(this), _id(getNextID()),
+	_weightedVertices(NULL) {
 }
 
 VertexAttachment::~VertexAttachment() {
+	delete _weightedVertices;
 }
 
 void VertexAttachment::computeWorldVertices(Slot &slot, Vector<float> &worldVertices) {
@@ -82,6 +85,14 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		return;
 	}
 
+	if (_weightedVertices && start == 0 && count == offset + (_worldVerticesLength >> 1) * stride &&
+		_weightedVertices->matches(bones, *vertices) &&
+		(deformArray->size() == 0 || deformArray->size() >= _weightedVertices->getDeformLength())) {
+		const float *deform = deformArray->size() == 0 ? NULL : deformArray->buffer();
+		_weightedVertices->computeWorldVertices(skeleton.getBones(), deform, worldVertices, offset, stride);
+		return;
+	}
+
 	int v = 0, skip = 0;
 	for (size_t i = 0; i < start; i += 2) {
 		int n = bones[v];
@@ -166,4 +177,10 @@ void VertexAttachment::copyTo(VertexAttachment* other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_deformAttachment = this->_deformAttachment;
+	other->packWeights();
+}
+
+void VertexAttachment::packWeights() {
+	delete _weightedVertices;
+	_weightedVertices = WeightedVertices::create(_bones, _vertices);
 }
@@ -52,7 +52,7 @@ void JitterVertexEffect::transform(float &x, float &y, float &u, float &v, Color
 	float jitterX = _jitterX;
 	float jitterY = _jitterY;
 	x += MathUtil::randomTriangular(-jitterX, jitterX);
-	y += MathUtil::randomTriangular(-jitterX, jitterY);
+	y += MathUtil::randomTriangular(-jitterY, jitterY);
 }
 
 void JitterVertexEffect::end() {
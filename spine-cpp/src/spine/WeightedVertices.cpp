@@ -0,0 +1,298 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/WeightedVertices.h>
+
+#include <spine/Bone.h>
+#include <spine/MathUtil.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPINE_WEIGHTED_VERTICES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPINE_WEIGHTED_VERTICES_NEON
+#endif
+
+using namespace spine;
+
+namespace {
+#if defined(SPINE_WEIGHTED_VERTICES_SSE2)
+	typedef __m128 Float4;
+
+	inline Float4 load4(const float *p) { return _mm_loadu_ps(p); }
+	inline Float4 set4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	inline Float4 zero4() { return _mm_setzero_ps(); }
+	inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline void store4(float *p, Float4 v) { _mm_storeu_ps(p, v); }
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+#elif defined(SPINE_WEIGHTED_VERTICES_NEON)
+	typedef float32x4_t Float4;
+
+	inline Float4 load4(const float *p) { return vld1q_f32(p); }
+	inline Float4 set4(float x, float y, float z, float w) {
+		float values[4] = {x, y, z, w};
+		return vld1q_f32(values);
+	}
+	inline Float4 zero4() { return vdupq_n_f32(0); }
+	inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline void store4(float *p, Float4 v) { vst1q_f32(p, v); }
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) {
+		float32x4x2_t t01 = vtrnq_f32(r0, r1), t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+#else
+	struct Float4 {
+		float v[4];
+	};
+
+	inline Float4 load4(const float *p) {
+		Float4 r = {{p[0], p[1], p[2], p[3]}};
+		return r;
+	}
+	inline Float4 set4(float x, float y, float z, float w) {
+		Float4 r = {{x, y, z, w}};
+		return r;
+	}
+	inline Float4 zero4() { return set4(0, 0, 0, 0); }
+	inline Float4 add4(Float4 a, Float4 b) { return set4(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]); }
+	inline Float4 mul4(Float4 a, Float4 b) { return set4(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]); }
+	inline void store4(float *p, Float4 v) {
+		p[0] = v.v[0];
+		p[1] = v.v[1];
+		p[2] = v.v[2];
+		p[3] = v.v[3];
+	}
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) {
+		Float4 c0 = set4(r0.v[0], r1.v[0], r2.v[0], r3.v[0]), c1 = set4(r0.v[1], r1.v[1], r2.v[1], r3.v[1]);
+		Float4 c2 = set4(r0.v[2], r1.v[2], r2.v[2], r3.v[2]), c3 = set4(r0.v[3], r1.v[3], r2.v[3], r3.v[3]);
+		r0 = c0;
+		r1 = c1;
+		r2 = c2;
+		r3 = c3;
+	}
+#endif
+
+	/// Floats per gathered bone: a, b, c, d, worldX, worldY and two of padding, so both halves load as one vector.
+	const int MATRIX_SIZE = 8;
+
+	/// Skins blocks of four vertices with INFLUENCES influences each, or influences of them if INFLUENCES is 0.
+	template<int INFLUENCES, bool DEFORM>
+	void skin(const int *outputs, const float *values, const int *indices, int blocks, int influences, const float *matrices,
+			  const float *deform, float *worldVertices, size_t offset, size_t stride) {
+		if (INFLUENCES) influences = INFLUENCES;
+		for (int i = 0; i < blocks; i++, outputs += 4) {
+			Float4 wx = zero4(), wy = zero4();
+			for (int j = 0; j < influences; j++, values += 12, indices += 8) {
+				Float4 vx = load4(values), vy = load4(values + 4), weight = load4(values + 8);
+				if (DEFORM) {
+					const int *f = indices + 4;
+					vx = add4(vx, set4(deform[f[0]], deform[f[1]], deform[f[2]], deform[f[3]]));
+					vy = add4(vy, set4(deform[f[0] + 1], deform[f[1] + 1], deform[f[2] + 1], deform[f[3] + 1]));
+				}
+				const float *m0 = matrices + indices[0] * MATRIX_SIZE, *m1 = matrices + indices[1] * MATRIX_SIZE;
+				const float *m2 = matrices + indices[2] * MATRIX_SIZE, *m3 = matrices + indices[3] * MATRIX_SIZE;
+				Float4 a = load4(m0), b = load4(m1), c = load4(m2), d = load4(m3);
+				transpose4(a, b, c, d);
+				Float4 x = load4(m0 + 4), y = load4(m1 + 4), unused0 = load4(m2 + 4), unused1 = load4(m3 + 4);
+				transpose4(x, y, unused0, unused1);
+				wx = add4(wx, mul4(add4(add4(mul4(vx, a), mul4(vy, b)), x), weight));
+				wy = add4(wy, mul4(add4(add4(mul4(vx, c), mul4(vy, d)), y), weight));
+			}
+			float xs[4], ys[4];
+			store4(xs, wx);
+			store4(ys, wy);
+			for (int l = 0; l < 4; l++) {
+				float *output = worldVertices + offset + outputs[l] * stride;
+				output[0] = xs[l];
+				output[1] = ys[l];
+			}
+		}
+	}
+
+	template<bool DEFORM>
+	void skinRun(int influences, const int *outputs, const float *values, const int *indices, int blocks,
+				 const float *matrices, const float *deform, float *worldVertices, size_t offset, size_t stride) {
+		switch (influences) {
+			case 1:
+				skin<1, DEFORM>(outputs, values, indices, blocks, 1, matrices, deform, worldVertices, offset, stride);
+				break;
+			case 2:
+				skin<2, DEFORM>(outputs, values, indices, blocks, 2, matrices, deform, worldVertices, offset, stride);
+				break;
+			case 3:
+				skin<3, DEFORM>(outputs, values, indices, blocks, 3, matrices, deform, worldVertices, offset, stride);
+				break;
+			default:
+				skin<0, DEFORM>(outputs, values, indices, blocks, influences, matrices, deform, worldVertices, offset, stride);
+		}
+	}
+}
+
+WeightedVertices::WeightedVertices() : _bonesLength(0), _verticesLength(0) {
+}
+
+WeightedVertices *WeightedVertices::create(Vector<size_t> &bones, Vector<float> &vertices) {
+	if (bones.size() == 0) return NULL;
+
+	// Per vertex the index of its count in bones and of its first influence.
+	Vector<int> starts, firsts;
+	int maxInfluences = 0, maxBone = -1;
+	for (size_t i = 0, influence = 0, n = bones.size(); i < n; influence += bones[i], i += bones[i] + 1) {
+		int count = (int) bones[i];
+		if (i + count >= n || (influence + count) * 3 > vertices.size()) return NULL;
+		starts.add((int) i);
+		firsts.add((int) influence);
+		if (count > maxInfluences) maxInfluences = count;
+		for (int ii = 1; ii <= count; ii++)
+			if ((int) bones[i + ii] > maxBone) maxBone = (int) bones[i + ii];
+	}
+
+	WeightedVertices *packed = new(__FILE__, __LINE__) WeightedVertices();
+	packed->_bonesLength = bones.size();
+	packed->_verticesLength = vertices.size();
+
+	Vector<int> gathered;
+	gathered.setSize(maxBone + 1, -1);
+	for (size_t i = 0, n = bones.size(); i < n; i += bones[i] + 1) {
+		for (size_t ii = 1; ii <= bones[i]; ii++) {
+			int &local = gathered[bones[i + ii]];
+			if (local != -1) continue;
+			local = (int) packed->_skeletonBones.size();
+			packed->_skeletonBones.add((int) bones[i + ii]);
+		}
+	}
+	if (packed->_skeletonBones.size() > MAX_BONES) {
+		delete packed;
+		return NULL;
+	}
+
+	// Vertices by influence count, stable. 1, 2 and 3 influences form their own blocks, the rest share blocks in ascending
+	// order so each block pads to the count of its last vertex.
+	Vector<int> order;
+	order.ensureCapacity(starts.size());
+	for (int influences = 0; influences <= maxInfluences; influences++) {
+		for (size_t v = 0, n = starts.size(); v < n; v++)
+			if ((int) bones[starts[v]] == influences) order.add((int) v);
+	}
+
+	for (size_t i = 0, n = order.size(); i < n;) {
+		int segment = MathUtil::min((int) bones[starts[order[i]]], 4);
+		size_t end = i;
+		while (end < n && MathUtil::min((int) bones[starts[order[end]]], 4) == segment)
+			end++;
+		for (size_t first = i; first < end; first += 4) {
+			int lanes[4];
+			for (int l = 0; l < 4; l++)
+				lanes[l] = order[first + l < end ? first + l : first];
+			int influences = (int) bones[starts[order[MathUtil::min(first + 4, end) - 1]]];
+
+			size_t runs = packed->_runs.size();
+			if (runs > 0 && packed->_runs[runs - 2] == influences)
+				packed->_runs[runs - 1]++;
+			else {
+				packed->_runs.add(influences);
+				packed->_runs.add(1);
+			}
+
+			for (int l = 0; l < 4; l++)
+				packed->_outputs.add(lanes[l]);
+			for (int j = 0; j < influences; j++) {
+				for (int field = 0; field < 3; field++) {
+					for (int l = 0; l < 4; l++) {
+						int v = lanes[l];
+						bool used = j < (int) bones[starts[v]];
+						packed->_values.add(used ? vertices[(firsts[v] + j) * 3 + field] : 0);
+					}
+				}
+				for (int l = 0; l < 4; l++) {
+					int v = lanes[l];
+					bool used = j < (int) bones[starts[v]];
+					packed->_indices.add(used ? gathered[bones[starts[v] + 1 + j]] : 0);
+				}
+				for (int l = 0; l < 4; l++) {
+					int v = lanes[l];
+					bool used = j < (int) bones[starts[v]];
+					packed->_indices.add(used ? (firsts[v] + j) * 2 : 0);
+				}
+			}
+		}
+		i = end;
+	}
+	return packed;
+}
+
+void WeightedVertices::computeWorldVertices(Vector<Bone *> &skeletonBones, const float *deform, float *worldVertices,
+											size_t offset, size_t stride) {
+	float matrices[MAX_BONES * MATRIX_SIZE];
+	for (size_t i = 0, n = _skeletonBones.size(); i < n; i++) {
+		Bone &bone = *skeletonBones[_skeletonBones[i]];
+		float *matrix = matrices + i * MATRIX_SIZE;
+		matrix[0] = bone._a;
+		matrix[1] = bone._b;
+		matrix[2] = bone._c;
+		matrix[3] = bone._d;
+		matrix[4] = bone._worldX;
+		matrix[5] = bone._worldY;
+		matrix[6] = 0;
+		matrix[7] = 0;
+	}
+
+	const int *outputs = _outputs.buffer();
+	const float *values = _values.buffer();
+	const int *indices = _indices.buffer();
+	for (size_t i = 0, n = _runs.size(); i < n; i += 2) {
+		int influences = _runs[i], blocks = _runs[i + 1];
+		if (deform)
+			skinRun<true>(influences, outputs, values, indices, blocks, matrices, deform, worldVertices, offset, stride);
+		else
+			skinRun<false>(influences, outputs, values, indices, blocks, matrices, NULL, worldVertices, offset, stride);
+		outputs += blocks * 4;
+		values += blocks * influences * 12;
+		indices += blocks * influences * 8;
+	}
+}
+
+bool WeightedVertices::matches(Vector<size_t> &bones, Vector<float> &vertices) {
+	return _bonesLength == bones.size() && _verticesLength == vertices.size();
+}
+
+size_t WeightedVertices::getDeformLength() {
+	return _verticesLength / 3 * 2;
+}
@@ -33,9 +33,18 @@
 #include <QOpenGLContext>
 #include <QSGTexture>
 #include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
 #include <QColor>
 
 #include "spineitem.h"
+#include "skinnedmesh.h"
+
+struct RenderCmdsCache::MeshBuffers
+{
+    QWeakPointer<StaticMesh> mesh;
+    QOpenGLBuffer vertexBuffer = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    QOpenGLBuffer indexBuffer = QOpenGLBuffer(QOpenGLBuffer::IndexBuffer);
+};
 
 void ICachedGLFunctionCall::release()
 {
@@ -198,6 +207,164 @@ private:
     float m_light = 1.0;
 };
 
+class DrawStaticTriangles: public ICachedGLFunctionCall
+{
+public:
+    explicit DrawStaticTriangles(RenderCmdsCache* cache,
+                                 QOpenGLShaderProgram* program,
+                                 QSGTexture* texture,
+                                 const QSharedPointer<StaticMesh>& mesh,
+                                 const spine::Vector<float>& positions,
+                                 const spine::Color& color,
+                                 QColor blendColor,
+                                 int blendColorChannel,
+                                 float light)
+        :mCache(cache)
+        ,mShaderProgram(program)
+        ,mTexture(texture)
+        ,m_mesh(mesh)
+        ,m_color(color)
+        ,m_blendColor(blendColor)
+        ,m_blendColorChannel(blendColorChannel)
+        ,m_light(light)
+    {
+        m_positions.setSize(positions.size(), 0);
+        memcpy(m_positions.buffer(), positions.buffer(), sizeof(float) * positions.size());
+    }
+
+    virtual ~DrawStaticTriangles()
+    {
+    }
+
+    virtual void invoke()
+    {
+        auto buffers = mCache->meshBuffers(m_mesh);
+        if (!buffers)
+            return;
+
+        if (mTexture)
+            mTexture->bind();
+
+        // positions are the only streamed attribute, uvs and indices come from the static buffers.
+        mShaderProgram->setAttributeArray("a_position", GL_FLOAT, m_positions.buffer(), 2, 2 * sizeof(float));
+        mShaderProgram->disableAttributeArray("a_color");
+        mShaderProgram->setAttributeValue("a_color", m_color.r, m_color.g, m_color.b, m_color.a);
+        mShaderProgram->setUniformValue("u_blendColor", m_blendColor.redF(), m_blendColor.greenF(), m_blendColor.blueF(), m_blendColor.alphaF());
+        mShaderProgram->setUniformValue("u_blendColorChannel", m_blendColorChannel);
+        mShaderProgram->setUniformValue("u_light", m_light);
+
+        buffers->vertexBuffer.bind();
+        mShaderProgram->setAttributeBuffer("a_texCoord", GL_FLOAT, 0, 2, 2 * sizeof(float));
+        buffers->vertexBuffer.release();
+        buffers->indexBuffer.bind();
+        glFuncs()->glDrawElements(GL_TRIANGLES, m_mesh->indices().size(), GL_UNSIGNED_SHORT, nullptr);
+        buffers->indexBuffer.release();
+
+        // following DrawTrigngles read per vertex colors again.
+        mShaderProgram->enableAttributeArray("a_color");
+    }
+
+private:
+    RenderCmdsCache* mCache;
+    QOpenGLShaderProgram* mShaderProgram;
+    QSGTexture* mTexture;
+    QSharedPointer<StaticMesh> m_mesh;
+    spine::Vector<float> m_positions;
+    spine::Color m_color;
+    QColor m_blendColor = QColor(255, 255, 255, 255);
+    GLint m_blendColorChannel = -1;
+    float m_light = 1.0;
+};
+
+class DrawSkinnedTriangles: public ICachedGLFunctionCall
+{
+public:
+    explicit DrawSkinnedTriangles(RenderCmdsCache* cache,
+                                  QOpenGLShaderProgram* program,
+                                  QOpenGLShaderProgram* textureProgram,
+                                  const QRectF& rect,
+                                  QSGTexture* texture,
+                                  const QSharedPointer<SkinnedMesh>& mesh,
+                                  const spine::Vector<float>& boneRows,
+                                  const spine::Color& color,
+                                  QColor blendColor,
+                                  int blendColorChannel,
+                                  float light)
+        :mCache(cache)
+        ,mShaderProgram(program)
+        ,mRestoreShader(textureProgram, rect)
+        ,mRect(rect)
+        ,mTexture(texture)
+        ,m_mesh(mesh)
+        ,m_color(color)
+        ,m_blendColor(blendColor)
+        ,m_blendColorChannel(blendColorChannel)
+        ,m_light(light)
+    {
+        m_boneRows.setSize(boneRows.size(), 0);
+        memcpy(m_boneRows.buffer(), boneRows.buffer(), sizeof(float) * boneRows.size());
+    }
+
+    virtual ~DrawSkinnedTriangles()
+    {
+    }
+
+    virtual void invoke()
+    {
+        auto buffers = mCache->meshBuffers(m_mesh);
+        if (!buffers)
+            return;
+
+        if (mTexture)
+            mTexture->bind();
+
+        QMatrix4x4 matrix;
+        matrix.ortho(mRect);
+        mShaderProgram->bind();
+        mShaderProgram->setUniformValue("u_matrix", matrix);
+        mShaderProgram->setUniformValueArray("u_bones", m_boneRows.buffer(), int(m_boneRows.size() / 4), 4);
+        mShaderProgram->setUniformValue("u_blendColor", m_blendColor.redF(), m_blendColor.greenF(), m_blendColor.blueF(), m_blendColor.alphaF());
+        mShaderProgram->setUniformValue("u_blendColorChannel", m_blendColorChannel);
+        mShaderProgram->setUniformValue("u_light", m_light);
+
+        // the tint is constant per attachment, a disabled array feeds it as a generic attribute.
+        mShaderProgram->disableAttributeArray("a_color");
+        mShaderProgram->setAttributeValue("a_color", m_color.r, m_color.g, m_color.b, m_color.a);
+
+        const int stride = SkinnedMesh::VertexStride * sizeof(float);
+        const char* attributes[] = {"a_texCoord", "a_boneIndices", "a_weights", "a_bindX", "a_bindY"};
+        const int offsets[] = {0, 2, 2 + SkinnedMesh::MaxInfluences, 2 + SkinnedMesh::MaxInfluences * 2, 2 + SkinnedMesh::MaxInfluences * 3};
+        const int sizes[] = {2, SkinnedMesh::MaxInfluences, SkinnedMesh::MaxInfluences, SkinnedMesh::MaxInfluences, SkinnedMesh::MaxInfluences};
+        buffers->vertexBuffer.bind();
+        for (int i = 0; i < 5; i++) {
+            mShaderProgram->setAttributeBuffer(attributes[i], GL_FLOAT, offsets[i] * int(sizeof(float)), sizes[i], stride);
+            mShaderProgram->enableAttributeArray(attributes[i]);
+        }
+        buffers->indexBuffer.bind();
+        glFuncs()->glDrawElements(GL_TRIANGLES, m_mesh->indices().size(), GL_UNSIGNED_SHORT, nullptr);
+        buffers->indexBuffer.release();
+        buffers->vertexBuffer.release();
+        for (int i = 0; i < 5; i++)
+            mShaderProgram->disableAttributeArray(attributes[i]);
+
+        // following commands expect the texture shader with client side arrays.
+        mRestoreShader.invoke();
+    }
+
+private:
+    RenderCmdsCache* mCache;
+    QOpenGLShaderProgram* mShaderProgram;
+    BindShader mRestoreShader;
+    QRectF mRect;
+    QSGTexture* mTexture;
+    QSharedPointer<SkinnedMesh> m_mesh;
+    spine::Vector<float> m_boneRows;
+    spine::Color m_color;
+    QColor m_blendColor = QColor(255, 255, 255, 255);
+    GLint m_blendColorChannel = -1;
+    float m_light = 1.0;
+};
+
 class DrawPolygon: public ICachedGLFunctionCall
 {
 public:
@@ -281,12 +448,16 @@ RenderCmdsCache::RenderCmdsCache(QObject *parent, SpineItem* spItem)
 RenderCmdsCache::~RenderCmdsCache()
 {
     clearCache();
+    // the mesh buffers are already released by the renderer, while its context was current.
     if(mTextureShaderProgram)
         delete mTextureShaderProgram;
     if(mColorShaderProgram)
         delete mColorShaderProgram;
+    if(mSkinShaderProgram)
+        delete mSkinShaderProgram;
     mTextureShaderProgram = nullptr;
     mColorShaderProgram = nullptr;
+    mSkinShaderProgram = nullptr;
 }
 
 void RenderCmdsCache::clearCache()
@@ -309,6 +480,23 @@ void RenderCmdsCache::drawTriangles(QSGTexture* addTexture, spine::Vector<SpineV
                                          blendColorChannel, light));
 }
 
+void RenderCmdsCache::drawStaticTriangles(QSGTexture *texture, const QSharedPointer<StaticMesh> &mesh,
+                                          const spine::Vector<float> &positions, const spine::Color &color,
+                                          const QColor &blendColor, const int &blendColorChannel, float light)
+{
+    mglFuncs.push_back(new DrawStaticTriangles(this, mTextureShaderProgram, texture, mesh, positions, color,
+                                               blendColor, blendColorChannel, light));
+}
+
+void RenderCmdsCache::drawSkinnedTriangles(QSGTexture *texture, const QSharedPointer<SkinnedMesh> &mesh,
+                                           const spine::Vector<float> &boneRows, const spine::Color &color,
+                                           const QColor &blendColor, const int &blendColorChannel, float light)
+{
+    mglFuncs.push_back(new DrawSkinnedTriangles(this, mSkinShaderProgram, mTextureShaderProgram, mRect,
+                                                texture, mesh, boneRows, color, blendColor,
+                                                blendColorChannel, light));
+}
+
 void RenderCmdsCache::blendFunc(GLenum sfactor, GLenum dfactor)
 {
     mglFuncs.push_back(new BlendFunction(sfactor, dfactor));
@@ -361,6 +549,8 @@ void RenderCmdsCache::render()
         return;
     }
 
+    releaseUnusedMeshBuffers();
+
     QOpenGLFunctions* glFuncs = QOpenGLContext::currentContext()->functions();
     glFuncs->glDisable(GL_DEPTH_TEST);
     glFuncs->glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -406,6 +596,13 @@ void RenderCmdsCache::initShaderProgram()
     res = mColorShaderProgram->link();
     if (!res)
         qDebug()<<"PolygonBatch::PolygonBatch texture shader program link error:"<<mColorShaderProgram->log();
+
+    mSkinShaderProgram = new QOpenGLShaderProgram();
+    m_skinningSupported = mSkinShaderProgram->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shader/skin.vert")
+            && mSkinShaderProgram->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shader/texture.frag")
+            && mSkinShaderProgram->link();
+    if (!m_skinningSupported)
+        qDebug()<<"RenderCmdsCache::initShaderProgram skin shader program unavailable, skinning on cpu:"<<mSkinShaderProgram->log();
     m_shaderInited = true;
 }
 
@@ -413,3 +610,55 @@ bool RenderCmdsCache::isValid()
 {
     return m_shaderInited;
 }
+
+bool RenderCmdsCache::skinningSupported()
+{
+    return m_skinningSupported;
+}
+
+RenderCmdsCache::MeshBuffers *RenderCmdsCache::meshBuffers(const QSharedPointer<StaticMesh> &mesh)
+{
+    auto it = m_meshBuffers.find(mesh.data());
+    if (it != m_meshBuffers.end()) {
+        if (it.value()->mesh == mesh)
+            return it.value();
+        // a released mesh whose address got reused.
+        delete it.value();
+        m_meshBuffers.erase(it);
+    }
+
+    auto buffers = new MeshBuffers;
+    buffers->mesh = mesh;
+    const auto& vertexData = mesh->vertexData();
+    const auto& indices = mesh->indices();
+    if (!buffers->vertexBuffer.create() || !buffers->indexBuffer.create()) {
+        delete buffers;
+        return nullptr;
+    }
+    buffers->vertexBuffer.bind();
+    buffers->vertexBuffer.allocate(vertexData.constData(), vertexData.size() * int(sizeof(float)));
+    buffers->vertexBuffer.release();
+    buffers->indexBuffer.bind();
+    buffers->indexBuffer.allocate(indices.constData(), indices.size() * int(sizeof(GLushort)));
+    buffers->indexBuffer.release();
+    m_meshBuffers.insert(mesh.data(), buffers);
+    return buffers;
+}
+
+void RenderCmdsCache::releaseMeshBuffers()
+{
+    qDeleteAll(m_meshBuffers);
+    m_meshBuffers.clear();
+}
+
+void RenderCmdsCache::releaseUnusedMeshBuffers()
+{
+    for (auto it = m_meshBuffers.begin(); it != m_meshBuffers.end();) {
+        if (it.value()->mesh.isNull()) {
+            delete it.value();
+            it = m_meshBuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -36,10 +36,14 @@
 #include <QList>
 #include <QObject>
 #include <QRectF>
+#include <QHash>
+#include <QSharedPointer>
 #include <QOpenGLFunctions>
 #include <spine/spine.h>
 
 class SpineItem;
+class StaticMesh;
+class SkinnedMesh;
 
 QT_FORWARD_DECLARE_CLASS(QSGTexture)
 QT_FORWARD_DECLARE_CLASS(QOpenGLShaderProgram)
@@ -92,6 +96,18 @@ public:
 
     void drawTriangles(QSGTexture* texture, spine::Vector<SpineVertex> vertices,
                        spine::Vector<GLushort> triangles, const QColor& blendColor, const int &blendColorChannel, float light);
+    /**
+     * @brief drawStaticTriangles Draws a region or mesh whose uvs and indices live in static buffers uploaded
+     * on first use, per frame only the world positions (x, y per vertex) and a single tint are sent.
+     */
+    void drawStaticTriangles(QSGTexture* texture, const QSharedPointer<StaticMesh>& mesh, const spine::Vector<float>& positions,
+                             const spine::Color& color, const QColor& blendColor, const int &blendColorChannel, float light);
+    /**
+     * @brief drawSkinnedTriangles Draws a weighted mesh skinned in shader/skin.vert, the bind pose lives in
+     * static buffers uploaded on first use and only the bone rows of SkinnedMesh::boneRows are sent per frame.
+     */
+    void drawSkinnedTriangles(QSGTexture* texture, const QSharedPointer<SkinnedMesh>& mesh, const spine::Vector<float>& boneRows,
+                              const spine::Color& color, const QColor& blendColor, const int &blendColorChannel, float light);
     void drawPoly(const Point* points, int pointCount);
     void drawLine(const Point& origin, const Point& destination);
     void drawPoint(const Point& point);
@@ -102,10 +118,27 @@ public:
     void initShaderProgram();
 
     bool isValid();
+    /**
+     * @brief skinningSupported False if the skinning shader did not build, weighted meshes are skinned on the cpu then.
+     */
+    bool skinningSupported();
+    /**
+     * @brief releaseMeshBuffers Deletes the static mesh buffers. Call on the render thread while the context they were
+     * created in is current, later draws upload them again.
+     */
+    void releaseMeshBuffers();
 
 signals:
     void cacheRendered();
 
+private:
+    struct MeshBuffers;
+    friend class DrawStaticTriangles;
+    friend class DrawSkinnedTriangles;
+
+    MeshBuffers* meshBuffers(const QSharedPointer<StaticMesh>& mesh);
+    void releaseUnusedMeshBuffers();
+
 private:
     QList<ICachedGLFunctionCall*> mglFuncs;
     QRectF mRect;
@@ -113,7 +146,10 @@ private:
     QSGTexture* mTexture;
     QOpenGLShaderProgram* mTextureShaderProgram = nullptr;
     QOpenGLShaderProgram* mColorShaderProgram = nullptr;
+    QOpenGLShaderProgram* mSkinShaderProgram = nullptr;
+    QHash<const StaticMesh*, MeshBuffers*> m_meshBuffers;
     bool m_shaderInited = false;
+    bool m_skinningSupported = false;
     SpineItem* m_spItem = nullptr;
 };
 
@@ -0,0 +1,28 @@
+uniform highp mat4 u_matrix;
+uniform highp vec4 u_bones[96]; // SkinnedMesh::MaxBones rows pairs: (a, b, worldX, 0), (c, d, worldY, 0)
+
+varying lowp vec4 v_color;
+varying mediump vec2 v_texCoord;
+
+attribute mediump vec2 a_texCoord;
+attribute highp vec4 a_boneIndices;
+attribute highp vec4 a_weights;
+attribute highp vec4 a_bindX;
+attribute highp vec4 a_bindY;
+attribute lowp vec4 a_color;
+
+highp vec2 skin(highp float boneIndex, highp float x, highp float y) {
+   int row = int(boneIndex + 0.5) * 2;
+   highp vec3 position = vec3(x, y, 1.0);
+   return vec2(dot(u_bones[row].xyz, position), dot(u_bones[row + 1].xyz, position));
+}
+
+void main() {
+   highp vec2 position = skin(a_boneIndices.x, a_bindX.x, a_bindY.x) * a_weights.x
+                       + skin(a_boneIndices.y, a_bindX.y, a_bindY.y) * a_weights.y
+                       + skin(a_boneIndices.z, a_bindX.z, a_bindY.z) * a_weights.z
+                       + skin(a_boneIndices.w, a_bindX.w, a_bindY.w) * a_weights.w;
+   gl_Position = u_matrix * vec4(position, 0.0, 1.0);
+   v_color = a_color;
+   v_texCoord = a_texCoord;
+}
@@ -11,6 +11,9 @@ SkeletonRenderer::SkeletonRenderer()
 
 SkeletonRenderer::~SkeletonRenderer()
 {
+    // destroyed on the render thread with the fbo context current, the buffers of the cache were created in it.
+    if(m_cache)
+        m_cache->releaseMeshBuffers();
 }
 
 QOpenGLFramebufferObject *SkeletonRenderer::createFramebufferObject(const QSize &size)
@@ -0,0 +1,136 @@
+#include "skinnedmesh.h"
+
+#include <float.h>
+#include <spine/spine.h>
+
+QSharedPointer<SkinnedMesh> SkinnedMesh::create(spine::MeshAttachment &mesh)
+{
+    spine::Vector<size_t>& bones = mesh.getBones();
+    spine::Vector<float>& vertices = mesh.getVertices();
+    spine::Vector<float>& uvs = mesh.getUVs();
+    spine::Vector<unsigned short>& triangles = mesh.getTriangles();
+    if (bones.size() == 0)
+        return QSharedPointer<SkinnedMesh>();
+
+    QSharedPointer<SkinnedMesh> skinned(new SkinnedMesh);
+    skinned->m_vertexCount = int(mesh.getWorldVerticesLength() / 2);
+    skinned->m_vertexData.fill(0, skinned->m_vertexCount * VertexStride);
+    QHash<size_t, int> paletteIndices;
+    for (int i = 0, v = 0, b = 0; i < skinned->m_vertexCount; i++) {
+        int influences = int(bones[size_t(v++)]);
+        if (influences > MaxInfluences)
+            return QSharedPointer<SkinnedMesh>();
+
+        float* vertex = skinned->m_vertexData.data() + i * VertexStride;
+        vertex[0] = uvs[size_t(i) * 2];
+        vertex[1] = uvs[size_t(i) * 2 + 1];
+        for (int j = 0; j < influences; j++, v++, b += 3) {
+            size_t bone = bones[size_t(v)];
+            auto palette = paletteIndices.find(bone);
+            if (palette == paletteIndices.end()) {
+                if (skinned->m_palette.size() == MaxBones)
+                    return QSharedPointer<SkinnedMesh>();
+                palette = paletteIndices.insert(bone, skinned->m_palette.size());
+                skinned->m_palette.append(int(bone));
+                skinned->m_boneBounds << FLT_MAX << FLT_MAX << -FLT_MAX << -FLT_MAX;
+            }
+            float x = vertices[size_t(b)], y = vertices[size_t(b) + 1];
+            vertex[2 + j] = palette.value();
+            vertex[2 + MaxInfluences + j] = vertices[size_t(b) + 2];
+            vertex[2 + MaxInfluences * 2 + j] = x;
+            vertex[2 + MaxInfluences * 3 + j] = y;
+
+            float* box = skinned->m_boneBounds.data() + palette.value() * 4;
+            box[0] = qMin(box[0], x);
+            box[1] = qMin(box[1], y);
+            box[2] = qMax(box[2], x);
+            box[3] = qMax(box[3], y);
+        }
+    }
+
+    skinned->m_indices.resize(int(triangles.size()));
+    memcpy(skinned->m_indices.data(), triangles.buffer(), triangles.size() * sizeof (GLushort));
+    return skinned;
+}
+
+void SkinnedMesh::boneRows(spine::Skeleton &skeleton, spine::Vector<float> &rows) const
+{
+    rows.setSize(size_t(m_palette.size()) * 8, 0);
+    float* row = rows.buffer();
+    for (int i = 0; i < m_palette.size(); i++, row += 8) {
+        spine::Bone* bone = skeleton.getBones()[size_t(m_palette[i])];
+        row[0] = bone->getA();
+        row[1] = bone->getB();
+        row[2] = bone->getWorldX();
+        row[4] = bone->getC();
+        row[5] = bone->getD();
+        row[6] = bone->getWorldY();
+    }
+}
+
+QRectF SkinnedMesh::bounds(const spine::Vector<float> &rows) const
+{
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (int i = 0; i < m_palette.size(); i++) {
+        const float* row = rows.buffer() + i * 8;
+        const float* box = m_boneBounds.constData() + i * 4;
+        const float corners[4][2] = {{box[0], box[1]}, {box[2], box[1]}, {box[2], box[3]}, {box[0], box[3]}};
+        for (const auto& corner: corners) {
+            float x = corner[0] * row[0] + corner[1] * row[1] + row[2];
+            float y = corner[0] * row[4] + corner[1] * row[5] + row[6];
+            minX = qMin(minX, x);
+            minY = qMin(minY, y);
+            maxX = qMax(maxX, x);
+            maxY = qMax(maxY, y);
+        }
+    }
+    if (minX > maxX)
+        return QRectF();
+    return QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+void SkinnedMesh::skin(const spine::Vector<float> &rows, const spine::Color &color,
+                       spine::Vector<SpineVertex> &vertices, spine::Vector<GLushort> &triangles) const
+{
+    vertices.setSize(size_t(m_vertexCount), SpineVertex());
+    for (int i = 0; i < m_vertexCount; i++) {
+        const float* vertex = m_vertexData.constData() + i * VertexStride;
+        float x = 0, y = 0;
+        for (int j = 0; j < MaxInfluences; j++) {
+            const float* row = rows.buffer() + int(vertex[2 + j]) * 8;
+            float weight = vertex[2 + MaxInfluences + j];
+            float bindX = vertex[2 + MaxInfluences * 2 + j], bindY = vertex[2 + MaxInfluences * 3 + j];
+            x += (bindX * row[0] + bindY * row[1] + row[2]) * weight;
+            y += (bindX * row[4] + bindY * row[5] + row[6]) * weight;
+        }
+        auto& out = vertices[size_t(i)];
+        out.x = x;
+        out.y = y;
+        out.u = vertex[0];
+        out.v = vertex[1];
+        out.color.set(color);
+    }
+    triangles.setSize(size_t(m_indices.size()), 0);
+    memcpy(triangles.buffer(), m_indices.constData(), size_t(m_indices.size()) * sizeof (GLushort));
+}
+
+QSharedPointer<SkinnedMesh> SkinnedMeshCache::mesh(spine::Slot &slot)
+{
+    auto* attachment = slot.getAttachment();
+    if (!attachment || !attachment->getRTTI().isExactly(spine::MeshAttachment::rtti))
+        return QSharedPointer<SkinnedMesh>();
+    // deform offsets change the bind pose every frame, those meshes stay on the cpu.
+    if (slot.getDeform().size() > 0)
+        return QSharedPointer<SkinnedMesh>();
+
+    auto* mesh = static_cast<spine::MeshAttachment*>(attachment);
+    auto it = m_meshes.find(mesh);
+    if (it == m_meshes.end())
+        it = m_meshes.insert(mesh, SkinnedMesh::create(*mesh));
+    return it.value();
+}
+
+void SkinnedMeshCache::clear()
+{
+    m_meshes.clear();
+}
@@ -0,0 +1,77 @@
+#ifndef SKINNEDMESH_H
+#define SKINNEDMESH_H
+
+#include <QHash>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "staticmesh.h"
+
+namespace spine {
+class MeshAttachment;
+class Skeleton;
+class Slot;
+}
+
+/**
+ * @brief Bind pose of a weighted mesh laid out for skinning in shader/skin.vert.
+ *
+ * Every vertex keeps up to MaxInfluences (bone, weight, bind position) tuples next to its uv, the
+ * bones are renumbered into a palette of at most MaxBones skeleton bones. Like any StaticMesh the
+ * data is uploaded once, per frame only the palette rows (a, b, worldX, 0, c, d, worldY, 0 per bone)
+ * are sent as uniforms.
+ */
+class SkinnedMesh : public StaticMesh
+{
+public:
+    enum {
+        MaxInfluences = 4,
+        MaxBones = 48,  // two vec4 uniforms per bone, fits the 128 vertex uniform vectors of GLES2.
+        VertexStride = 2 + 4 * MaxInfluences // u, v, bone indices, weights, bind x, bind y.
+    };
+
+    /**
+     * @brief create Returns null for unweighted meshes and meshes exceeding MaxInfluences or MaxBones.
+     */
+    static QSharedPointer<SkinnedMesh> create(spine::MeshAttachment& mesh);
+
+    /**
+     * @brief boneRows Fills the palette rows from the current skeleton world transforms.
+     */
+    void boneRows(spine::Skeleton& skeleton, spine::Vector<float>& rows) const;
+
+    /**
+     * @brief bounds Conservative bounds of the skinned vertices, the bind pose box of every palette bone
+     * transformed by the bone. Vertices are convex combinations of their influences, so they stay inside.
+     */
+    QRectF bounds(const spine::Vector<float>& rows) const;
+
+    /**
+     * @brief skin Cpu version of skin.vert for consumers that need plain vertices, like SoftwareRenderer.
+     */
+    void skin(const spine::Vector<float>& rows, const spine::Color& color,
+              spine::Vector<SpineVertex>& vertices, spine::Vector<GLushort>& triangles) const;
+
+private:
+    QVector<int> m_palette;       // skeleton bone index of every palette entry.
+    QVector<float> m_boneBounds;  // bind pose box (minX, minY, maxX, maxY) of the influences of every palette entry.
+};
+
+/**
+ * @brief Per item SkinnedMesh store keyed by attachment, ineligible meshes are remembered as null.
+ */
+class SkinnedMeshCache
+{
+public:
+    /**
+     * @brief mesh Skinning data of the mesh attachment of slot, null if the slot has to be skinned on the cpu.
+     */
+    QSharedPointer<SkinnedMesh> mesh(spine::Slot& slot);
+    void clear();
+
+private:
+    QHash<const spine::MeshAttachment*, QSharedPointer<SkinnedMesh>> m_meshes;
+};
+
+#endif // SKINNEDMESH_H
@@ -0,0 +1,506 @@
+#include "softwarerenderer.h"
+
+#include <QtConcurrent>
+#include <QVector>
+#include <cmath>
+#include <float.h>
+#include <spine/spine.h>
+
+#include "spineitem.h"
+#include "skinnedmesh.h"
+#include "texture.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_RENDERER_SSE2
+#endif
+
+namespace {
+
+// One premultiplied pixel in the lane order of a little endian ARGB32 word: b, g, r, a.
+#ifdef SOFTWARE_RENDERER_SSE2
+struct Vec4 {
+    __m128 v;
+    Vec4() {}
+    explicit Vec4(__m128 _v): v(_v) {}
+    Vec4(float b, float g, float r, float a): v(_mm_setr_ps(b, g, r, a)) {}
+    static Vec4 splat(float s) { return Vec4(_mm_set1_ps(s)); }
+    static Vec4 load(const float* p) { return Vec4(_mm_loadu_ps(p)); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    Vec4 alpha() const { return Vec4(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+};
+
+inline Vec4 operator+(const Vec4& a, const Vec4& b) { return Vec4(_mm_add_ps(a.v, b.v)); }
+inline Vec4 operator-(const Vec4& a, const Vec4& b) { return Vec4(_mm_sub_ps(a.v, b.v)); }
+inline Vec4 operator*(const Vec4& a, const Vec4& b) { return Vec4(_mm_mul_ps(a.v, b.v)); }
+
+inline Vec4 unpackPixel(quint32 pixel)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i p = _mm_cvtsi32_si128(int(pixel));
+    p = _mm_unpacklo_epi8(p, zero);
+    p = _mm_unpacklo_epi16(p, zero);
+    return Vec4(_mm_mul_ps(_mm_cvtepi32_ps(p), _mm_set1_ps(1.0f / 255.0f)));
+}
+
+inline quint32 packPixel(const Vec4& c)
+{
+    __m128 clamped = _mm_min_ps(_mm_max_ps(c.v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    __m128i p = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+    p = _mm_packs_epi32(p, p);
+    p = _mm_packus_epi16(p, p);
+    return quint32(_mm_cvtsi128_si32(p));
+}
+#else
+struct Vec4 {
+    float v[4];
+    Vec4() {}
+    Vec4(float b, float g, float r, float a) { v[0] = b; v[1] = g; v[2] = r; v[3] = a; }
+    static Vec4 splat(float s) { return Vec4(s, s, s, s); }
+    static Vec4 load(const float* p) { return Vec4(p[0], p[1], p[2], p[3]); }
+    void store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+    Vec4 alpha() const { return splat(v[3]); }
+};
+
+inline Vec4 operator+(const Vec4& a, const Vec4& b) { return Vec4(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]); }
+inline Vec4 operator-(const Vec4& a, const Vec4& b) { return Vec4(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]); }
+inline Vec4 operator*(const Vec4& a, const Vec4& b) { return Vec4(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]); }
+
+inline Vec4 unpackPixel(quint32 pixel)
+{
+    const float scale = 1.0f / 255.0f;
+    return Vec4((pixel & 0xff) * scale, ((pixel >> 8) & 0xff) * scale,
+                ((pixel >> 16) & 0xff) * scale, (pixel >> 24) * scale);
+}
+
+inline quint32 packPixel(const Vec4& c)
+{
+    quint32 pixel = 0;
+    for (int i = 0; i < 4; i++) {
+        float channel = qBound(0.0f, c.v[i], 1.0f);
+        pixel |= quint32(int(channel * 255.0f + 0.5f)) << (i * 8);
+    }
+    return pixel;
+}
+#endif
+
+inline Vec4 lerp(const Vec4& a, const Vec4& b, const Vec4& t)
+{
+    return a + (b - a) * t;
+}
+
+struct TextureView {
+    const quint32* bits = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0; // in pixels
+};
+
+// GL_LINEAR filtering with GL_CLAMP_TO_EDGE wrapping, like the QSGTexture of the GL path.
+inline Vec4 sampleBilinear(const TextureView& texture, float u, float v)
+{
+    float s = u * texture.width - 0.5f;
+    float t = v * texture.height - 0.5f;
+    float fs = std::floor(s);
+    float ft = std::floor(t);
+    int x0 = qBound(0, int(fs), texture.width - 1);
+    int y0 = qBound(0, int(ft), texture.height - 1);
+    int x1 = qBound(0, int(fs) + 1, texture.width - 1);
+    int y1 = qBound(0, int(ft) + 1, texture.height - 1);
+    const quint32* row0 = texture.bits + y0 * texture.stride;
+    const quint32* row1 = texture.bits + y1 * texture.stride;
+    Vec4 ax = Vec4::splat(s - fs);
+    Vec4 top = lerp(unpackPixel(row0[x0]), unpackPixel(row0[x1]), ax);
+    Vec4 bottom = lerp(unpackPixel(row1[x0]), unpackPixel(row1[x1]), ax);
+    return lerp(top, bottom, Vec4::splat(t - ft));
+}
+
+// vertices are snapped to 1/256 pixel so edge functions are exact and shared edges are
+// rasterized exactly once, like on the gpu.
+const int SubPixelBits = 8;
+const qint64 SubPixelOne = qint64(1) << SubPixelBits;
+const float MaxCoordinate = float(1 << 20);
+
+struct Triangle {
+    float minX, minY, maxX, maxY;
+    // edge functions a * (x - ex) + b * (y - ey) >= 0 inside, inclusive on top-left edges only.
+    qint64 ex[3], ey[3], a[3], b[3];
+    bool inclusive[3];
+    // attribute planes relative to the first vertex.
+    float x0, y0;
+    float u0, dudx, dudy;
+    float v0, dvdx, dvdy;
+    float color0[4], dcdx[4], dcdy[4];
+};
+
+inline qint64 floorDiv(qint64 a, qint64 b) // b > 0
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+inline qint64 ceilDiv(qint64 a, qint64 b) // b > 0
+{
+    return -floorDiv(-a, b);
+}
+
+struct PreparedBatch {
+    TextureView texture;
+    int blendMode = spine::BlendMode_Normal;
+    QRectF bounds;
+    std::vector<Triangle> triangles;
+};
+
+struct ScreenVertex {
+    float x, y, u, v;
+    float color[4]; // b, g, r, a
+};
+
+bool setupTriangle(const ScreenVertex* p0, const ScreenVertex* p1, const ScreenVertex* p2, Triangle& tri)
+{
+    const ScreenVertex* v[3] = {p0, p1, p2};
+    qint64 fx[3], fy[3];
+    for (int i = 0; i < 3; i++) {
+        // also rejects nan.
+        if (!(qAbs(v[i]->x) < MaxCoordinate && qAbs(v[i]->y) < MaxCoordinate))
+            return false;
+        fx[i] = qint64(std::floor(v[i]->x * SubPixelOne + 0.5f));
+        fy[i] = qint64(std::floor(v[i]->y * SubPixelOne + 0.5f));
+    }
+    qint64 area = (fx[1] - fx[0]) * (fy[2] - fy[0]) - (fx[2] - fx[0]) * (fy[1] - fy[0]);
+    if (area == 0)
+        return false;
+    if (area < 0) { // culling is disabled in the GL path, rasterize both windings.
+        std::swap(v[1], v[2]);
+        std::swap(fx[1], fx[2]);
+        std::swap(fy[1], fy[2]);
+        area = -area;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        int next = (i + 1) % 3;
+        tri.ex[i] = fx[i];
+        tri.ey[i] = fy[i];
+        tri.a[i] = fy[i] - fy[next];
+        tri.b[i] = fx[next] - fx[i];
+        tri.inclusive[i] = tri.a[i] > 0 || (tri.a[i] == 0 && tri.b[i] > 0);
+    }
+
+    float x[3], y[3];
+    for (int i = 0; i < 3; i++) {
+        x[i] = float(fx[i]) / SubPixelOne;
+        y[i] = float(fy[i]) / SubPixelOne;
+    }
+    tri.minX = qMin(x[0], qMin(x[1], x[2]));
+    tri.maxX = qMax(x[0], qMax(x[1], x[2]));
+    tri.minY = qMin(y[0], qMin(y[1], y[2]));
+    tri.maxY = qMax(y[0], qMax(y[1], y[2]));
+
+    float dx1 = x[1] - x[0], dy1 = y[1] - y[0];
+    float dx2 = x[2] - x[0], dy2 = y[2] - y[0];
+    float invArea = float(SubPixelOne * SubPixelOne) / float(area);
+    auto gradient = [&](float a0, float a1, float a2, float& ddx, float& ddy) {
+        ddx = ((a1 - a0) * dy2 - (a2 - a0) * dy1) * invArea;
+        ddy = ((a2 - a0) * dx1 - (a1 - a0) * dx2) * invArea;
+    };
+    tri.x0 = x[0];
+    tri.y0 = y[0];
+    tri.u0 = v[0]->u;
+    tri.v0 = v[0]->v;
+    gradient(v[0]->u, v[1]->u, v[2]->u, tri.dudx, tri.dudy);
+    gradient(v[0]->v, v[1]->v, v[2]->v, tri.dvdx, tri.dvdy);
+    for (int i = 0; i < 4; i++) {
+        tri.color0[i] = v[0]->color[i];
+        gradient(v[0]->color[i], v[1]->color[i], v[2]->color[i], tri.dcdx[i], tri.dcdy[i]);
+    }
+    return true;
+}
+
+struct ShadeState {
+    int blendColorChannel;
+    Vec4 blendColor;
+    Vec4 light;
+};
+
+// shader/texture.frag without the final blending.
+inline Vec4 shade(const ShadeState& state, const Vec4& vertexColor, const Vec4& texel)
+{
+    Vec4 color = vertexColor * texel;
+    if (state.blendColorChannel >= 0 && state.blendColorChannel <= 4) {
+        float lanes[4];
+        color.store(lanes);
+        float value;
+        switch (state.blendColorChannel) {
+        case 0: value = lanes[2]; break;
+        case 1: value = lanes[1]; break;
+        case 2: value = lanes[0]; break;
+        case 3: value = lanes[3]; break;
+        default: value = lanes[2] * 0.299f + lanes[1] * 0.587f + lanes[0] * 0.114f; break;
+        }
+        color = Vec4(value, value, value, lanes[3]) * state.blendColor;
+    }
+    color = color * state.light;
+    return color * vertexColor.alpha();
+}
+
+// Blend functions RenderCmdsCache uses for each spine blend mode.
+inline Vec4 blend(int blendMode, const Vec4& src, const Vec4& dst)
+{
+    const Vec4 one = Vec4::splat(1.0f);
+    switch (blendMode) {
+    case spine::BlendMode_Additive: // GL_ONE, GL_ONE
+        return src + dst;
+    case spine::BlendMode_Multiply: // GL_DST_COLOR, GL_ONE_MINUS_SRC_COLOR
+        return src * dst + dst * (one - src);
+    case spine::BlendMode_Screen: // GL_ONE, GL_ONE_MINUS_SRC_COLOR
+        return src + dst * (one - src);
+    default: // GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+        return src + dst * (one - src.alpha());
+    }
+}
+
+void rasterizeSpan(const ShadeState& state, const PreparedBatch& batch, const Triangle& tri,
+                   quint32* row, int y, int start, int end)
+{
+    float dx = start + 0.5f - tri.x0;
+    float dy = y + 0.5f - tri.y0;
+    float u = tri.u0 + tri.dudx * dx + tri.dudy * dy;
+    float v = tri.v0 + tri.dvdx * dx + tri.dvdy * dy;
+    Vec4 color = Vec4::load(tri.color0) + Vec4::load(tri.dcdx) * Vec4::splat(dx) + Vec4::load(tri.dcdy) * Vec4::splat(dy);
+    const Vec4 colorStep = Vec4::load(tri.dcdx);
+
+    for (int x = start; x <= end; x++) {
+        Vec4 src = shade(state, color, sampleBilinear(batch.texture, u, v));
+        row[x] = packPixel(blend(batch.blendMode, src, unpackPixel(row[x])));
+        u += tri.dudx;
+        v += tri.dvdx;
+        color = color + colorStep;
+    }
+}
+
+void rasterizeTriangle(const ShadeState& state, const PreparedBatch& batch, const Triangle& tri,
+                       QImage& target, const QRect& tile)
+{
+    int x0 = qMax(tile.left(), int(std::floor(tri.minX)));
+    int x1 = qMin(tile.right(), int(std::ceil(tri.maxX)));
+    int y0 = qMax(tile.top(), int(std::floor(tri.minY)));
+    int y1 = qMin(tile.bottom(), int(std::ceil(tri.maxY)));
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    for (int y = y0; y <= y1; y++) {
+        const qint64 yc = y * SubPixelOne + SubPixelOne / 2;
+        int start = x0, end = x1;
+        for (int e = 0; e < 3 && start <= end; e++) {
+            const qint64 a = tri.a[e];
+            const qint64 rowValue = tri.b[e] * (yc - tri.ey[e]);
+            if (a == 0) {
+                if (rowValue < 0 || (rowValue == 0 && !tri.inclusive[e]))
+                    end = start - 1;
+                continue;
+            }
+            // first / last pixel center x * 256 + 128 on the inner side of the edge.
+            if (a > 0) {
+                qint64 limit = tri.ex[e] + (tri.inclusive[e] ? ceilDiv(-rowValue, a) : floorDiv(-rowValue, a) + 1);
+                start = int(qMax(qint64(start), ceilDiv(limit - SubPixelOne / 2, SubPixelOne)));
+            } else {
+                qint64 limit = tri.ex[e] + (tri.inclusive[e] ? floorDiv(rowValue, -a) : ceilDiv(rowValue, -a) - 1);
+                end = int(qMin(qint64(end), floorDiv(limit - SubPixelOne / 2, SubPixelOne)));
+            }
+        }
+        if (start <= end)
+            rasterizeSpan(state, batch, tri, reinterpret_cast<quint32*>(target.scanLine(y)), y, start, end);
+    }
+}
+
+}
+
+SoftwareRenderer::SoftwareRenderer()
+{
+}
+
+void SoftwareRenderer::render(const std::vector<RenderCmdBatch> &batches, const QRectF &skeletonRect,
+                              const QSize &size, QImage &target) const
+{
+    renderBatches(batches, nullptr, skeletonRect, size, target);
+}
+
+void SoftwareRenderer::render(const std::vector<RenderCmdBatch> &batches, const QImage &texture,
+                              const QRectF &skeletonRect, const QSize &size, QImage &target) const
+{
+    renderBatches(batches, &texture, skeletonRect, size, target);
+}
+
+void SoftwareRenderer::renderBatches(const std::vector<RenderCmdBatch> &batches, const QImage *texture,
+                                     const QRectF &skeletonRect, const QSize &size, QImage &target) const
+{
+    if (target.size() != size || target.format() != QImage::Format_ARGB32_Premultiplied)
+        target = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::transparent);
+    if (target.isNull() || !skeletonRect.isValid())
+        return;
+
+    // keep the source images alive while the tiles read their bits.
+    QVector<QImage> images;
+    std::vector<PreparedBatch> prepared;
+    prepared.reserve(batches.size());
+    std::vector<ScreenVertex> screenVertices;
+
+    const float scaleX = float(size.width() / skeletonRect.width());
+    const float scaleY = float(size.height() / skeletonRect.height());
+    const QRectF targetRect(0, 0, size.width(), size.height());
+    RenderCmdBatch expandedBatch;
+    for (const auto& sourceBatch: batches) {
+        // gpu skinned and static batches carry bone rows or bare positions instead of vertices, expand them here.
+        const RenderCmdBatch* batchPointer = &sourceBatch;
+        if (sourceBatch.skinnedMesh || sourceBatch.staticMesh) {
+            if (sourceBatch.skinnedMesh)
+                sourceBatch.skinnedMesh->skin(sourceBatch.boneRows, sourceBatch.tint, expandedBatch.vertices, expandedBatch.triangles);
+            else
+                sourceBatch.staticMesh->expand(sourceBatch.positions, sourceBatch.tint, expandedBatch.vertices, expandedBatch.triangles);
+            expandedBatch.texture = sourceBatch.texture;
+            expandedBatch.blendMode = sourceBatch.blendMode;
+            batchPointer = &expandedBatch;
+        }
+        const RenderCmdBatch& batch = *batchPointer;
+        if ((!texture && !batch.texture) || batch.triangles.size() == 0)
+            continue;
+        QImage image = texture ? *texture : AimyTextureLoader::instance()->getImage(batch.texture);
+        if (image.isNull())
+            continue;
+        images.append(image);
+
+        PreparedBatch preparedBatch;
+        preparedBatch.texture.bits = reinterpret_cast<const quint32*>(image.constBits());
+        preparedBatch.texture.width = image.width();
+        preparedBatch.texture.height = image.height();
+        preparedBatch.texture.stride = image.bytesPerLine() / 4;
+        preparedBatch.blendMode = batch.blendMode;
+
+        screenVertices.resize(batch.vertices.size());
+        for (size_t i = 0; i < batch.vertices.size(); i++) {
+            const auto& vertex = batch.vertices[i];
+            auto& screenVertex = screenVertices[i];
+            screenVertex.x = float(vertex.x - skeletonRect.left()) * scaleX;
+            screenVertex.y = float(vertex.y - skeletonRect.top()) * scaleY;
+            screenVertex.u = vertex.u;
+            screenVertex.v = vertex.v;
+            screenVertex.color[0] = vertex.color.b;
+            screenVertex.color[1] = vertex.color.g;
+            screenVertex.color[2] = vertex.color.r;
+            screenVertex.color[3] = vertex.color.a;
+        }
+
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        preparedBatch.triangles.reserve(batch.triangles.size() / 3);
+        for (size_t i = 0; i + 2 < batch.triangles.size(); i += 3) {
+            size_t i0 = batch.triangles[i], i1 = batch.triangles[i + 1], i2 = batch.triangles[i + 2];
+            if (i0 >= screenVertices.size() || i1 >= screenVertices.size() || i2 >= screenVertices.size())
+                continue;
+            Triangle tri;
+            if (!setupTriangle(&screenVertices[i0], &screenVertices[i1], &screenVertices[i2], tri))
+                continue;
+            minX = qMin(minX, tri.minX);
+            minY = qMin(minY, tri.minY);
+            maxX = qMax(maxX, tri.maxX);
+            maxY = qMax(maxY, tri.maxY);
+            preparedBatch.triangles.push_back(tri);
+        }
+        preparedBatch.bounds = QRectF(minX, minY, maxX - minX, maxY - minY);
+        if (preparedBatch.triangles.empty() || !preparedBatch.bounds.intersects(targetRect))
+            continue;
+        prepared.push_back(std::move(preparedBatch));
+    }
+    if (prepared.empty())
+        return;
+
+    ShadeState state;
+    state.blendColorChannel = m_blendColorChannel;
+    state.blendColor = Vec4(float(m_blendColor.blueF()), float(m_blendColor.greenF()),
+                            float(m_blendColor.redF()), float(m_blendColor.alphaF()));
+    state.light = Vec4(m_light, m_light, m_light, 1.0f);
+
+    QVector<QRect> tiles;
+    const int tileSize = qMax(8, m_tileSize);
+    for (int y = 0; y < size.height(); y += tileSize)
+        for (int x = 0; x < size.width(); x += tileSize)
+            tiles.append(QRect(x, y, qMin(tileSize, size.width() - x), qMin(tileSize, size.height() - y)));
+
+    // every tile owns its pixels, so tiles only share read only data.
+    auto renderTile = [&](const QRect& tile) {
+        const QRectF tileRect(tile);
+        for (const auto& batch: prepared) {
+            if (!batch.bounds.intersects(tileRect.adjusted(-1, -1, 1, 1)))
+                continue;
+            for (const auto& tri: batch.triangles) {
+                if (tri.maxX < tile.left() || tri.minX > tile.right() + 1 ||
+                    tri.maxY < tile.top() || tri.minY > tile.bottom() + 1)
+                    continue;
+                rasterizeTriangle(state, batch, tri, target, tile);
+            }
+        }
+    };
+
+    if (m_multiThreaded && tiles.size() > 1) {
+        QtConcurrent::blockingMap(tiles, renderTile);
+    } else {
+        for (const auto& tile: tiles)
+            renderTile(tile);
+    }
+}
+
+QImage SoftwareRenderer::render(const std::vector<RenderCmdBatch> &batches, const QRectF &skeletonRect, const QSize &size) const
+{
+    QImage image;
+    render(batches, skeletonRect, size, image);
+    return image;
+}
+
+QColor SoftwareRenderer::blendColor() const
+{
+    return m_blendColor;
+}
+
+void SoftwareRenderer::setBlendColor(const QColor &blendColor)
+{
+    m_blendColor = blendColor;
+}
+
+int SoftwareRenderer::blendColorChannel() const
+{
+    return m_blendColorChannel;
+}
+
+void SoftwareRenderer::setBlendColorChannel(int blendColorChannel)
+{
+    m_blendColorChannel = blendColorChannel;
+}
+
+float SoftwareRenderer::light() const
+{
+    return m_light;
+}
+
+void SoftwareRenderer::setLight(float light)
+{
+    m_light = light;
+}
+
+int SoftwareRenderer::tileSize() const
+{
+    return m_tileSize;
+}
+
+void SoftwareRenderer::setTileSize(int tileSize)
+{
+    m_tileSize = tileSize;
+}
+
+bool SoftwareRenderer::multiThreaded() const
+{
+    return m_multiThreaded;
+}
+
+void SoftwareRenderer::setMultiThreaded(bool multiThreaded)
+{
+    m_multiThreaded = multiThreaded;
+}
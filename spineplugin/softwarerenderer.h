@@ -0,0 +1,73 @@
+#ifndef SOFTWARERENDERER_H
+#define SOFTWARERENDERER_H
+
+#include <QColor>
+#include <QImage>
+#include <QRectF>
+#include <QSize>
+#include <vector>
+
+struct RenderCmdBatch;
+
+/**
+ * @brief CPU rasterizer for the batch list produced by SpineItem::batchRenderCmd.
+ *
+ * Renders textured, vertex colored triangles into a premultiplied ARGB32 QImage without any
+ * OpenGL context, so skeletons can be rendered on machines without a GPU. The output matches
+ * what RenderCmdsCache draws into the item framebuffer: the same projection of the skeleton
+ * rect, the same blend functions for every spine blend mode and the same blendColor, blend
+ * color channel and light handling as shader/texture.frag. Clipping attachments are already
+ * applied to the batches by SkeletonClipping, the rasterizer only clips against the image.
+ *
+ * The image is split into tiles which are rasterized in parallel with QtConcurrent, every
+ * tile walks all batches in draw order so blending stays ordered per pixel.
+ */
+class SoftwareRenderer
+{
+public:
+    SoftwareRenderer();
+
+    /**
+     * @brief render Clears target to transparent and rasterizes the batches into it.
+     * @param batches Batches in draw order.
+     * @param skeletonRect Skeleton space rect mapped onto the whole image, like RenderCmdsCache::setSkeletonRect.
+     * @param target Reused between frames, (re)allocated as Format_ARGB32_Premultiplied of the given size when needed.
+     * @param size Output size in pixels.
+     */
+    void render(const std::vector<RenderCmdBatch>& batches, const QRectF& skeletonRect, const QSize& size, QImage& target) const;
+    QImage render(const std::vector<RenderCmdBatch>& batches, const QRectF& skeletonRect, const QSize& size) const;
+    /**
+     * @brief render Same, but every batch samples texture instead of its atlas page, like a baked frame samples its sprite sheet.
+     * @param texture Premultiplied ARGB32 image.
+     */
+    void render(const std::vector<RenderCmdBatch>& batches, const QImage& texture, const QRectF& skeletonRect,
+                const QSize& size, QImage& target) const;
+
+    QColor blendColor() const;
+    void setBlendColor(const QColor &blendColor);
+
+    int blendColorChannel() const;
+    void setBlendColorChannel(int blendColorChannel);
+
+    float light() const;
+    void setLight(float light);
+
+    int tileSize() const;
+    void setTileSize(int tileSize);
+
+    bool multiThreaded() const;
+    void setMultiThreaded(bool multiThreaded);
+
+private:
+    void renderBatches(const std::vector<RenderCmdBatch>& batches, const QImage* texture, const QRectF& skeletonRect,
+                       const QSize& size, QImage& target) const;
+
+private:
+    QColor m_blendColor = QColor(255, 255, 255, 255);
+    int m_blendColorChannel = -1;
+    float m_light = 1.0f;
+    int m_tileSize = 64;
+    bool m_multiThreaded = true;
+};
+
+#endif // SOFTWARERENDERER_H
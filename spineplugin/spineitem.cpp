@@ -11,6 +11,11 @@
 #include <float.h>
 #include "rendercmdscache.h"
 #include "texture.h"
+#include "softwarerenderer.h"
+#include "spinevertexeffect.h"
+#include "spritesheetcache.h"
+#include "skinnedmesh.h"
+#include "staticmesh.h"
 
 spine::String qstringtospinestring(const QString& str) {
     return spine::String(str.toStdString().data());
@@ -28,6 +33,15 @@ spine::String urltospinestring(const QUrl& url) {
     return qstringtospinestring(abPath);
 }
 
+template<typename T>
+void resetInArena(QSharedPointer<T>& pointer, T* object, const QSharedPointer<spine::Arena>& arena)
+{
+    pointer.reset(object, [arena](T* object) {
+        spine::ArenaExtension::Scope scope(arena.data());
+        delete object;
+    });
+}
+
 void animationSateListioner(spine::AnimationState* state, spine::EventType type, spine::TrackEntry* entry, spine::Event* event) {
     auto spItem = static_cast<SpineItem*>(state->getRendererObject());
     if(!spItem)
@@ -81,7 +95,9 @@ SpineItem::SpineItem(QQuickItem *parent) :
     m_lazyLoadTimer(new QTimer),
     m_renderCache(new RenderCmdsCache(this, this)),
     m_spWorker(new SpineItemWorker(nullptr, this)),
-    m_spWorkerThread(new QThread)
+    m_spWorkerThread(new QThread),
+    m_skinnedMeshes(new SkinnedMeshCache),
+    m_staticMeshes(new StaticMeshCache)
 {
     AimyTextureLoader::instance(); // make sure this has been initialized.
     m_blendColor = QColor(255, 255, 255, 255);
@@ -191,6 +207,18 @@ void SpineItem::clearTrack(int trackIndex)
         QMetaObject::invokeMethod(m_spWorker.get(), "clearTrack", Q_ARG(int, trackIndex));
 }
 
+QImage SpineItem::renderToImage(const QSize &size) const
+{
+    QImage image;
+    if(!m_spWorkerThread->isRunning() || !m_spWorker)
+        return image;
+    QSize imageSize = size.isValid() ? size : QSize(qCeil(width()), qCeil(height()));
+    // the batches are only touched on the worker thread, which is the calling one when not asynchronous.
+    Qt::ConnectionType type = m_spWorker->thread() == QThread::currentThread() ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+    QMetaObject::invokeMethod(m_spWorker.get(), "renderToImage", type, Q_RETURN_ARG(QImage, image), Q_ARG(QSize, imageSize));
+    return image;
+}
+
 QUrl SpineItem::atlasFile() const
 {
     return m_atlasFile;
@@ -259,9 +287,24 @@ QRectF SpineItem::computeBoundingRect()
             }
         } else if(attachment->getRTTI().isExactly(spine::MeshAttachment::rtti)) {
             auto* meshAttachment = static_cast<spine::MeshAttachment*>(slot->getAttachment());
-            verticesCount = meshAttachment->getWorldVerticesLength();
-            meshAttachment->computeWorldVertices(*slot, m_worldVertices);
-            if(QString(attachment->getName().buffer()).endsWith("viewport")) {
+            bool isViewPort = QString(attachment->getName().buffer()).endsWith("viewport");
+            auto skinnedMeshes = activeSkinnedMeshes();
+            auto skinned = skinnedMeshes && !isViewPort ? skinnedMeshes->mesh(*slot) : QSharedPointer<SkinnedMesh>();
+            if(skinned) {
+                // gpu skinned meshes are bounded by their bones, skinning every vertex here would defeat the shader.
+                spine::Vector<float> boneRows;
+                skinned->boneRows(*m_skeleton, boneRows);
+                QRectF bounds = skinned->bounds(boneRows);
+                verticesCount = 4;
+                m_worldVertices[0] = float(bounds.left());
+                m_worldVertices[1] = float(bounds.top());
+                m_worldVertices[2] = float(bounds.right());
+                m_worldVertices[3] = float(bounds.bottom());
+            } else {
+                verticesCount = meshAttachment->getWorldVerticesLength();
+                meshAttachment->computeWorldVertices(*slot, m_worldVertices);
+            }
+            if(isViewPort) {
                 m_hasViewPort = true;
                 for (int ii = 0; ii < verticesCount; ii+=2) {
                     float x = m_worldVertices[ii], y = m_worldVertices[ii + 1];
@@ -285,7 +328,7 @@ QRectF SpineItem::computeBoundingRect()
     return QRectF(minX, minY, maxX - minX, maxY - minY);
 }
 
-Texture *SpineItem::getTexture(spine::Attachment *attachment) const
+Texture *SpineItem::getTexture(spine::Attachment *attachment)
 {
     if(attachment->getRTTI().isExactly(spine::RegionAttachment::rtti)) {
         return (Texture*)((spine::AtlasRegion*)static_cast<spine::RegionAttachment*>(attachment)->getRendererObject())->page->getRendererObject();
@@ -297,11 +340,16 @@ Texture *SpineItem::getTexture(spine::Attachment *attachment) const
 
 void SpineItem::releaseSkeletonRelatedData(){
     m_hasViewPort = false;
+    m_skinnedMeshes->clear();
+    m_staticMeshes->clear();
     m_animationStateData.reset();
     m_animationState.reset();
     m_skeletonData.reset();
     m_atlas.reset();
     m_skeleton.reset();
+    m_spriteSheet.reset();
+    m_bakedFrame = -1;
+    m_poseDirty = true;
     m_loaded = false;
     m_shouldReleaseCacheTexture = true;
 }
@@ -327,6 +375,18 @@ bool SpineItem::nothingToDraw(spine::Slot &slot)
 static unsigned short quadIndices[] = {0, 1, 2, 2, 3, 0};
 
 void SpineItem::batchRenderCmd()
+{
+    if(m_requestRender)
+        return;
+    m_requestRender = true;
+    if(!m_renderCache || !m_renderCache->isValid() || !m_componentCompleted)
+        return;
+
+    m_bakedFrame = -1;
+    buildRenderBatches(*m_skeleton, *m_clipper, m_batches, m_vertexEfect, activeSkinnedMeshes(), m_staticMeshes.data());
+}
+
+void SpineItem::batchBakedFrame(int frame)
 {
     if(m_requestRender)
         return;
@@ -335,12 +395,179 @@ void SpineItem::batchRenderCmd()
         return;
 
     m_batches.clear();
+    m_bakedFrame = frame;
+}
+
+RenderCmdBatch SpineItem::bakedFrameBatch(const QRectF &bounds, const QRectF &uv)
+{
+    const QPointF corners[4] = {bounds.topLeft(), bounds.topRight(), bounds.bottomRight(), bounds.bottomLeft()};
+    const QPointF uvs[4] = {uv.topLeft(), uv.topRight(), uv.bottomRight(), uv.bottomLeft()};
+    RenderCmdBatch batch;
+    batch.vertices.setSize(4, SpineVertex());
+    for(int i = 0; i < 4; i++) {
+        batch.vertices[i].x = float(corners[i].x());
+        batch.vertices[i].y = float(corners[i].y());
+        batch.vertices[i].u = float(uvs[i].x());
+        batch.vertices[i].v = float(uvs[i].y());
+        batch.vertices[i].color.set(1, 1, 1, 1);
+    }
+    batch.triangles.setSize(6, 0);
+    memcpy(batch.triangles.buffer(), quadIndices, 6 * sizeof (GLushort));
+    // frames are baked premultiplied, so they blend like a normal slot.
+    batch.blendMode = spine::BlendMode_Normal;
+    return batch;
+}
+
+namespace {
+// a drawn slot of the draw order, settled serially before any vertex work.
+struct SlotCmd {
+    spine::Slot* slot;
+    // clipping attachment active for the slot and the slot which started it.
+    spine::ClippingAttachment* clip;
+    spine::Slot* clipSlot;
+    size_t cost;
+    bool keep;
+};
+
+// cost is about one per computed vertex, cheaper frames are batched on the calling thread.
+const size_t ParallelBatchCost = 8192;
+const size_t MinChunkCost = 2048;
+// clipped vertices cost about four times as much as plain ones.
+const size_t ClipCostFactor = 4;
+
+// computes the vertices of cmds [begin, end) into their preassigned batches. A chunk starting
+// inside a clipping span starts the clip itself, so spans crossing chunks clip the same.
+void buildBatchVertices(std::vector<SlotCmd>& cmds, std::vector<RenderCmdBatch>& batches,
+                        size_t begin, size_t end, spine::SkeletonClipping& clipper,
+                        spine::Skeleton& skeleton)
+{
+    spine::Slot* clipSlot = nullptr;
+    for (size_t c = begin; c < end; c++) {
+        auto& cmd = cmds[c];
+        auto& batch = batches[c];
+        auto slot = cmd.slot;
+        auto attachment = slot->getAttachment();
+        const auto tint = batch.tint;
+
+        if (cmd.clipSlot != clipSlot) {
+            clipper.clipEnd();
+            if (cmd.clip)
+                clipper.clipStart(*cmd.clipSlot, cmd.clip);
+            clipSlot = cmd.clipSlot;
+        }
+
+        if(attachment->getRTTI().isExactly(spine::RegionAttachment::rtti)) {
+            auto regionAttachment = (spine::RegionAttachment*)attachment;
+            if(batch.staticMesh) {
+                batch.positions.setSize(8, 0);
+                regionAttachment->computeWorldVertices(slot->getBone(), batch.positions.buffer(), 0, 2);
+            } else {
+                batch.vertices.setSize(4, SpineVertex());
+                regionAttachment->computeWorldVertices(slot->getBone(),
+                                                       (float*)batch.vertices.buffer(),
+                                                       0,
+                                                       sizeof (SpineVertex) / sizeof (float));
+                for(size_t j = 0, l = 0; j < 4; j++,l+=2) {
+                    auto &vertex = batch.vertices[j];
+                    vertex.color.set(tint);
+                    vertex.u = regionAttachment->getUVs()[l];
+                    vertex.v = regionAttachment->getUVs()[l + 1];
+                }
+                batch.triangles.setSize(6, 0);
+                memcpy(batch.triangles.buffer(), quadIndices, 6 * sizeof (GLushort));
+            }
+        } else {
+            auto mesh = (spine::MeshAttachment*)attachment;
+            if(batch.skinnedMesh) {
+                batch.skinnedMesh->boneRows(skeleton, batch.boneRows);
+            } else if(batch.staticMesh) {
+                batch.positions.setSize(mesh->getWorldVerticesLength(), 0);
+                mesh->computeWorldVertices(*slot, batch.positions);
+            } else {
+                size_t numVertices = mesh->getWorldVerticesLength() / 2;
+                batch.vertices.setSize(numVertices, SpineVertex());
+                mesh->computeWorldVertices(*slot,
+                                           0,
+                                           mesh->getWorldVerticesLength(),
+                                           (float*)batch.vertices.buffer(),
+                                           0,
+                                           sizeof (SpineVertex) / sizeof (float));
+                for (size_t j = 0, l = 0; j < numVertices; j++, l+=2) {
+                    auto& vertex = batch.vertices[j];
+                    vertex.color.set(tint);
+                    vertex.u = mesh->getUVs()[l];
+                    vertex.v = mesh->getUVs()[l+1];
+                }
+                batch.triangles.setSize(mesh->getTriangles().size(), 0);
+                memcpy(batch.triangles.buffer(), mesh->getTriangles().buffer(), mesh->getTriangles().size() * sizeof (GLushort));
+            }
+        }
+
+        if(cmd.clip) {
+            auto tmpVerticesCount = batch.vertices.size() * 2;
+            spine::Vector<float> tmpVertices;
+            spine::Vector<float> tmpUvs;
+            tmpVertices.setSize(tmpVerticesCount, 0);
+            tmpUvs.setSize(tmpVerticesCount, 0);
+
+            for(size_t i = 0; i < batch.vertices.size(); i++) {
+                tmpVertices[i * 2] = batch.vertices[i].x;
+                tmpVertices[i * 2 + 1] = batch.vertices[i].y;
+                tmpUvs[i * 2] = batch.vertices[i].u;
+                tmpUvs[i * 2 + 1] = batch.vertices[i].v;
+            }
+            clipper.clipTriangles(tmpVertices.buffer(), batch.triangles.buffer(), batch.triangles.size(), tmpUvs.buffer(), sizeof (short));
 
-    for(size_t i = 0, n = m_skeleton->getSlots().size(); i < n; ++i) {
-        auto slot = m_skeleton->getDrawOrder()[i];
+            auto vertCount = clipper.getClippedVertices().size() / 2;
+
+            if(clipper.getClippedTriangles().size() == 0) {
+                cmd.keep = false;
+                continue;
+            }
+            batch.triangles.setSize(clipper.getClippedTriangles().size(), 0);
+            memcpy(batch.triangles.buffer(), clipper.getClippedTriangles().buffer(), batch.triangles.size() * sizeof (unsigned short));
+            auto& newUvs = clipper.getClippedUVs();
+            auto& newVertices = clipper.getClippedVertices();
+            batch.vertices.setSize(vertCount, SpineVertex());
+            for(size_t i = 0; i < vertCount; i++) {
+                batch.vertices[i].x = newVertices[i * 2];
+                batch.vertices[i].y = newVertices[i * 2 + 1];
+                batch.vertices[i].u = newUvs[i * 2];
+                batch.vertices[i].v = newUvs[i * 2 + 1];
+                batch.vertices[i].color.set(tint);
+            }
+        }
+    }
+    clipper.clipEnd();
+}
+}
+
+void SpineItem::buildRenderBatches(spine::Skeleton &skeleton, spine::SkeletonClipping &clipper,
+                                   std::vector<RenderCmdBatch> &batches, SpineVertexEffect *vertexEffect,
+                                   SkinnedMeshCache *skinnedMeshes, StaticMeshCache *staticMeshes)
+{
+    batches.clear();
+
+    // first pass: textures, tints, mesh caches and clipping spans in draw order. This only follows
+    // which clipping attachment SkeletonClipping would have active, without building its polygons.
+    std::vector<SlotCmd> cmds;
+    cmds.reserve(skeleton.getSlots().size());
+    batches.reserve(skeleton.getSlots().size());
+    spine::ClippingAttachment* clip = nullptr;
+    spine::Slot* clipSlot = nullptr;
+    auto clipEnd = [&](spine::Slot& slot) {
+        if(clip && clip->getEndSlot() == &slot.getData()) {
+            clip = nullptr;
+            clipSlot = nullptr;
+        }
+    };
+    size_t totalCost = 0;
+
+    for(size_t i = 0, n = skeleton.getSlots().size(); i < n; ++i) {
+        auto slot = skeleton.getDrawOrder()[i];
 
         if (nothingToDraw(*slot)) {
-            m_clipper->clipEnd(*slot);
+            clipEnd(*slot);
             continue;
         }
 
@@ -349,16 +576,10 @@ void SpineItem::batchRenderCmd()
             continue;
 
         RenderCmdBatch batch;
-
-        auto name = QString(attachment->getName().buffer());
-//        spine::Vector<SpineVertex> vertices;
-//        spine::Vector<GLushort> triangles;
         Texture* texture = nullptr;
-        int blendMode;
-        blendMode = slot->getData().getBlendMode();
-
+        size_t cost = 0;
 
-        auto skeletonColor = m_skeleton->getColor();
+        auto skeletonColor = skeleton.getColor();
         auto slotColor = slot->getColor();
         spine::Color attachmentColor(0, 0, 0, 0);
         spine::Color tint(skeletonColor.r * slotColor.r,
@@ -383,107 +604,95 @@ void SpineItem::batchRenderCmd()
 
             tint.set(tint.r * attachmentColor.r, tint.g * attachmentColor.g, tint.b * attachmentColor.b, tint.a * attachmentColor.a);
             texture = getTexture(regionAttachment);
-            batch.vertices.setSize(4, SpineVertex());
-            regionAttachment->computeWorldVertices(slot->getBone(),
-                                                   (float*)batch.vertices.buffer(),
-                                                   0,
-                                                   sizeof (SpineVertex) / sizeof (float));
-            for(size_t j = 0, l = 0; j < 4; j++,l+=2) {
-                auto &vertex = batch.vertices[j];
-                vertex.color.set(tint);
-                vertex.u = regionAttachment->getUVs()[l];
-                vertex.v = regionAttachment->getUVs()[l + 1];
-            }
-            batch.triangles.setSize(6, 0);
-            memcpy(batch.triangles.buffer(), quadIndices, 6 * sizeof (GLushort));
+            // clipping and vertex effects need the final vertices on the cpu.
+            if(staticMeshes && !vertexEffect && !clip)
+                batch.staticMesh = staticMeshes->mesh(*attachment);
+            cost = 4;
         } else if (attachment->getRTTI().isExactly(spine::MeshAttachment::rtti)) {
             auto mesh = (spine::MeshAttachment*)attachment;
             attachmentColor.set(mesh->getColor());
             tint.set(tint.r * attachmentColor.r, tint.g * attachmentColor.g, tint.b * attachmentColor.b, tint.a * attachmentColor.a);
-            size_t numVertices = mesh->getWorldVerticesLength() / 2;
-            batch.vertices.setSize(numVertices, SpineVertex());
             texture = getTexture(mesh);
-            mesh->computeWorldVertices(*slot,
-                                       0,
-                                       mesh->getWorldVerticesLength(),
-                                       (float*)batch.vertices.buffer(),
-                                       0,
-                                       sizeof (SpineVertex) / sizeof (float));
-            for (size_t j = 0, l = 0; j < numVertices; j++, l+=2) {
-                auto& vertex = batch.vertices[j];
-                vertex.color.set(tint);
-                vertex.u = mesh->getUVs()[l];
-                vertex.v = mesh->getUVs()[l+1];
-            }
-            batch.triangles.setSize(mesh->getTriangles().size(), 0);
-            memcpy(batch.triangles.buffer(), mesh->getTriangles().buffer(), mesh->getTriangles().size() * sizeof (GLushort));
-
-            if (m_vertexEfect) {
-                // todo
+            // clipping and vertex effects need the final vertices on the cpu.
+            if(!vertexEffect && !clip) {
+                if(skinnedMeshes)
+                    batch.skinnedMesh = skinnedMeshes->mesh(*slot);
+                if(!batch.skinnedMesh && staticMeshes)
+                    batch.staticMesh = staticMeshes->mesh(*attachment);
             }
-
+            cost = batch.skinnedMesh ? 1 : mesh->getWorldVerticesLength() / 2;
         } else if(attachment->getRTTI().isExactly(spine::ClippingAttachment::rtti)) {
-            auto clip = (spine::ClippingAttachment*)attachment;
-            m_clipper->clipStart(*slot, clip);
+            if(!clip) {
+                clip = (spine::ClippingAttachment*)attachment;
+                clipSlot = slot;
+            }
             continue;
         } else{
-            m_clipper->clipEnd(*slot);
+            clipEnd(*slot);
             continue;
         }
 
         if(tint.a == 0) {
-            m_clipper->clipEnd(*slot);
+            clipEnd(*slot);
             continue;
         }
 
         if(texture) {
-            if(m_clipper->isClipping()) {
-
-                auto tmpVerticesCount = batch.vertices.size() * 2;
-                spine::Vector<float> tmpVertices;
-                spine::Vector<float> tmpUvs;
-                tmpVertices.setSize(tmpVerticesCount, 0);
-                tmpUvs.setSize(tmpVerticesCount, 0);
-
-                for(size_t i = 0; i < batch.vertices.size(); i++) {
-                    tmpVertices[i * 2] = batch.vertices[i].x;
-                    tmpVertices[i * 2 + 1] = batch.vertices[i].y;
-                    tmpUvs[i * 2] = batch.vertices[i].u;
-                    tmpUvs[i * 2 + 1] = batch.vertices[i].v;
-                }
-                m_clipper->clipTriangles(tmpVertices.buffer(), batch.triangles.buffer(), batch.triangles.size(), tmpUvs.buffer(), sizeof (short));
-                tmpVertices.setSize(0, 0);
-                tmpUvs.setSize(0, 0);
-
-                auto vertCount = m_clipper->getClippedVertices().size() / 2;
+            if(clip)
+                cost *= ClipCostFactor;
+            totalCost += cost;
+            batch.texture = texture;
+            batch.blendMode = slot->getData().getBlendMode();
+            batch.tint.set(tint);
+            batches.push_back(batch);
+            cmds.push_back({slot, clip, clipSlot, cost, true});
+            clipEnd(*slot);
+        }
+    }
 
-                if(m_clipper->getClippedTriangles().size() == 0) {
-                    m_clipper->clipEnd(*slot);
-                    continue;
-                }
-                batch.triangles.setSize(m_clipper->getClippedTriangles().size(), 0);
-                memcpy(batch.triangles.buffer(), m_clipper->getClippedTriangles().buffer(), batch.triangles.size() * sizeof (unsigned short));
-                auto newUvs = m_clipper->getClippedUVs();
-                auto newVertices = m_clipper->getClippedVertices();
-                batch.vertices.setSize(vertCount, SpineVertex());
-                for(size_t i = 0; i < vertCount; i++) {
-                    batch.vertices[i].x = newVertices[i * 2];
-                    batch.vertices[i].y = newVertices[i * 2 + 1];
-                    batch.vertices[i].u = newUvs[i * 2];
-                    batch.vertices[i].v = newUvs[i * 2 + 1];
-                    batch.vertices[i].color.set(tint);
-                }
+    // second pass: world vertices, tints and clipping of draw order chunks of about equal cost,
+    // each written into its own batches, in parallel for large skeletons.
+    const size_t maxChunks = size_t(qMax(1, QThreadPool::globalInstance()->maxThreadCount()));
+    const size_t chunkCount = totalCost < ParallelBatchCost ? 1 : qMin(maxChunks, totalCost / MinChunkCost);
+    if(chunkCount <= 1) {
+        buildBatchVertices(cmds, batches, 0, cmds.size(), clipper, skeleton);
+    } else {
+        QVector<QPair<size_t, size_t>> chunks;
+        size_t begin = 0, cost = 0;
+        for(size_t c = 0; c < cmds.size(); c++) {
+            cost += cmds[c].cost;
+            if(cost * chunkCount >= totalCost * size_t(chunks.size() + 1) || c + 1 == cmds.size()) {
+                chunks.append(qMakePair(begin, c + 1));
+                begin = c + 1;
             }
-            if(batch.triangles.size() == 0)
-                m_clipper->clipEnd(*slot);
+        }
+        QtConcurrent::blockingMap(chunks, [&](const QPair<size_t, size_t>& chunk) {
+            spine::SkeletonClipping chunkClipper;
+            buildBatchVertices(cmds, batches, chunk.first, chunk.second, chunkClipper, skeleton);
+        });
+    }
 
-            batch.texture = texture;
-            batch.blendMode = blendMode;
-            m_batches.push_back(batch);
-            m_clipper->clipEnd(*slot);
+    // batches clipped away entirely are dropped, keeping the others in draw order.
+    size_t kept = 0;
+    for(const auto& cmd: cmds)
+        kept += cmd.keep ? 1 : 0;
+    if(kept < cmds.size()) {
+        std::vector<RenderCmdBatch> stitched;
+        stitched.reserve(kept);
+        for(size_t c = 0; c < cmds.size(); c++) {
+            if(cmds[c].keep)
+                stitched.push_back(batches[c]);
         }
+        batches.swap(stitched);
+    }
+
+    // vertex effects run on the final, clipped vertices in draw order, after the chunks joined.
+    if(vertexEffect) {
+        vertexEffect->begin(skeleton);
+        for(auto& batch: batches)
+            vertexEffect->transform(batch.vertices.buffer(), batch.vertices.size());
+        vertexEffect->end();
     }
-    m_clipper->clipEnd();
 }
 
 void SpineItem::renderToCache(QQuickFramebufferObject::Renderer *renderer)
@@ -500,11 +709,24 @@ void SpineItem::renderToCache(QQuickFramebufferObject::Renderer *renderer)
         m_renderCache->setSkeletonRect(m_boundingRect);
 
     m_renderCache->bindShader(RenderCmdsCache::ShaderTexture);
+
+    const QSharedPointer<SpriteSheet> spriteSheet = m_spriteSheet;
+    if(m_bakedFrame >= 0 && spriteSheet) {
+        const auto& frame = spriteSheet->frame(m_bakedFrame);
+        RenderCmdBatch batch = bakedFrameBatch(frame.bounds, frame.uv);
+        // frames are baked premultiplied, blendColor and light still apply live.
+        m_renderCache->blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        m_renderCache->drawTriangles(SpriteSheetCache::instance()->texture(spriteSheet, window()), batch.vertices, batch.triangles,
+                                     m_blendColor, m_blendColorChannel, m_light);
+        m_requestRender = false;
+        return;
+    }
+
     bool hasBlend = false;
     foreach (const auto& batch, m_batches) {
         if(!batch.texture)
             continue;
-        if(batch.triangles.size() == 0) {
+        if(batch.triangles.size() == 0 && !batch.skinnedMesh && !batch.staticMesh) {
             hasBlend = false;
             continue;
         }
@@ -529,13 +751,32 @@ void SpineItem::renderToCache(QQuickFramebufferObject::Renderer *renderer)
             }
         }
 
-        m_renderCache->drawTriangles(
-                    AimyTextureLoader::instance()->getGLTexture(batch.texture,window()),
-                    batch.vertices,
-                    batch.triangles,
-                    m_blendColor,
-                    m_blendColorChannel,
-                    m_light);
+        if(batch.skinnedMesh)
+            m_renderCache->drawSkinnedTriangles(
+                        AimyTextureLoader::instance()->getGLTexture(batch.texture,window()),
+                        batch.skinnedMesh,
+                        batch.boneRows,
+                        batch.tint,
+                        m_blendColor,
+                        m_blendColorChannel,
+                        m_light);
+        else if(batch.staticMesh)
+            m_renderCache->drawStaticTriangles(
+                        AimyTextureLoader::instance()->getGLTexture(batch.texture,window()),
+                        batch.staticMesh,
+                        batch.positions,
+                        batch.tint,
+                        m_blendColor,
+                        m_blendColorChannel,
+                        m_light);
+        else
+            m_renderCache->drawTriangles(
+                        AimyTextureLoader::instance()->getGLTexture(batch.texture,window()),
+                        batch.vertices,
+                        batch.triangles,
+                        m_blendColor,
+                        m_blendColorChannel,
+                        m_light);
         hasBlend = true;
 
         // debug drawing
@@ -618,6 +859,157 @@ void SpineItem::setForceRenderOnHidden(bool forceRenderOnHidden)
     emit forceRenderOnHiddenChanged(m_forceRenderOnHidden);
 }
 
+QString SpineItem::bakedAnimation() const
+{
+    return m_bakedAnimation;
+}
+
+void SpineItem::setBakedAnimation(const QString &bakedAnimation)
+{
+    if(m_bakedAnimation == bakedAnimation)
+        return;
+    m_bakedAnimation = bakedAnimation;
+    emit bakedAnimationChanged(m_bakedAnimation);
+    rebakeSpriteSheet();
+}
+
+int SpineItem::bakeFps() const
+{
+    return m_bakeFps;
+}
+
+void SpineItem::setBakeFps(int bakeFps)
+{
+    if(m_bakeFps == bakeFps)
+        return;
+    m_bakeFps = bakeFps;
+    emit bakeFpsChanged(m_bakeFps);
+    rebakeSpriteSheet();
+}
+
+QSize SpineItem::bakeSize() const
+{
+    return m_bakeSize;
+}
+
+void SpineItem::setBakeSize(const QSize &bakeSize)
+{
+    if(m_bakeSize == bakeSize)
+        return;
+    m_bakeSize = bakeSize;
+    emit bakeSizeChanged(m_bakeSize);
+    rebakeSpriteSheet();
+}
+
+qreal SpineItem::bakeThreshold() const
+{
+    return m_bakeThreshold;
+}
+
+void SpineItem::setBakeThreshold(const qreal &bakeThreshold)
+{
+    m_bakeThreshold = bakeThreshold;
+    emit bakeThresholdChanged(m_bakeThreshold);
+    updateBakedPlayback();
+}
+
+qreal SpineItem::timeOffset() const
+{
+    return m_timeOffset;
+}
+
+void SpineItem::setTimeOffset(const qreal &timeOffset)
+{
+    m_timeOffset = timeOffset;
+    emit timeOffsetChanged(m_timeOffset);
+}
+
+bool SpineItem::baked() const
+{
+    return m_baked;
+}
+
+int SpineItem::currentBakedFrame() const
+{
+    // only a single, unmixed track playing the baked animation can be replaced by sheet frames.
+    if(!m_baked || !m_spriteSheet)
+        return -1;
+    auto& tracks = m_animationState->getTracks();
+    if(tracks.size() == 0 || !tracks[0])
+        return -1;
+    for(size_t i = 1; i < tracks.size(); i++) {
+        if(tracks[i])
+            return -1;
+    }
+    auto entry = tracks[0];
+    if(entry->getMixingFrom() || m_bakedAnimation != QString(entry->getAnimation()->getName().buffer()))
+        return -1;
+    return m_spriteSheet->frameAt(entry->getAnimationTime() + float(m_timeOffset), entry->getLoop());
+}
+
+void SpineItem::updateBakedPlayback()
+{
+    bool baked = false;
+    if(!m_bakedAnimation.isEmpty() && m_bakeThreshold > 0 && window()) {
+        QRectF sceneRect = mapRectToScene(QRectF(0, 0, width(), height()));
+        qreal onScreenSize = qMax(sceneRect.width(), sceneRect.height()) * window()->effectiveDevicePixelRatio();
+        // 10% hysteresis, an item resting on the threshold must not flip paths every frame.
+        baked = onScreenSize <= m_bakeThreshold * (m_baked ? 1.1 : 1.0);
+    }
+    if(m_baked == baked)
+        return;
+    m_baked = baked;
+    emit bakedChanged(m_baked);
+    // the sheet is kept when leaving baked playback, entering it again finds it in the cache.
+    if(m_baked)
+        rebakeSpriteSheet();
+    markPoseDirty();
+}
+
+void SpineItem::rebakeSpriteSheet()
+{
+    // outside of baked playback this only drops the outdated sheet, it is baked on entering it.
+    if(isSkeletonReady() && m_spWorker)
+        QMetaObject::invokeMethod(m_spWorker.get(), "bakeSpriteSheet");
+}
+
+bool SpineItem::gpuSkinning() const
+{
+    return m_gpuSkinning;
+}
+
+void SpineItem::setGpuSkinning(bool gpuSkinning)
+{
+    if(m_gpuSkinning == gpuSkinning)
+        return;
+    m_gpuSkinning = gpuSkinning;
+    emit gpuSkinningChanged(m_gpuSkinning);
+    markPoseDirty();
+}
+
+SkinnedMeshCache *SpineItem::activeSkinnedMeshes() const
+{
+    if(!m_gpuSkinning || !m_renderCache->skinningSupported())
+        return nullptr;
+    return m_skinnedMeshes.data();
+}
+
+void SpineItem::markPoseDirty()
+{
+    m_poseDirty = true;
+    if(m_animating || !isSkeletonReady() || (!isVisible() && !m_forceRenderOnHidden))
+        return;
+    m_animating = true;
+    emit animationUpdated();
+}
+
+void SpineItem::markRenderDirty()
+{
+    // a running loop draws the new values with its next frame anyway.
+    if(!m_animating)
+        update();
+}
+
 void SpineItem::classBegin()
 {
 }
@@ -656,6 +1048,7 @@ void SpineItem::setLight(float light)
 {
     m_light = light;
     emit lightChanged(m_light);
+    markRenderDirty();
 }
 
 bool SpineItem::debugMesh() const
@@ -667,6 +1060,7 @@ void SpineItem::setDebugMesh(bool debugMesh)
 {
     m_debugMesh = debugMesh;
     emit debugMeshChanged(m_debugMesh);
+    markRenderDirty();
 }
 
 int SpineItem::blendColorChannel() const
@@ -678,6 +1072,7 @@ void SpineItem::setBlendColorChannel(int blendColorChannel)
 {
     m_blendColorChannel = blendColorChannel;
     emit blendColorChannelChanged(m_blendColorChannel);
+    markRenderDirty();
 }
 
 QColor SpineItem::blendColor() const
@@ -689,6 +1084,7 @@ void SpineItem::setBlendColor(const QColor &color)
 {
     m_blendColor = color;
     emit blendColorChanged(color);
+    markRenderDirty();
 }
 
 QObject *SpineItem::vertexEfect() const
@@ -700,6 +1096,7 @@ void SpineItem::setVertexEfect(QObject *vertexEfect)
 {
     m_vertexEfect = (SpineVertexEffect*)vertexEfect;
     emit vertexEfectChanged();
+    markPoseDirty();
 }
 
 qreal SpineItem::scaleY() const
@@ -715,6 +1112,8 @@ void SpineItem::setScaleY(const qreal &value)
     if(isSkeletonReady())
         m_skeleton->setScaleY(m_scaleY * m_skeletonScale);
     emit scaleYChanged(m_scaleY);
+    rebakeSpriteSheet();
+    markPoseDirty();
 }
 
 qreal SpineItem::scaleX() const
@@ -730,6 +1129,8 @@ void SpineItem::setScaleX(const qreal &value)
     if(isSkeletonReady())
         m_skeleton->setScaleX(m_scaleX * m_skeletonScale);
     emit scaleXChanged(m_scaleX);
+    rebakeSpriteSheet();
+    markPoseDirty();
 }
 
 qreal SpineItem::defaultMix() const
@@ -760,6 +1161,7 @@ void SpineItem::setTimeScale(const qreal &timeScale)
 {
     m_timeScale = timeScale;
     emit timeScaleChanged(m_timeScale);
+    markPoseDirty();
 }
 
 int SpineItem::fps() const
@@ -788,6 +1190,8 @@ void SpineItem::setSkeletonScale(const qreal &skeletonScale)
         m_skeleton->setScaleY(m_scaleY * m_skeletonScale);
     }
     emit skeletonScaleChanged(m_skeletonScale);
+    rebakeSpriteSheet();
+    markPoseDirty();
 }
 
 QStringList SpineItem::animations() const
@@ -809,6 +1213,7 @@ void SpineItem::setDebugSlots(bool debugSlots)
 {
     m_debugSlots = debugSlots;
     emit debugSlotsChanged(m_debugSlots);
+    markRenderDirty();
 }
 
 bool SpineItem::debugBones() const
@@ -820,6 +1225,7 @@ void SpineItem::setDebugBones(bool debugBones)
 {
     m_debugBones = debugBones;
     emit debugBonesChanged(m_debugBones);
+    markRenderDirty();
 }
 
 bool SpineItem::loaded() const
@@ -843,6 +1249,7 @@ void SpineItem::updateBoundingRect()
     if(m_requestDestroy)
         return;
     setSourceSize(QSize(m_boundingRect.width(), m_boundingRect.height()));
+    updateBakedPlayback();
     if(m_hasViewPort)
         setImplicitSize(m_viewPortRect.width(), m_viewPortRect.height());
     else
@@ -860,7 +1267,7 @@ void SpineItem::onCacheRendered()
 void SpineItem::onVisibleChanged()
 {
     if(isSkeletonReady() && isVisible() && !m_forceRenderOnHidden)
-        emit animationUpdated();
+        markPoseDirty();
 }
 
 void SpineItem::reloadResource()
@@ -897,11 +1304,14 @@ void SpineItemWorker::updateSkeletonAnimation()
     }
     m_spItem->m_tickCounter.restart();
 
-    if(m_spItem->m_animationState->getTracks().size() <= 0 || (!m_spItem->isVisible() && !m_spItem->m_forceRenderOnHidden)) {
+    if((m_spItem->m_animationState->getTracks().size() <= 0 && !m_spItem->m_poseDirty)
+            || (!m_spItem->isVisible() && !m_spItem->m_forceRenderOnHidden)) {
         if(m_fadecounter > 0)
             m_fadecounter--;
-        else
+        else {
+            m_spItem->m_animating = false;
             return;
+        }
     }
     else
         m_fadecounter = 1;
@@ -913,6 +1323,27 @@ void SpineItemWorker::updateSkeletonAnimation()
         msecs = m_spItem->m_timer.restart();
     const float deltaTime = msecs / 1000.0 * m_spItem->m_timeScale;
     m_spItem->m_animationState->update(deltaTime);
+
+    // paused, held on a last frame or otherwise unchanged: the fbo keeps the last frame.
+    if(!m_spItem->m_poseDirty && !m_spItem->m_animationState->needsApply()) {
+        stopIdle();
+        return;
+    }
+
+    // baked playback skips posing, world transforms and batching, the timeline events still fire.
+    int bakedFrame = m_spItem->currentBakedFrame();
+    if(bakedFrame >= 0 && m_spItem->m_animationState->applyEvents(*m_spItem->m_skeleton.get())) {
+        // ticks faster than the sheet fps keep the loop and the events running, the frame stays batched.
+        if(bakedFrame != m_spItem->m_bakedFrame || m_spItem->m_poseDirty) {
+            m_spItem->m_poseDirty = false;
+            m_spItem->m_boundingRect = m_spItem->m_spriteSheet->frame(bakedFrame).bounds;
+            m_spItem->batchBakedFrame(bakedFrame);
+        }
+        emit m_spItem->animationUpdated();
+        return;
+    }
+    m_spItem->m_poseDirty = false;
+
     m_spItem->m_animationState->apply(*m_spItem->m_skeleton.get());
     m_spItem->m_skeleton->updateWorldTransform();
 
@@ -921,6 +1352,13 @@ void SpineItemWorker::updateSkeletonAnimation()
     emit m_spItem->animationUpdated();
 }
 
+void SpineItemWorker::stopIdle()
+{
+    m_spItem->m_animating = false;
+    // the next tick after resuming must not jump over the idle time.
+    m_spItem->m_timer.invalidate();
+}
+
 void SpineItemWorker::loadResource()
 {
     if(!m_spItem->isComponentComplete()) {
@@ -956,8 +1394,14 @@ void SpineItemWorker::loadResource()
         return;
     }
 
-    m_spItem->m_atlas.reset(new spine::Atlas(urltospinestring(m_spItem->m_atlasFile),
-                                   AimyTextureLoader::instance()));
+    // Atlas and skeleton data are allocated from one arena, released with the last of them. The file contents and
+    // the parsed json document are only temporaries, the readers keep them out of the arena.
+    QSharedPointer<spine::Arena> arena(new spine::Arena);
+    {
+        spine::ArenaExtension::Scope scope(arena.data());
+        resetInArena(m_spItem->m_atlas, new spine::Atlas(urltospinestring(m_spItem->m_atlasFile),
+                                                         AimyTextureLoader::instance()), arena);
+    }
 
     if(m_spItem->m_atlas->getPages().size() == 0) {
         qWarning() << "Failed to load atlas..." << QString(urltospinestring(m_spItem->m_atlasFile).buffer());
@@ -967,7 +1411,10 @@ void SpineItemWorker::loadResource()
 
     spine::SkeletonJson json(m_spItem->m_atlas.get());
     json.setScale(1);
-    m_spItem->m_skeletonData.reset(json.readSkeletonDataFile(urltospinestring(m_spItem->m_skeletonFile)));
+    {
+        spine::ArenaExtension::Scope scope(arena.data());
+        resetInArena(m_spItem->m_skeletonData, json.readSkeletonDataFile(urltospinestring(m_spItem->m_skeletonFile)), arena);
+    }
     if(m_spItem->m_skeletonData.isNull()) {
         qWarning() << json.getError().buffer();
         emit m_spItem->resourceLoadFailed();
@@ -1006,9 +1453,11 @@ void SpineItemWorker::loadResource()
     emit m_spItem->loadedChanged(m_spItem->m_loaded);
     emit m_spItem->isSkeletonReadyChanged(m_spItem->isSkeletonReady());
 
+    m_spItem->m_staticMeshes->build(*m_spItem->m_skeleton);
     m_spItem->m_skeleton->updateWorldTransform();
     m_spItem->m_boundingRect = m_spItem->computeBoundingRect();
     m_spItem->batchRenderCmd();
+    bakeSpriteSheet();
     QThread::msleep(1);
     emit m_spItem->animationUpdated();
     if(m_spItem->m_requestDestroy)
@@ -1042,6 +1491,8 @@ void SpineItemWorker::addAnimation(int trackIndex, const QString &name, bool loo
     }
     m_spItem->m_animationState->addAnimation(size_t(trackIndex), qstringtospinestring(name), loop, delay);
     m_spItem->m_timer.restart();
+    // a queued entry only starts while the state is updated, wake an item held on its last frame.
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::setToSetupPose()
@@ -1053,6 +1504,7 @@ void SpineItemWorker::setToSetupPose()
     m_spItem->m_skeleton->setToSetupPose();
     m_spItem->m_animationState->apply(*m_spItem->m_skeleton.get());
     m_spItem->m_skeleton->updateWorldTransform();
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::setBonesToSetupPose()
@@ -1062,6 +1514,7 @@ void SpineItemWorker::setBonesToSetupPose()
         return;
     }
     m_spItem->m_skeleton->setBonesToSetupPose();
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::setSlotsToSetupPose()
@@ -1071,6 +1524,7 @@ void SpineItemWorker::setSlotsToSetupPose()
         return;
     }
     m_spItem->m_skeleton->setSlotsToSetupPose();
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::setAttachment(const QString &slotName, const QString &attachmentName)
@@ -1080,6 +1534,7 @@ void SpineItemWorker::setAttachment(const QString &slotName, const QString &atta
         return;
     }
     m_spItem->m_skeleton->setAttachment(spine::String(slotName.toStdString().data()), spine::String(attachmentName.toStdString().data()));
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::setMix(const QString &fromAnimation, const QString &toAnimation, float duration)
@@ -1104,6 +1559,9 @@ void SpineItemWorker::setSkin(const QString &skinName)
         qWarning() <<  "no " << skinName << " found, vailable skins is: " << m_spItem->m_skins;
     }
     m_spItem->m_skeleton->setSkin(skinName.toStdString().c_str());
+    m_spItem->m_staticMeshes->build(*m_spItem->m_skeleton);
+    bakeSpriteSheet();
+    m_spItem->markPoseDirty();
 }
 
 void SpineItemWorker::clearTracks()
@@ -1127,6 +1585,44 @@ void SpineItemWorker::clearTrack(int trackIndex)
         m_spItem->m_animating = false;
 }
 
+void SpineItemWorker::bakeSpriteSheet()
+{
+    if(!m_spItem->isSkeletonReady() || m_spItem->m_bakedAnimation.isEmpty() || !m_spItem->m_baked) {
+        m_spItem->m_spriteSheet.reset();
+        return;
+    }
+    SpriteSheetKey key;
+    key.atlasFile = m_spItem->m_atlasFile.toString();
+    key.skeletonFile = m_spItem->m_skeletonFile.toString();
+    auto skin = m_spItem->m_skeleton->getSkin();
+    key.skin = skin ? QString(skin->getName().buffer()) : QString();
+    key.animation = m_spItem->m_bakedAnimation;
+    key.fps = m_spItem->m_bakeFps;
+    key.frameSize = m_spItem->m_bakeSize;
+    key.scaleX = m_spItem->m_skeleton->getScaleX();
+    key.scaleY = m_spItem->m_skeleton->getScaleY();
+    m_spItem->m_spriteSheet = SpriteSheetCache::instance()->sheet(key, m_spItem->m_skeletonData.get());
+}
+
+QImage SpineItemWorker::renderToImage(const QSize &size)
+{
+    SoftwareRenderer renderer;
+    renderer.setBlendColor(m_spItem->m_blendColor);
+    renderer.setBlendColorChannel(m_spItem->m_blendColorChannel);
+    renderer.setLight(m_spItem->m_light);
+    const QRectF skeletonRect = m_spItem->m_hasViewPort ? m_spItem->m_viewPortRect : m_spItem->m_boundingRect;
+    QImage image;
+    const QSharedPointer<SpriteSheet> spriteSheet = m_spItem->m_spriteSheet;
+    if(m_spItem->m_bakedFrame >= 0 && spriteSheet) {
+        const auto& frame = spriteSheet->frame(m_spItem->m_bakedFrame);
+        std::vector<RenderCmdBatch> batches(1, SpineItem::bakedFrameBatch(frame.bounds, frame.uv));
+        renderer.render(batches, spriteSheet->image(), skeletonRect, size, image);
+    } else {
+        renderer.render(m_spItem->m_batches, skeletonRect, size, image);
+    }
+    return image;
+}
+
 void SpineItemWorker::timerEvent(QTimerEvent *event)
 {
     qDebug() << "SpineItemWorker::timerEvent(QTimerEvent *event) " << m_reloadTimerID << event->timerId() << m_neadReloadResource;
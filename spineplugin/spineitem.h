@@ -5,6 +5,7 @@
 #include <QElapsedTimer>
 #include <QSGTexture>
 #include <QFuture>
+#include <QImage>
 
 #include "rendercmdscache.h"
 
@@ -17,6 +18,11 @@ class AimyTextureLoader;
 class Texture;
 class SpineVertexEffect;
 class SkeletonRenderer;
+class SpriteSheet;
+class StaticMesh;
+class StaticMeshCache;
+class SkinnedMesh;
+class SkinnedMeshCache;
 
 namespace spine {
 class Atlas;
@@ -35,6 +41,14 @@ struct RenderCmdBatch{
     spine::Vector<GLushort> triangles;
     Texture* texture = nullptr;
     int blendMode;
+    // gpu skinned weighted mesh, vertices and triangles stay empty and the mesh is posed by boneRows.
+    QSharedPointer<SkinnedMesh> skinnedMesh;
+    spine::Vector<float> boneRows;
+    // region or mesh with static uvs and indices, vertices and triangles stay empty and the world positions are in positions.
+    QSharedPointer<StaticMesh> staticMesh;
+    spine::Vector<float> positions;
+    // vertex color of skinned and static batches.
+    spine::Color tint;
 };
 
 class SpineItem : public QQuickFramebufferObject
@@ -63,6 +77,13 @@ class SpineItem : public QQuickFramebufferObject
     Q_PROPERTY(float light READ light WRITE setLight NOTIFY lightChanged)
     Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
     Q_PROPERTY(bool forceRenderOnHidden READ forceRenderOnHidden WRITE setForceRenderOnHidden NOTIFY forceRenderOnHiddenChanged)
+    Q_PROPERTY(QString bakedAnimation READ bakedAnimation WRITE setBakedAnimation NOTIFY bakedAnimationChanged) // animation played from a shared sprite sheet when small on screen, empty=always live
+    Q_PROPERTY(int bakeFps READ bakeFps WRITE setBakeFps NOTIFY bakeFpsChanged)
+    Q_PROPERTY(QSize bakeSize READ bakeSize WRITE setBakeSize NOTIFY bakeSizeChanged) // max pixel size of a baked frame
+    Q_PROPERTY(qreal bakeThreshold READ bakeThreshold WRITE setBakeThreshold NOTIFY bakeThresholdChanged) // on screen pixel size below which baked frames are shown
+    Q_PROPERTY(qreal timeOffset READ timeOffset WRITE setTimeOffset NOTIFY timeOffsetChanged) // seconds, shifts baked playback per instance
+    Q_PROPERTY(bool baked READ baked NOTIFY bakedChanged)
+    Q_PROPERTY(bool gpuSkinning READ gpuSkinning WRITE setGpuSkinning NOTIFY gpuSkinningChanged) // skin weighted meshes in the vertex shader
 
     Q_INTERFACES(QQmlParserStatus)
 
@@ -127,6 +148,15 @@ public:
      * @param trackIndex
      */
     Q_INVOKABLE void clearTrack(int trackIndex = 0);
+    /**
+     * @brief renderToImage Rasterizes the last batched frame on the cpu with SoftwareRenderer, no GL context needed.
+     *
+     * The worker owns the batches, so this blocks until it has rasterized them on its thread. In baked playback
+     * the current frame of the sprite sheet is drawn.
+     * @param size Output size, the item size when invalid.
+     * @return Premultiplied ARGB32 image of what the item framebuffer shows.
+     */
+    Q_INVOKABLE QImage renderToImage(const QSize& size = QSize()) const;
 
     friend class SpineItemWorker;
     friend class SkeletonRenderer;
@@ -200,6 +230,39 @@ public:
     bool forceRenderOnHidden() const;
     void setForceRenderOnHidden(bool forceRenderOnHidden);
 
+    QString bakedAnimation() const;
+    void setBakedAnimation(const QString &bakedAnimation);
+
+    int bakeFps() const;
+    void setBakeFps(int bakeFps);
+
+    QSize bakeSize() const;
+    void setBakeSize(const QSize &bakeSize);
+
+    qreal bakeThreshold() const;
+    void setBakeThreshold(const qreal &bakeThreshold);
+
+    qreal timeOffset() const;
+    void setTimeOffset(const qreal &timeOffset);
+
+    bool baked() const;
+
+    bool gpuSkinning() const;
+    void setGpuSkinning(bool gpuSkinning);
+
+    /**
+     * @brief buildRenderBatches Builds the draw order batches of a posed skeleton, shared by the live path and sprite sheet baking.
+     *
+     * Slots are settled in draw order first, then large skeletons compute their world vertices, tints and
+     * clipping in draw order chunks on the global thread pool, each chunk filling its own batches.
+     * @param clipper Used when the skeleton is batched on the calling thread, chunks clip with their own.
+     * @param skinnedMeshes Weighted meshes found in it become gpu skinned batches, unless clipped or a vertex effect is set.
+     * @param staticMeshes Other regions and meshes become static batches that only carry world positions, same conditions.
+     */
+    static void buildRenderBatches(spine::Skeleton& skeleton, spine::SkeletonClipping& clipper,
+                                   std::vector<RenderCmdBatch>& batches, SpineVertexEffect* vertexEffect = nullptr,
+                                   SkinnedMeshCache* skinnedMeshes = nullptr, StaticMeshCache* staticMeshes = nullptr);
+
 signals:
 
     // property signals
@@ -228,6 +291,13 @@ signals:
     void lightChanged(const float& light);
     void asynchronousChanged(const bool& asynchronous);
     void forceRenderOnHiddenChanged(const bool& forceRenderOnHidden);
+    void bakedAnimationChanged(const QString& bakedAnimation);
+    void bakeFpsChanged(const int& bakeFps);
+    void bakeSizeChanged(const QSize& bakeSize);
+    void bakeThresholdChanged(const qreal& bakeThreshold);
+    void timeOffsetChanged(const qreal& timeOffset);
+    void bakedChanged(const bool& baked);
+    void gpuSkinningChanged(const bool& gpuSkinning);
 
     // rumtime signals
     void animationStarted(int trackId, QString animationName);
@@ -252,10 +322,30 @@ private:
     void loadResource();
     void updateSkeletonAnimation();
     QRectF computeBoundingRect();
-    Texture* getTexture(spine::Attachment* attachment) const;
+    static Texture* getTexture(spine::Attachment* attachment);
     void releaseSkeletonRelatedData();
-    bool nothingToDraw(spine::Slot& slot);
+    static bool nothingToDraw(spine::Slot& slot);
     void batchRenderCmd();
+    void batchBakedFrame(int frame);
+    /**
+     * @brief bakedFrameBatch The quad of a baked frame in skeleton space, textured by the sprite sheet.
+     * @param bounds Skeleton space rect of the frame.
+     * @param uv Normalized rect of the frame in the sheet image.
+     */
+    static RenderCmdBatch bakedFrameBatch(const QRectF& bounds, const QRectF& uv);
+    int currentBakedFrame() const;
+    void updateBakedPlayback();
+    void rebakeSpriteSheet();
+    SkinnedMeshCache* activeSkinnedMeshes() const;
+    /**
+     * @brief markPoseDirty The skeleton or its batching changed outside of the animation state. Wakes an idle item
+     * to apply, batch and draw again.
+     */
+    void markPoseDirty();
+    /**
+     * @brief markRenderDirty Only uniforms or debug drawing changed, an idle item redraws its last batches once.
+     */
+    void markRenderDirty();
     void renderToCache(QQuickFramebufferObject::Renderer* renderer);
 
 private:
@@ -269,6 +359,7 @@ private:
     bool m_hasViewPort = false;
     bool m_asynchronous = true;
     bool m_animating = false;
+    bool m_poseDirty = true;
     qreal m_scaleX = 1.0;
     qreal m_scaleY = 1.0;
     qreal m_timeScale = 1.0;
@@ -303,6 +394,17 @@ private:
     std::vector<RenderCmdBatch> m_batches;
     bool m_requestRender = false;
     bool m_forceRenderOnHidden = false;
+    QString m_bakedAnimation;
+    int m_bakeFps = 30;
+    QSize m_bakeSize = QSize(256, 256);
+    qreal m_bakeThreshold = 128;
+    qreal m_timeOffset = 0;
+    bool m_baked = false;
+    int m_bakedFrame = -1;
+    QSharedPointer<SpriteSheet> m_spriteSheet;
+    bool m_gpuSkinning = false;
+    QSharedPointer<SkinnedMeshCache> m_skinnedMeshes;
+    QSharedPointer<StaticMeshCache> m_staticMeshes;
 };
 
 class SpineItemWorker: public QObject{
@@ -323,10 +425,21 @@ public slots:
     void setSkin(const QString& skinName);
     void clearTracks ();
     void clearTrack(int trackIndex = 0);
+    void bakeSpriteSheet();
+    /**
+     * @brief renderToImage Rasterizes the last batched frame, see SpineItem::renderToImage.
+     */
+    QImage renderToImage(const QSize& size);
 
 protected:
     void timerEvent(QTimerEvent *event) override;
 
+private:
+    /**
+     * @brief stopIdle Ends the update loop of an unchanged item, markPoseDirty or a started animation resumes it.
+     */
+    void stopIdle();
+
 private:
     SpineItem* m_spItem = nullptr;
     int m_fadecounter = 1; // make sure last state textue has been render.
@@ -10,17 +10,25 @@ uri = Beelab.SpineItem
 SOURCES += \
         rendercmdscache.cpp \
         skeletonrenderer.cpp \
+        skinnedmesh.cpp \
+        softwarerenderer.cpp \
         spineplugin_plugin.cpp \
         spineitem.cpp \
         spinevertexeffect.cpp \
+        spritesheetcache.cpp \
+        staticmesh.cpp \
         texture.cpp
 
 HEADERS += \
         rendercmdscache.h \
         skeletonrenderer.h \
+        skinnedmesh.h \
+        softwarerenderer.h \
         spineplugin_plugin.h \
         spineitem.h \
         spinevertexeffect.h \
+        spritesheetcache.h \
+        staticmesh.h \
         texture.h
 
 DISTFILES = qmldir
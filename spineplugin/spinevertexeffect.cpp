@@ -1,10 +1,71 @@
 #include "spinevertexeffect.h"
 
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VERTEX_EFFECT_SSE2
+#endif
+
+namespace {
+const int SwirlSamples = 1024;
+const float RandomUnit = 1.0f / 16777216.0f;
+
+#ifdef VERTEX_EFFECT_SSE2
+// four independent xorshift32 generators, uniform floats in [0, 1) from their top 24 bits.
+inline __m128 nextRandom(__m128i& state)
+{
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+    state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+    return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(state, 8)), _mm_set1_ps(RandomUnit));
+}
+#endif
+
+// the same lanes as nextRandom, so builds without sse2 jitter alike.
+inline void nextRandom(quint32* state, float* out)
+{
+    for (int i = 0; i < 4; i++) {
+        quint32 x = state[i];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[i] = x;
+        out[i] = float(x >> 8) * RandomUnit;
+    }
+}
+
+inline void swirl(SpineVertex& vertex, float worldX, float worldY, float radius, const float* rotations)
+{
+    float x = vertex.x - worldX, y = vertex.y - worldY;
+    float dist = std::sqrt(x * x + y * y);
+    if (dist >= radius)
+        return;
+    float t = (radius - dist) * (SwirlSamples / radius);
+    int index = int(t);
+    float frac = t - index;
+    const float* rotation = rotations + index * 2;
+    float cos = rotation[0] + (rotation[2] - rotation[0]) * frac;
+    float sin = rotation[1] + (rotation[3] - rotation[1]) * frac;
+    vertex.x = cos * x - sin * y + worldX;
+    vertex.y = sin * x + cos * y + worldY;
+}
+}
+
 SpineVertexEffect::SpineVertexEffect(QObject *parent) : QObject(parent)
 {
 
 }
 
+void SpineVertexEffect::transform(SpineVertex *vertices, size_t count)
+{
+    spine::Color dark;
+    for (size_t i = 0; i < count; i++) {
+        auto& vertex = vertices[i];
+        transform(vertex.x, vertex.y, vertex.u, vertex.v, vertex.color, dark);
+    }
+}
+
 SpineJitterVertexEffect::SpineJitterVertexEffect(QObject *parent):
     SpineVertexEffect(parent),
     m_jitterEffect(new spine::JitterVertexEffect(0, 0))
@@ -22,6 +83,48 @@ void SpineJitterVertexEffect::transform(float &x, float &y, float &u, float &v,
     m_jitterEffect->transform(x, y, u, v, light, dark);
 }
 
+void SpineJitterVertexEffect::transform(SpineVertex *vertices, size_t count)
+{
+    const float jitterX = m_jitterEffect->getJitterX(), jitterY = m_jitterEffect->getJitterY();
+    if (jitterX == 0 && jitterY == 0)
+        return;
+    // the sum of two uniform numbers minus one is triangular in [-1, 1), like MathUtil::randomTriangular.
+    // lanes are x, y of one vertex and x, y of the next.
+#ifdef VERTEX_EFFECT_SSE2
+    __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_random));
+    const __m128 scale = _mm_setr_ps(jitterX, jitterY, jitterX, jitterY);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (size_t i = 0; i < count; i += 2) {
+        __m128 r1 = nextRandom(state);
+        __m128 r2 = nextRandom(state);
+        __m128 offset = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(r1, r2), one), scale);
+        __m64* first = reinterpret_cast<__m64*>(&vertices[i].x);
+        if (i + 1 < count) {
+            __m64* second = reinterpret_cast<__m64*>(&vertices[i + 1].x);
+            __m128 xy = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), first), second);
+            xy = _mm_add_ps(xy, offset);
+            _mm_storel_pi(first, xy);
+            _mm_storeh_pi(second, xy);
+        } else {
+            _mm_storel_pi(first, _mm_add_ps(_mm_loadl_pi(_mm_setzero_ps(), first), offset));
+        }
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(m_random), state);
+#else
+    const float scale[4] = {jitterX, jitterY, jitterX, jitterY};
+    float r1[4], r2[4];
+    for (size_t i = 0; i < count; i += 2) {
+        nextRandom(m_random, r1);
+        nextRandom(m_random, r2);
+        for (size_t lane = 0; lane < 4 && i + lane / 2 < count; lane += 2) {
+            auto& vertex = vertices[i + lane / 2];
+            vertex.x += (r1[lane] + r2[lane] - 1.0f) * scale[lane];
+            vertex.y += (r1[lane + 1] + r2[lane + 1] - 1.0f) * scale[lane + 1];
+        }
+    }
+#endif
+}
+
 void SpineJitterVertexEffect::end()
 {
     m_jitterEffect->end();
@@ -84,7 +187,8 @@ int SpinePowInterpolation::pow() const
 void SpinePowInterpolation::setPow(int pow)
 {
     m_pow = pow;
-    m_powInterpolation.reset(new spine::PowInterpolation(m_pow));
+    // in place, swirl effects keep a reference to it.
+    m_powInterpolation->power = m_pow;
     emit powChanged();
 }
 
@@ -118,25 +222,90 @@ int SpinePowOutInterpolation::pow() const
 void SpinePowOutInterpolation::setPow(int pow)
 {
     m_pow = pow;
-    m_powOutInterpolation.reset(new spine::PowOutInterpolation(m_pow));
+    m_powOutInterpolation->power = m_pow;
     emit powChanged();
 }
 
 SpineSwrilVertexEffect::SpineSwrilVertexEffect(QObject *parent):
-    SpineVertexEffect(parent)
+    SpineVertexEffect(parent),
+    m_defaultInterpolation(new spine::PowInterpolation(2))
 {
-    spine::PowInterpolation pow2(2);
-    m_swrilEffect.reset(new spine::SwirlVertexEffect(0.0, pow2));
+    m_interpolation = m_defaultInterpolation.data();
+    m_swrilEffect.reset(new spine::SwirlVertexEffect(0.0, *m_interpolation));
 }
 
 void SpineSwrilVertexEffect::begin(spine::Skeleton &skeleton)
 {
     m_swrilEffect->begin(skeleton);
+    if (m_rotationsDirty)
+        buildRotations();
 }
 
 void SpineSwrilVertexEffect::transform(float &x, float &y, float &u, float &v, spine::Color &light, spine::Color &dark)
 {
-    m_swrilEffect->transform(x, y, y, v, light, dark);
+    m_swrilEffect->transform(x, y, u, v, light, dark);
+}
+
+void SpineSwrilVertexEffect::transform(SpineVertex *vertices, size_t count)
+{
+    const float radius = m_swrilEffect->getRadius();
+    if (radius <= 0 || m_swrilEffect->getAngle() == 0)
+        return;
+    const float worldX = m_swrilEffect->getWorldX(), worldY = m_swrilEffect->getWorldY();
+    const float* rotations = m_rotations.constData();
+    size_t i = 0;
+#ifdef VERTEX_EFFECT_SSE2
+    const __m128 centerX = _mm_set1_ps(worldX), centerY = _mm_set1_ps(worldY);
+    const __m128 radiusSquared = _mm_set1_ps(radius * radius);
+    const __m128 radius4 = _mm_set1_ps(radius), scale = _mm_set1_ps(SwirlSamples / radius);
+    for (; i + 4 <= count; i += 4) {
+        SpineVertex* v = vertices + i;
+        __m128 x = _mm_sub_ps(_mm_setr_ps(v[0].x, v[1].x, v[2].x, v[3].x), centerX);
+        __m128 y = _mm_sub_ps(_mm_setr_ps(v[0].y, v[1].y, v[2].y, v[3].y), centerY);
+        __m128 distSquared = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+        __m128 inside = _mm_cmplt_ps(distSquared, radiusSquared);
+        int mask = _mm_movemask_ps(inside);
+        if (!mask)
+            continue;
+        // outside lanes clamp to the first sample and are masked out below.
+        __m128 t = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(radius4, _mm_sqrt_ps(distSquared)), scale), _mm_setzero_ps());
+        __m128i index = _mm_cvttps_epi32(t);
+        __m128 frac = _mm_sub_ps(t, _mm_cvtepi32_ps(index));
+        alignas(16) int indices[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+        const float* r0 = rotations + indices[0] * 2;
+        const float* r1 = rotations + indices[1] * 2;
+        const float* r2 = rotations + indices[2] * 2;
+        const float* r3 = rotations + indices[3] * 2;
+        __m128 cos0 = _mm_setr_ps(r0[0], r1[0], r2[0], r3[0]), cos1 = _mm_setr_ps(r0[2], r1[2], r2[2], r3[2]);
+        __m128 sin0 = _mm_setr_ps(r0[1], r1[1], r2[1], r3[1]), sin1 = _mm_setr_ps(r0[3], r1[3], r2[3], r3[3]);
+        __m128 cos = _mm_add_ps(cos0, _mm_mul_ps(_mm_sub_ps(cos1, cos0), frac));
+        __m128 sin = _mm_add_ps(sin0, _mm_mul_ps(_mm_sub_ps(sin1, sin0), frac));
+        alignas(16) float outX[4], outY[4];
+        _mm_store_ps(outX, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(cos, x), _mm_mul_ps(sin, y)), centerX));
+        _mm_store_ps(outY, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sin, x), _mm_mul_ps(cos, y)), centerY));
+        for (int lane = 0; lane < 4; lane++) {
+            if (mask & (1 << lane)) {
+                v[lane].x = outX[lane];
+                v[lane].y = outY[lane];
+            }
+        }
+    }
+#endif
+    for (; i < count; i++)
+        swirl(vertices[i], worldX, worldY, radius, rotations);
+}
+
+void SpineSwrilVertexEffect::buildRotations()
+{
+    // one extra sample so t == SwirlSamples still interpolates.
+    const float angle = m_swrilEffect->getAngle();
+    m_rotations.resize((SwirlSamples + 2) * 2);
+    for (int i = 0; i <= SwirlSamples + 1; i++) {
+        float theta = m_interpolation->interpolate(0, angle, qMin(i, SwirlSamples) / float(SwirlSamples));
+        spine::MathUtil::sincos(theta, m_rotations[i * 2 + 1], m_rotations[i * 2]);
+    }
+    m_rotationsDirty = false;
 }
 
 void SpineSwrilVertexEffect::end()
@@ -151,8 +320,19 @@ QObject *SpineSwrilVertexEffect::interpolator()
 
 void SpineSwrilVertexEffect::setInterpolator(QObject *val)
 {
+    disconnect(m_interpolatorConnection);
     m_interpolator = (SpineInterpolation*)val;
-    m_swrilEffect.reset(new spine::SwirlVertexEffect(m_radius, *m_interpolator->interpolation()));
+    m_interpolation = m_interpolator ? m_interpolator->interpolation() : m_defaultInterpolation.data();
+    if (m_interpolator)
+        m_interpolatorConnection = connect(m_interpolator, &SpineInterpolation::powChanged, this, [this]() { m_rotationsDirty = true; });
+    m_swrilEffect.reset(new spine::SwirlVertexEffect(m_radius, *m_interpolation));
+    m_swrilEffect->setCenterX(m_centerX);
+    m_swrilEffect->setCenterY(m_centerY);
+    m_swrilEffect->setAngle(m_angle);
+    m_swrilEffect->setWorldX(m_worldX);
+    m_swrilEffect->setWorldY(m_worldY);
+    m_rotationsDirty = true;
+    emit interpolatorChanged();
 }
 
 float SpineSwrilVertexEffect::centerX() const
@@ -200,6 +380,7 @@ void SpineSwrilVertexEffect::setAngle(float angle)
 {
     m_angle = angle;
     m_swrilEffect->setAngle(m_angle);
+    m_rotationsDirty = true;
     emit angleChanged();
 }
 
@@ -3,7 +3,9 @@
 
 #include <QObject>
 #include <QSharedPointer>
+#include <QVector>
 #include "spine/spine.h"
+#include "rendercmdscache.h"
 
 class SpineVertexEffect : public QObject
 {
@@ -12,6 +14,13 @@ public:
     explicit SpineVertexEffect(QObject *parent = nullptr);
     virtual void begin(spine::Skeleton& skeleton) = 0;
     virtual void transform(float& x, float& y, float &u, float &v, spine::Color &light, spine::Color &dark) = 0;
+    /**
+     * @brief transform Applies the effect to count vertices of a batch in place, between begin and end.
+     *
+     * SpineItem::buildRenderBatches calls this once per batch with the final, clipped vertices. The
+     * default adapts the per vertex transform, effects override it with a vectorized version.
+     */
+    virtual void transform(SpineVertex* vertices, size_t count);
     virtual void end() = 0;
 
 private:
@@ -28,6 +37,10 @@ public:
 
     virtual void begin(spine::Skeleton& skeleton);
     virtual void transform(float& x, float& y, float &u, float &v, spine::Color &light, spine::Color &dark);
+    /**
+     * @brief transform Offsets two vertices per step by triangular noise from four xorshift lanes.
+     */
+    virtual void transform(SpineVertex* vertices, size_t count);
     virtual void end();
 
     float jitterX() const;
@@ -41,6 +54,7 @@ signals:
 
 private:
     QSharedPointer<spine::JitterVertexEffect> m_jitterEffect;
+    quint32 m_random[4] = {0x9e3779b9u, 0x7f4a7c15u, 0x85ebca6bu, 0xc2b2ae35u};
 };
 
 class SpineInterpolation: public QObject{
@@ -113,6 +127,11 @@ public:
 
     virtual void begin(spine::Skeleton& skeleton);
     virtual void transform(float& x, float& y, float &u, float &v, spine::Color &light, spine::Color &dark);
+    /**
+     * @brief transform Culls four vertices at a time against the radius and rotates the ones inside by the
+     * cosine and sine of their angle, interpolated from a table rebuilt when the angle or interpolation changes.
+     */
+    virtual void transform(SpineVertex* vertices, size_t count);
     virtual void end();
 
     QObject* interpolator();
@@ -154,7 +173,16 @@ private:
     float m_angle = 0;
     float m_worldX = 0;
     float m_worldY = 0;
+    // the effect keeps a reference to its interpolation, this one is used until an interpolator is set.
+    QSharedPointer<spine::PowInterpolation> m_defaultInterpolation;
+    spine::Interpolation* m_interpolation = nullptr;
+    QMetaObject::Connection m_interpolatorConnection;
     QSharedPointer<spine::SwirlVertexEffect> m_swrilEffect;
+    // cosine and sine of the angle for SwirlSamples + 1 steps of (radius - distance) / radius.
+    QVector<float> m_rotations;
+    bool m_rotationsDirty = true;
+
+    void buildRotations();
 };
 
 #endif // SPINEVERTEXEFFECT_H
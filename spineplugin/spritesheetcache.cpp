@@ -0,0 +1,291 @@
+#include "spritesheetcache.h"
+
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QStringList>
+#include <QtMath>
+#include <QDebug>
+#include <cmath>
+#include <float.h>
+#include <algorithm>
+#include <string.h>
+#include <spine/spine.h>
+
+#include "spineitem.h"
+#include "softwarerenderer.h"
+
+namespace {
+const int FramePadding = 1; // transparent texels between frames, keeps bilinear sampling from bleeding.
+const int MaxSheetSize = 4096;
+
+QRectF batchBounds(const std::vector<RenderCmdBatch>& batches)
+{
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (const auto& batch: batches) {
+        for (size_t i = 0; i < batch.vertices.size(); i++) {
+            minX = qMin(minX, batch.vertices[i].x);
+            minY = qMin(minY, batch.vertices[i].y);
+            maxX = qMax(maxX, batch.vertices[i].x);
+            maxY = qMax(maxY, batch.vertices[i].y);
+        }
+    }
+    if (minX > maxX || minY > maxY)
+        return QRectF();
+    return QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+// Shelf packing of the frames at scale, tallest frames first. Returns an empty size if the sheet gets too large.
+QSize packFrames(const QVector<QRectF>& bounds, float scale, QVector<QSize>& sizes, QVector<QPoint>& positions)
+{
+    int area = 0, maxWidth = 0;
+    for (int i = 0; i < bounds.size(); i++) {
+        sizes[i] = QSize(qMax(1, qCeil(bounds[i].width() * scale)), qMax(1, qCeil(bounds[i].height() * scale)));
+        area += (sizes[i].width() + FramePadding) * (sizes[i].height() + FramePadding);
+        maxWidth = qMax(maxWidth, sizes[i].width());
+    }
+    int sheetWidth = qMax(maxWidth + 2 * FramePadding, int(qNextPowerOfTwo(quint32(qCeil(qSqrt(area))))));
+    if (sheetWidth > MaxSheetSize)
+        return QSize();
+
+    QVector<int> order(bounds.size());
+    for (int i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return sizes[a].height() > sizes[b].height(); });
+    int x = FramePadding, y = FramePadding, shelfHeight = 0;
+    for (int i: order) {
+        if (x + sizes[i].width() + FramePadding > sheetWidth) {
+            x = FramePadding;
+            y += shelfHeight + FramePadding;
+            shelfHeight = 0;
+        }
+        positions[i] = QPoint(x, y);
+        x += sizes[i].width() + FramePadding;
+        shelfHeight = qMax(shelfHeight, sizes[i].height());
+    }
+    int sheetHeight = y + shelfHeight + FramePadding;
+    if (sheetHeight > MaxSheetSize)
+        return QSize();
+    return QSize(sheetWidth, sheetHeight);
+}
+}
+
+QString SpriteSheetKey::toString() const
+{
+    return QStringList({atlasFile, skeletonFile, skin, animation, QString::number(fps),
+                        QString::number(frameSize.width()), QString::number(frameSize.height()),
+                        QString::number(double(scaleX)), QString::number(double(scaleY))}).join('|');
+}
+
+SpriteSheet::SpriteSheet()
+{
+}
+
+SpriteSheet::~SpriteSheet()
+{
+}
+
+bool SpriteSheet::ensureBaked(const SpriteSheetKey &key, spine::SkeletonData *skeletonData)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_baked) {
+        m_valid = bake(key, skeletonData);
+        m_baked = true;
+    }
+    return m_valid;
+}
+
+bool SpriteSheet::bake(const SpriteSheetKey &key, spine::SkeletonData *skeletonData)
+{
+    if (!skeletonData || key.frameSize.isEmpty())
+        return false;
+    auto animation = skeletonData->findAnimation(spine::String(key.animation.toStdString().data()));
+    if (!animation) {
+        qWarning() << "no " << key.animation << " found to bake";
+        return false;
+    }
+
+    m_fps = qMax(1, key.fps);
+    m_duration = animation->getDuration();
+    const int frameCount = qMax(1, qCeil(m_duration * m_fps));
+
+    spine::Skeleton skeleton(skeletonData);
+    if (!key.skin.isEmpty())
+        skeleton.setSkin(spine::String(key.skin.toStdString().data()));
+    skeleton.setScaleX(key.scaleX);
+    skeleton.setScaleY(key.scaleY);
+    spine::SkeletonClipping clipper;
+
+    std::vector<std::vector<RenderCmdBatch>> frameBatches(static_cast<size_t>(frameCount));
+    QVector<QRectF> bounds(frameCount);
+    QRectF unionBounds;
+    for (int i = 0; i < frameCount; i++) {
+        skeleton.setToSetupPose();
+        animation->apply(skeleton, 0, float(i) / m_fps, true, nullptr, 1, spine::MixBlend_Setup, spine::MixDirection_In);
+        skeleton.updateWorldTransform();
+        SpineItem::buildRenderBatches(skeleton, clipper, frameBatches[size_t(i)]);
+        bounds[i] = batchBounds(frameBatches[size_t(i)]);
+        unionBounds |= bounds[i];
+    }
+    if (unionBounds.isEmpty()) {
+        qWarning() << "nothing to bake for " << key.animation;
+        return false;
+    }
+
+    // a single pixels per unit scale for all frames, the largest pose fits key.frameSize.
+    float scale = float(qMin(key.frameSize.width() / unionBounds.width(), key.frameSize.height() / unionBounds.height()));
+
+    QVector<QSize> sizes(frameCount);
+    QVector<QPoint> positions(frameCount);
+    QSize sheetSize;
+    for (int attempt = 0; ; attempt++) {
+        sheetSize = packFrames(bounds, scale, sizes, positions);
+        if (!sheetSize.isEmpty())
+            break;
+        if (attempt == 7) {
+            qWarning() << "sprite sheet of " << key.animation << " exceeds " << MaxSheetSize << " pixels";
+            return false;
+        }
+        scale *= 0.5f;
+    }
+
+    // blendColor, channel and light stay live uniforms of the item, bake the untinted frames.
+    SoftwareRenderer renderer;
+    m_image = QImage(sheetSize, QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+    m_frames.resize(frameCount);
+    QImage frameImage;
+    for (int i = 0; i < frameCount; i++) {
+        const QSize& size = sizes[i];
+        const QPoint& position = positions[i];
+        auto& frame = m_frames[i];
+        frame.bounds = QRectF(bounds[i].left(), bounds[i].top(), size.width() / scale, size.height() / scale);
+        frame.uv = QRectF(qreal(position.x()) / sheetSize.width(), qreal(position.y()) / sheetSize.height(),
+                          qreal(size.width()) / sheetSize.width(), qreal(size.height()) / sheetSize.height());
+        if (bounds[i].isEmpty())
+            continue;
+        renderer.render(frameBatches[size_t(i)], frame.bounds, size, frameImage);
+        for (int row = 0; row < size.height(); row++)
+            memcpy(m_image.scanLine(position.y() + row) + position.x() * 4, frameImage.constScanLine(row), size_t(size.width()) * 4);
+    }
+    return true;
+}
+
+bool SpriteSheet::isValid() const
+{
+    return m_valid;
+}
+
+int SpriteSheet::fps() const
+{
+    return m_fps;
+}
+
+float SpriteSheet::duration() const
+{
+    return m_duration;
+}
+
+int SpriteSheet::frameCount() const
+{
+    return m_frames.size();
+}
+
+const SpriteSheet::Frame &SpriteSheet::frame(int index) const
+{
+    return m_frames[index];
+}
+
+int SpriteSheet::frameAt(float time, bool loop) const
+{
+    if (m_frames.isEmpty())
+        return -1;
+    int index = int(std::floor(time * m_fps));
+    if (!loop)
+        return qBound(0, index, m_frames.size() - 1);
+    index %= m_frames.size();
+    return index < 0 ? index + m_frames.size() : index;
+}
+
+QImage SpriteSheet::image() const
+{
+    return m_image;
+}
+
+SpriteSheetCache *SpriteSheetCache::instance()
+{
+    static SpriteSheetCache _instance;
+    return &_instance;
+}
+
+QSharedPointer<SpriteSheet> SpriteSheetCache::sheet(const SpriteSheetKey &key, spine::SkeletonData *skeletonData)
+{
+    QSharedPointer<SpriteSheet> sheet;
+    {
+        QMutexLocker locker(&m_mutex);
+        const QString id = key.toString();
+        sheet = m_sheets.value(id).toStrongRef();
+        if (!sheet) {
+            // drop the entries of released sheets while at it, the store never grows past the sheets in use.
+            for (auto it = m_sheets.begin(); it != m_sheets.end();) {
+                if (it.value().isNull())
+                    it = m_sheets.erase(it);
+                else
+                    ++it;
+            }
+            sheet.reset(new SpriteSheet);
+            m_sheets.insert(id, sheet);
+        }
+    }
+    // bake outside of the cache lock, other keys stay available meanwhile.
+    if (!sheet->ensureBaked(key, skeletonData))
+        return QSharedPointer<SpriteSheet>();
+    return sheet;
+}
+
+QSGTexture *SpriteSheetCache::texture(const QSharedPointer<SpriteSheet> &sheet, QQuickWindow *window)
+{
+    if (!sheet || !window || sheet->image().isNull())
+        return nullptr;
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_textures.contains(window)) {
+        QObject::connect(window, &QQuickWindow::sceneGraphInvalidated, window, [this, window]() {
+            QMutexLocker locker(&m_mutex);
+            releaseTextures(window, true);
+            m_textures.remove(window);
+        }, Qt::DirectConnection);
+    }
+    releaseTextures(window, false);
+
+    SheetTextures& textures = m_textures[window];
+    auto it = textures.constFind(sheet.data());
+    if (it != textures.constEnd())
+        return it.value().texture;
+
+    SheetTexture entry;
+    entry.sheet = sheet;
+    entry.texture = window->createTextureFromImage(sheet->image());
+    entry.texture->setFiltering(QSGTexture::Linear);
+    textures.insert(sheet.data(), entry);
+    return entry.texture;
+}
+
+void SpriteSheetCache::releaseTextures(QQuickWindow *window, bool all)
+{
+    SheetTextures& textures = m_textures[window];
+    for (auto it = textures.begin(); it != textures.end();) {
+        // released sheets go before any lookup, a new sheet reusing the address never finds their texture.
+        if (all || it.value().sheet.isNull()) {
+            delete it.value().texture;
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SpriteSheetCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_sheets.clear();
+}
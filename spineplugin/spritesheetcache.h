@@ -0,0 +1,124 @@
+#ifndef SPRITESHEETCACHE_H
+#define SPRITESHEETCACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QWeakPointer>
+
+class QSGTexture;
+class QQuickWindow;
+
+namespace spine {
+class SkeletonData;
+}
+
+/**
+ * @brief Everything a baked animation depends on, instances with equal keys share one sheet.
+ */
+struct SpriteSheetKey {
+    QString atlasFile;
+    QString skeletonFile;
+    QString skin;
+    QString animation;
+    int fps = 30;
+    QSize frameSize;
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+
+    QString toString() const;
+};
+
+/**
+ * @brief One animation pre-rendered at a fixed fps into a packed atlas of frames.
+ *
+ * Frames are rasterized with SoftwareRenderer, so baking needs no GL context and runs on the
+ * item worker thread. Every frame keeps its own skeleton space bounds, a baked frame is drawn
+ * as a single quad covering exactly the rect the live path would have drawn into. The sheet
+ * only holds the image, its GL textures are owned per window by SpriteSheetCache::texture.
+ */
+class SpriteSheet
+{
+public:
+    struct Frame {
+        QRectF bounds; // skeleton space rect the frame image covers.
+        QRectF uv;     // normalized rect of the frame in the sheet image.
+    };
+
+    SpriteSheet();
+    ~SpriteSheet();
+
+    /**
+     * @brief ensureBaked Bakes the sheet once, concurrent callers wait for the first one.
+     * @return false if the animation could not be baked.
+     */
+    bool ensureBaked(const SpriteSheetKey& key, spine::SkeletonData* skeletonData);
+
+    bool isValid() const;
+    int fps() const;
+    float duration() const;
+    int frameCount() const;
+    const Frame& frame(int index) const;
+    /**
+     * @brief frameAt Index of the frame shown at animation time, wrapping for looping tracks.
+     */
+    int frameAt(float time, bool loop = true) const;
+    QImage image() const;
+
+private:
+    bool bake(const SpriteSheetKey& key, spine::SkeletonData* skeletonData);
+
+private:
+    QMutex m_mutex;
+    bool m_baked = false;
+    bool m_valid = false;
+    int m_fps = 30;
+    float m_duration = 0;
+    QVector<Frame> m_frames;
+    QImage m_image;
+};
+
+/**
+ * @brief Process wide sprite sheet store, like AimyTextureLoader for atlas pages.
+ *
+ * The store only keeps weak references, a sheet lives as long as an item playing it holds it.
+ */
+class SpriteSheetCache
+{
+public:
+    static SpriteSheetCache* instance();
+
+    /**
+     * @brief sheet Returns the baked sheet for key, baking it from skeletonData if no item holds it.
+     */
+    QSharedPointer<SpriteSheet> sheet(const SpriteSheetKey& key, spine::SkeletonData* skeletonData);
+    /**
+     * @brief texture GL texture of sheet for window, uploaded on first use. Call on the render thread.
+     *
+     * Textures of sheets no item holds anymore are released with the next call for the window, the
+     * rest when the scene graph of the window is invalidated, while its GL context is still current.
+     */
+    QSGTexture* texture(const QSharedPointer<SpriteSheet>& sheet, QQuickWindow* window);
+    void clear();
+
+private:
+    struct SheetTexture {
+        QWeakPointer<SpriteSheet> sheet;
+        QSGTexture* texture = nullptr;
+    };
+    typedef QHash<const SpriteSheet*, SheetTexture> SheetTextures;
+
+    void releaseTextures(QQuickWindow* window, bool all);
+
+private:
+    QMutex m_mutex;
+    QHash<QString, QWeakPointer<SpriteSheet>> m_sheets;
+    QHash<QQuickWindow*, SheetTextures> m_textures;
+};
+
+#endif // SPRITESHEETCACHE_H
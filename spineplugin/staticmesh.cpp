@@ -0,0 +1,97 @@
+#include "staticmesh.h"
+
+#include <spine/spine.h>
+
+namespace {
+const GLushort QuadIndices[] = {0, 1, 2, 2, 3, 0};
+}
+
+StaticMesh::~StaticMesh()
+{
+}
+
+QSharedPointer<StaticMesh> StaticMesh::create(spine::Attachment &attachment)
+{
+    const float* uvs = nullptr;
+    const GLushort* indices = nullptr;
+    int vertexCount = 0, indexCount = 0;
+    if (attachment.getRTTI().isExactly(spine::RegionAttachment::rtti)) {
+        auto& region = static_cast<spine::RegionAttachment&>(attachment);
+        uvs = region.getUVs().buffer();
+        vertexCount = 4;
+        indices = QuadIndices;
+        indexCount = 6;
+    } else if (attachment.getRTTI().isExactly(spine::MeshAttachment::rtti)) {
+        auto& mesh = static_cast<spine::MeshAttachment&>(attachment);
+        uvs = mesh.getUVs().buffer();
+        vertexCount = int(mesh.getWorldVerticesLength() / 2);
+        indices = mesh.getTriangles().buffer();
+        indexCount = int(mesh.getTriangles().size());
+    } else {
+        return QSharedPointer<StaticMesh>();
+    }
+
+    QSharedPointer<StaticMesh> staticMesh(new StaticMesh);
+    staticMesh->m_vertexCount = vertexCount;
+    staticMesh->m_vertexData.resize(vertexCount * 2);
+    memcpy(staticMesh->m_vertexData.data(), uvs, size_t(vertexCount) * 2 * sizeof(float));
+    staticMesh->m_indices.resize(indexCount);
+    memcpy(staticMesh->m_indices.data(), indices, size_t(indexCount) * sizeof(GLushort));
+    return staticMesh;
+}
+
+int StaticMesh::vertexCount() const
+{
+    return m_vertexCount;
+}
+
+const QVector<float> &StaticMesh::vertexData() const
+{
+    return m_vertexData;
+}
+
+const QVector<GLushort> &StaticMesh::indices() const
+{
+    return m_indices;
+}
+
+void StaticMesh::expand(const spine::Vector<float> &positions, const spine::Color &color,
+                        spine::Vector<SpineVertex> &vertices, spine::Vector<GLushort> &triangles) const
+{
+    vertices.setSize(size_t(m_vertexCount), SpineVertex());
+    for (int i = 0; i < m_vertexCount; i++) {
+        auto& vertex = vertices[size_t(i)];
+        vertex.x = positions[size_t(i) * 2];
+        vertex.y = positions[size_t(i) * 2 + 1];
+        vertex.u = m_vertexData[i * 2];
+        vertex.v = m_vertexData[i * 2 + 1];
+        vertex.color.set(color);
+    }
+    triangles.setSize(size_t(m_indices.size()), 0);
+    memcpy(triangles.buffer(), m_indices.constData(), size_t(m_indices.size()) * sizeof (GLushort));
+}
+
+void StaticMeshCache::build(spine::Skeleton &skeleton)
+{
+    spine::Skin* skins[] = {skeleton.getData()->getDefaultSkin(), skeleton.getSkin()};
+    for (auto skin: skins) {
+        if (!skin)
+            continue;
+        auto entries = skin->getAttachments();
+        while (entries.hasNext())
+            mesh(*entries.next()._attachment);
+    }
+}
+
+QSharedPointer<StaticMesh> StaticMeshCache::mesh(spine::Attachment &attachment)
+{
+    auto it = m_meshes.find(&attachment);
+    if (it == m_meshes.end())
+        it = m_meshes.insert(&attachment, StaticMesh::create(attachment));
+    return it.value();
+}
+
+void StaticMeshCache::clear()
+{
+    m_meshes.clear();
+}
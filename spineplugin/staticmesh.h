@@ -0,0 +1,71 @@
+#ifndef STATICMESH_H
+#define STATICMESH_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "rendercmdscache.h"
+
+namespace spine {
+class Attachment;
+class Skeleton;
+}
+
+/**
+ * @brief Per vertex data of an attachment that never changes between frames.
+ *
+ * For region and mesh attachments these are the uvs and the triangle indices. RenderCmdsCache
+ * uploads them once into static buffers, so a frame only streams the world positions and a
+ * single tint instead of rewriting full SpineVertex arrays.
+ */
+class StaticMesh
+{
+public:
+    virtual ~StaticMesh();
+
+    /**
+     * @brief create Returns null for attachments other than regions and meshes.
+     */
+    static QSharedPointer<StaticMesh> create(spine::Attachment& attachment);
+
+    int vertexCount() const;
+    /**
+     * @brief vertexData Contents of the static vertex buffer, u and v per vertex.
+     */
+    const QVector<float>& vertexData() const;
+    const QVector<GLushort>& indices() const;
+
+    /**
+     * @brief expand Interleaves world positions (x, y per vertex) with the static data into plain vertices.
+     */
+    void expand(const spine::Vector<float>& positions, const spine::Color& color,
+                spine::Vector<SpineVertex>& vertices, spine::Vector<GLushort>& triangles) const;
+
+protected:
+    int m_vertexCount = 0;
+    QVector<float> m_vertexData;
+    QVector<GLushort> m_indices;
+};
+
+/**
+ * @brief Per item StaticMesh store keyed by attachment.
+ */
+class StaticMeshCache
+{
+public:
+    /**
+     * @brief build Creates the data of every attachment of the skeleton skin and the default skin up front.
+     */
+    void build(spine::Skeleton& skeleton);
+    /**
+     * @brief mesh Static data of attachment, created on first use for attachments outside the built skins.
+     */
+    QSharedPointer<StaticMesh> mesh(spine::Attachment& attachment);
+    void clear();
+
+private:
+    QHash<const spine::Attachment*, QSharedPointer<StaticMesh>> m_meshes;
+};
+
+#endif // STATICMESH_H
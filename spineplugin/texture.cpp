@@ -32,6 +32,7 @@
 #include <QImage>
 #include <QFileInfo>
 #include <QDebug>
+#include <spine/ArenaExtension.h>
 #include <spine/Extension.h>
 
 AimyTextureLoader::AimyTextureLoader()
@@ -111,8 +112,28 @@ QSGTexture *AimyTextureLoader::getGLTexture(Texture *texture, QQuickWindow *wind
     return nullptr;
 }
 
+QImage AimyTextureLoader::getImage(Texture *texture)
+{
+    if (!texture || texture->name.isEmpty())
+        return QImage();
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_imageHash.constFind(texture->name);
+    if (it != m_imageHash.constEnd())
+        return it.value();
+
+    QImage img(texture->name);
+    if (img.isNull())
+        qWarning() << "no img source found : " << texture->name;
+    else
+        img = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    m_imageHash.insert(texture->name, img);
+    return img;
+}
+
 void AimyTextureLoader::releaseTextures()
 {
+    m_imageHash.clear();
     if (m_glTextureHash.isEmpty())
         return;
 
@@ -161,13 +182,15 @@ char *AimyExtension::_readFile(const spine::String &path, int *length)
     f.close();
     *length = bytes.size();
 
-    char* datas = (char*)malloc(bytes.size());
+    // released with SpineExtension::free, which expects the header ArenaExtension puts in front of its allocations.
+    char* datas = spine::SpineExtension::alloc<char>(size_t(bytes.size()), __FILE__, __LINE__);
     memcpy(datas, bytes.data(), *length);
 
     return datas;
 }
 
 spine::SpineExtension* spine::getDefaultExtension() {
-    return new AimyExtension();
+    // Loads scope their allocations to an arena per skeleton, see SpineItemWorker::loadResource.
+    return new spine::ArenaExtension(new AimyExtension());
 }
 
@@ -32,6 +32,7 @@
 #define TEXTURE_H
 
 #include <QtGlobal>
+#include <QImage>
 #include <QSize>
 #include <QString>
 #include <QSGTexture>
@@ -42,8 +43,6 @@
 
 static bool gTextureFreezed = false;
 
-class QImage;
-
 struct Texture
 {
 public:
@@ -59,6 +58,10 @@ public:
     virtual void load(spine::AtlasPage &page, const spine::String &path) override;
     virtual void unload(void *texture) override;
     QSGTexture* getGLTexture(Texture*texture, QQuickWindow*window);
+    /**
+     * @brief getImage Premultiplied ARGB32 pixels of texture for the software renderer, loaded on first use.
+     */
+    QImage getImage(Texture* texture);
     void releaseTextures();
 
     QQuickWindow *getWindow() const;
@@ -67,6 +70,7 @@ public:
 private:
     QHash<QString, QSharedPointer<Texture>> m_textureHash;
     QHash<QString, QSGTexture*> m_glTextureHash;
+    QHash<QString, QImage> m_imageHash;
     QMutex m_mutex;
     QQuickWindow* m_window = nullptr;
 };